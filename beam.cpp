@@ -0,0 +1,81 @@
+/*********************************************************************
+ * File: beam.cpp
+ * Description: Contains the implementaiton of the beam functions.
+ *********************************************************************/
+#include "beam.h"
+#include "trig.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//Nearer first, and the lower id first when two are just as near (the beam
+//starts inside both), so the answer does not depend on the walk order
+static bool isBefore(const BeamHit & hit, const BeamHit & other)
+{
+	return hit.along < other.along || (hit.along == other.along && hit.id < other.id);
+}
+
+float traceBeam(const SpatialGrid & grid, const Point & start, float angle, float length,
+                int pierce, std::vector<BeamHit> & hits)
+{
+	hits.clear();
+	if (pierce <= 0)
+		return 0.0f;
+
+	float startX = start.getX();
+	float startY = start.getY();
+	float dirX = cosDeg(angle);
+	float dirY = sinDeg(angle);
+
+	// a rock found while the walk is at some point on the ray can be this
+	// much nearer the start than that point
+	float cellSize = grid.getUsedCellSize();
+	float reach = std::ceil(grid.getMaxRadius() / cellSize) + 1.0f;
+	float slack = reach * cellSize * 1.5f + grid.getMaxRadius();
+
+	grid.trace(startX, startY, dirX, dirY, length, [&](const GridEntry & entry, float along)
+	{
+		// nothing left to find can beat the ones we have
+		if ((int)hits.size() == pierce && along - slack > hits.back().along)
+			return false;
+
+		// exact ray against circle
+		float toX = entry.x - startX;
+		float toY = entry.y - startY;
+		float middle = toX * dirX + toY * dirY;
+		float offSquared = toX * toX + toY * toY - middle * middle;
+		float radiusSquared = entry.radius * entry.radius;
+		if (offSquared > radiusSquared)
+			return true;
+		float halfChord = std::sqrt(radiusSquared - offSquared);
+		if (middle + halfChord < 0.0f || middle - halfChord > length)
+			return true;
+
+		BeamHit hit = { entry.id, std::max(0.0f, middle - halfChord) };
+		if ((int)hits.size() == pierce && !isBefore(hit, hits.back()))
+			return true;
+
+		// keep hits sorted by how far along they are
+		int place = (int)hits.size();
+		hits.push_back(hit);
+		while (place > 0 && isBefore(hit, hits[place - 1]))
+		{
+			hits[place] = hits[place - 1];
+			place--;
+		}
+		hits[place] = hit;
+		if ((int)hits.size() > pierce)
+			hits.pop_back();
+		return true;
+	});
+
+	return ((int)hits.size() == pierce) ? hits.back().along : length;
+}
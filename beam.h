@@ -0,0 +1,41 @@
+/***********************************************************************
+ * Header File:
+ *    Beam : a beam weapon that goes straight through rocks
+ * Summary:
+ *    The beam is a ray out of the ship's nose. It is worked out by
+ *    walking the spatial grid cell by cell along the ray, so only the
+ *    rocks in the cells it crosses get the exact test, however many
+ *    rocks there are.
+ ************************************************************************/
+#ifndef BEAM_H
+#define BEAM_H
+
+#include "point.h"
+#include "spatialGrid.h"
+
+#include <vector>
+
+//How far the beam reaches
+constexpr float BEAM_LENGTH = 600.0;
+
+//How many rocks the beam goes through before it is stopped
+constexpr int BEAM_PIERCE = 3;
+
+//A rock the beam touched, and how far along the beam it was touched
+struct BeamHit
+{
+	int id;       // the id the rock was put in the grid with
+	float along;
+};
+
+/******************************************
+ * TRACE BEAM
+ * Find the first pierce rocks in grid touched by a beam from start going
+ * at angle (degrees, same as the ship) for length, nearest first, and put
+ * them in hits. Returns how far the beam gets: to the last of them if
+ * there were pierce of them, otherwise its whole length.
+ ******************************************/
+float traceBeam(const SpatialGrid & grid, const Point & start, float angle, float length,
+                int pierce, std::vector<BeamHit> & hits);
+
+#endif // BEAM_H
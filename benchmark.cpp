@@ -0,0 +1,1244 @@
+/*********************************************************************
+ * File: benchmark.cpp
+ * Description: Contains the implementaiton of the benchmark
+ *  functions.
+ *********************************************************************/
+#include "benchmark.h"
+#include "rocks.h"
+#include "physics.h"
+#include "spatialGrid.h"
+#include "gravity.h"
+#include "parallel.h"
+#include "particles.h"
+#include "beam.h"
+#include "missile.h"
+#include "shockwave.h"
+#include "flock.h"
+#include "threat.h"
+#include "kinetic.h"
+#include "drawBuffer.h"
+#include "trig.h"
+#include "bullet.h"
+#include "world.h"
+#include "ship.h"
+#include "uiInteract.h"
+#include "raster.h"
+#include "framePacer.h"
+#include "frameCapture.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+//How many ticks each row of a table is averaged over
+constexpr int BENCHMARK_TICKS = 60;
+
+//Rocks are spread out so there is always the same number per screen
+constexpr float BENCHMARK_AREA_PER_ROCK = 40.0 * 40.0;
+
+//Past this many rocks checking every pair takes too long to wait for
+constexpr int BENCHMARK_MAX_ALL_PAIRS = 5000;
+
+//How many beams each row of the beam table is averaged over
+constexpr int BENCHMARK_BEAMS = 1000;
+
+//How many missiles are looking for a rock in the missile table
+constexpr int BENCHMARK_MISSILES = 500;
+
+//Saucers are packed closer than rocks, so each one has a few flock mates
+constexpr float BENCHMARK_AREA_PER_SAUCER = 25.0 * 25.0;
+
+//Gravity is slower per tick so it is averaged over fewer ticks
+constexpr int BENCHMARK_GRAVITY_TICKS = 10;
+
+//How many rocks are broken up each tick while the threats are tracked
+constexpr int BENCHMARK_THREAT_KILLS = 10;
+
+//How often the ship changes course while the threats are tracked, and
+//how much it speeds up every tick in between (it is always thrusting)
+constexpr int BENCHMARK_THREAT_TURN = 45;
+constexpr float BENCHMARK_THREAT_THRUST = 0.05;
+
+//How many rocks and shots the kinetic collisions are timed with
+constexpr int BENCHMARK_KINETIC_ROCKS = 20000;
+constexpr int BENCHMARK_KINETIC_SHOTS = 2000;
+
+//How many angles the trig table is checked and timed with
+constexpr int BENCHMARK_TRIG_ANGLES = 1000000;
+
+//How many shots are turned each tick, which makes them look again
+constexpr int BENCHMARK_KINETIC_TURNS = 20;
+
+//How many pixels wide and high the software raster draws
+constexpr int BENCHMARK_RASTER_SIZE = 800;
+
+//How many frames the pacers are run for, and how long the work each
+//frame pretends to do can be at the most (a 60th of a second is 16.7 ms)
+constexpr int BENCHMARK_PACER_FRAMES = 180;
+constexpr double BENCHMARK_PACER_WORK = 0.012;
+
+//How many frames are recorded, and where to (it is deleted after)
+constexpr int BENCHMARK_CAPTURE_FRAMES = 120;
+constexpr const char * BENCHMARK_CAPTURE_FILE = "benchCapture.y4m";
+
+/******************************************
+ * MAKE FIELD
+ * A square of random rocks of every size, centered on (0, 0). They
+ * wrap around it.
+ ******************************************/
+static std::vector<Rocks *> makeField(int count, float halfSize)
+{
+	Rocks::setWorld(Point(-halfSize, halfSize), Point(halfSize, -halfSize));
+	std::vector<Rocks *> rocks;
+	for (int i = 0; i < count; i++)
+	{
+		Point point(random(-halfSize, halfSize), random(-halfSize, halfSize));
+		switch (i % 3)
+		{
+		case 0:
+			rocks.push_back(new BigRock(point));
+			break;
+		case 1:
+			rocks.push_back(new MediumRock(point));
+			break;
+		case 2:
+			rocks.push_back(new SmallRock(point));
+			break;
+		}
+	}
+	return rocks;
+}
+
+/******************************************
+ * MOVE FIELD
+ * Same as the game: nothing is moved, the rocks are just a tick
+ * further along their lines (see Rocks::getCurrentPoint)
+ ******************************************/
+static void moveField()
+{
+	FlyingObject::nextTick();
+}
+
+static void deleteField(std::vector<Rocks *> & rocks)
+{
+	for (int i = 0; i < (int)rocks.size(); i++)
+		delete rocks[i];
+	rocks.clear();
+}
+
+/******************************************
+ * BENCHMARK BOUNCE
+ ******************************************/
+void benchmarkBounce(std::ostream & out)
+{
+	const int counts[] = { 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+	srand(1);
+
+	out << "Bouncing rocks: milliseconds per tick (move + bounce)\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "grid" << std::setw(14) << "all pairs" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		SpatialGrid grid;
+
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			moveField();
+			bounceRocks(rocks, grid);
+		}
+		std::chrono::duration<double, std::milli> gridTime =
+			std::chrono::high_resolution_clock::now() - start;
+		deleteField(rocks);
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << gridTime.count() / BENCHMARK_TICKS;
+
+		if (count <= BENCHMARK_MAX_ALL_PAIRS)
+		{
+			rocks = makeField(count, halfSize);
+			start = std::chrono::high_resolution_clock::now();
+			for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+			{
+				moveField();
+				for (int i = 0; i < (int)rocks.size(); i++)
+					for (int j = i + 1; j < (int)rocks.size(); j++)
+						bounceRockPair(*rocks[i], *rocks[j]);
+			}
+			std::chrono::duration<double, std::milli> allTime =
+				std::chrono::high_resolution_clock::now() - start;
+			deleteField(rocks);
+			out << std::setw(14) << allTime.count() / BENCHMARK_TICKS;
+		}
+		else
+			out << std::setw(14) << "-";
+		out << "\n";
+	}
+}
+
+/******************************************
+ * BENCHMARK GRAVITY
+ ******************************************/
+void benchmarkGravity(std::ostream & out, float theta)
+{
+	const int counts[] = { 1000, 5000, 10000, 50000, 100000, 200000 };
+	srand(1);
+
+	GravityField field(theta);
+	out << "Gravity: milliseconds per tick (build tree + pull on every body), theta "
+	    << theta << ", " << threadCount() << " threads\n";
+	out << std::setw(10) << "bodies" << std::setw(14) << "tree" << std::setw(14) << "exact"
+	    << std::setw(14) << "error %" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<GravitySource> sources;
+		std::vector<GravityTarget> targets;
+		for (int i = 0; i < count; i++)
+		{
+			GravitySource source = { (float)random(-halfSize, halfSize), (float)random(-halfSize, halfSize),
+			                         (float)random(1, 10) };
+			GravityTarget target = { source.x, source.y, i };
+			sources.push_back(source);
+			targets.push_back(target);
+		}
+
+		std::vector<Velocity> pulls;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < BENCHMARK_GRAVITY_TICKS; tick++)
+		{
+			field.build(sources);
+			field.pullAll(targets, pulls);
+		}
+		std::chrono::duration<double, std::milli> treeTime =
+			std::chrono::high_resolution_clock::now() - start;
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << treeTime.count() / BENCHMARK_GRAVITY_TICKS;
+
+		if (count <= BENCHMARK_MAX_ALL_PAIRS)
+		{
+			// theta of 0 opens every square, which is the same as every pair
+			GravityField exact(0.0f);
+			std::vector<Velocity> exactPulls;
+			start = std::chrono::high_resolution_clock::now();
+			exact.build(sources);
+			exact.pullAll(targets, exactPulls);
+			std::chrono::duration<double, std::milli> exactTime =
+				std::chrono::high_resolution_clock::now() - start;
+
+			double error = 0;
+			double total = 0;
+			for (int i = 0; i < count; i++)
+			{
+				double xDiff = pulls[i].getDx() - exactPulls[i].getDx();
+				double yDiff = pulls[i].getDy() - exactPulls[i].getDy();
+				error += (xDiff * xDiff) + (yDiff * yDiff);
+				total += (exactPulls[i].getDx() * exactPulls[i].getDx()) +
+				         (exactPulls[i].getDy() * exactPulls[i].getDy());
+			}
+			out << std::setw(14) << exactTime.count() << std::setw(14)
+			    << (total > 0 ? 100.0 * sqrt(error / total) : 0.0);
+		}
+		else
+			out << std::setw(14) << "-" << std::setw(14) << "-";
+		out << "\n";
+	}
+}
+
+void benchmarkParticles(std::ostream & out)
+{
+	const int counts[] = { 10000, 50000, 100000, PARTICLE_BUDGET };
+
+	out << "Particles: milliseconds per tick (advance + build draw lists)\n";
+	out << std::setw(10) << "particles" << std::setw(14) << "advance" << std::setw(14) << "draw lists"
+	    << std::setw(14) << "dropped" << "\n";
+	for (int count : counts)
+	{
+		Particles particles;
+		// live long enough that none of them expire while being timed
+		int life = 4 * BENCHMARK_TICKS;
+		for (int made = 0; made < count; made += 1000)
+			particles.burst(Point(0, 0), Velocity(), std::min(1000, count - made), 3.0f, life,
+			                (ParticleColor)(made / 1000 % PARTICLE_COLORS));
+
+		std::chrono::duration<double, std::milli> advanceTime(0);
+		std::chrono::duration<double, std::milli> drawTime(0);
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			particles.advance();
+			auto middle = std::chrono::high_resolution_clock::now();
+			particles.prepareDraw();
+			drawTime += std::chrono::high_resolution_clock::now() - middle;
+			advanceTime += middle - start;
+		}
+		out << std::setw(10) << particles.size() << std::fixed << std::setprecision(3)
+		    << std::setw(14) << advanceTime.count() / BENCHMARK_TICKS
+		    << std::setw(14) << drawTime.count() / BENCHMARK_TICKS
+		    << std::setw(14) << particles.getDropped() << "\n";
+	}
+}
+
+/******************************************
+ * BEAM BY EVERY ROCK
+ * The slow way to find what a beam hits, to check traceBeam() against
+ ******************************************/
+static std::vector<int> beamByEveryRock(const std::vector<Rocks *> & rocks, const Point & start,
+                                        float angle, float length, int pierce)
+{
+	float dirX = (float)cos(M_PI / 180.0 * angle);
+	float dirY = (float)sin(M_PI / 180.0 * angle);
+	std::vector<std::pair<float, int> > touched;
+	for (int i = 0; i < (int)rocks.size(); i++)
+	{
+		Point at = rocks[i]->getCurrentPoint();
+		float toX = at.getX() - start.getX();
+		float toY = at.getY() - start.getY();
+		float middle = toX * dirX + toY * dirY;
+		float offSquared = toX * toX + toY * toY - middle * middle;
+		float radiusSquared = (float)(rocks[i]->getRadius() * rocks[i]->getRadius());
+		if (offSquared > radiusSquared)
+			continue;
+		float halfChord = std::sqrt(radiusSquared - offSquared);
+		if (middle + halfChord < 0.0f || middle - halfChord > length)
+			continue;
+		touched.push_back(std::make_pair(std::max(0.0f, middle - halfChord), i));
+	}
+	std::sort(touched.begin(), touched.end());
+	std::vector<int> ids;
+	for (int i = 0; i < (int)touched.size() && i < pierce; i++)
+		ids.push_back(touched[i].second);
+	return ids;
+}
+
+void benchmarkBeam(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 100000 };
+	srand(1);
+
+	out << "Beam: microseconds per beam (" << BEAM_LENGTH << " long, through " << BEAM_PIERCE
+	    << " rocks), milliseconds to build the grid\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "grid" << std::setw(14) << "beam"
+	    << std::setw(14) << "every rock" << std::setw(14) << "different" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+
+		SpatialGrid grid;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < (int)rocks.size(); i++)
+			grid.insert(i, rocks[i]->getCurrentPoint(), (float)rocks[i]->getRadius());
+		grid.build();
+		std::chrono::duration<double, std::milli> gridTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		std::vector<Point> starts;
+		std::vector<float> angles;
+		for (int i = 0; i < BENCHMARK_BEAMS; i++)
+		{
+			starts.push_back(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)));
+			angles.push_back((float)random(0.0, 360.0));
+		}
+
+		std::vector<BeamHit> hits;
+		int touched = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < BENCHMARK_BEAMS; i++)
+		{
+			traceBeam(grid, starts[i], angles[i], BEAM_LENGTH, BEAM_PIERCE, hits);
+			touched += (int)hits.size();
+		}
+		std::chrono::duration<double, std::micro> beamTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		// the slow way, on fewer beams once there are a lot of rocks
+		int checked = std::min(BENCHMARK_BEAMS, 10000000 / count);
+		int different = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < checked; i++)
+		{
+			std::vector<int> expected = beamByEveryRock(rocks, starts[i], angles[i], BEAM_LENGTH, BEAM_PIERCE);
+			traceBeam(grid, starts[i], angles[i], BEAM_LENGTH, BEAM_PIERCE, hits);
+			bool same = (expected.size() == hits.size());
+			for (int hit = 0; same && hit < (int)hits.size(); hit++)
+				same = (expected[hit] == hits[hit].id);
+			if (!same)
+				different++;
+		}
+		std::chrono::duration<double, std::micro> everyTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << gridTime.count()
+		    << std::setw(14) << beamTime.count() / BENCHMARK_BEAMS
+		    << std::setw(14) << everyTime.count() / checked
+		    << std::setw(14) << different << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * NEAREST BY EVERY ROCK
+ * The slow way to find the rock nearest a missile, -1 if none in sight
+ ******************************************/
+static int nearestByEveryRock(const std::vector<Rocks *> & rocks, const Point & point, float sight)
+{
+	int best = -1;
+	float bestSquared = sight * sight;
+	for (int i = 0; i < (int)rocks.size(); i++)
+	{
+		Point at = rocks[i]->getCurrentPoint();
+		float dx = at.getX() - point.getX();
+		float dy = at.getY() - point.getY();
+		float squared = dx * dx + dy * dy;
+		if (squared < bestSquared || (squared == bestSquared && best == -1))
+		{
+			best = i;
+			bestSquared = squared;
+		}
+	}
+	return best;
+}
+
+void benchmarkMissiles(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 50000, 100000 };
+	srand(1);
+
+	out << "Missiles: milliseconds per tick for " << BENCHMARK_MISSILES
+	    << " missiles to each find the nearest rock (grid includes building it)\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "grid" << std::setw(14) << "every rock"
+	    << std::setw(14) << "different" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+
+		std::vector<Point> missiles;
+		for (int i = 0; i < BENCHMARK_MISSILES; i++)
+			missiles.push_back(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)));
+
+		SpatialGrid grid;
+		std::vector<GridEntry> found;
+		std::vector<int> gridNearest(BENCHMARK_MISSILES, -1);
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			grid.clear();
+			for (int i = 0; i < (int)rocks.size(); i++)
+				grid.insert(i, rocks[i]->getCurrentPoint(), (float)rocks[i]->getRadius());
+			grid.build();
+			for (int i = 0; i < BENCHMARK_MISSILES; i++)
+			{
+				grid.nearest(missiles[i].getX(), missiles[i].getY(), 1, MISSILE_SIGHT,
+				             [](const GridEntry &) { return true; }, found);
+				gridNearest[i] = found.empty() ? -1 : found[0].id;
+			}
+		}
+		std::chrono::duration<double, std::milli> gridTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		// the slow way, over fewer ticks once there are a lot of rocks
+		int ticks = std::max(1, std::min(BENCHMARK_TICKS, 1000000 / count));
+		int different = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < ticks; tick++)
+		{
+			different = 0;
+			for (int i = 0; i < BENCHMARK_MISSILES; i++)
+			{
+				int expected = nearestByEveryRock(rocks, missiles[i], MISSILE_SIGHT);
+				if (expected != gridNearest[i])
+					different++;
+			}
+		}
+		std::chrono::duration<double, std::milli> everyTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << gridTime.count() / BENCHMARK_TICKS
+		    << std::setw(14) << everyTime.count() / ticks
+		    << std::setw(14) << different << "\n";
+		deleteField(rocks);
+	}
+}
+
+void benchmarkShockWave(std::ostream & out)
+{
+	const int counts[] = { 10000, 100000, 500000 };
+	srand(1);
+
+	out << "Shock wave: milliseconds to break up every rock in one tick, and per tick\n"
+	    << "as the wave goes over them (grid, wave and splitting the rocks it hits)\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "one tick" << std::setw(10) << "ticks"
+	    << std::setw(14) << "average" << std::setw(14) << "worst" << std::setw(10) << "left" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+
+		// the old way, every rock is scored and thrown away at once
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		int score = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < (int)rocks.size(); i++)
+		{
+			score += rocks[i]->hit();
+			delete rocks[i];
+		}
+		rocks.clear();
+		std::chrono::duration<double, std::milli> allTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		rocks = makeField(count, halfSize);
+		SpatialGrid grid;
+		ShockWave wave;
+		std::vector<int> hits;
+		wave.start(Point(0, 0), halfSize * (float)M_SQRT2);
+		int ticks = 0;
+		std::chrono::duration<double, std::milli> waveTime(0);
+		std::chrono::duration<double, std::milli> worstTime(0);
+		while (wave.isOn())
+		{
+			start = std::chrono::high_resolution_clock::now();
+			grid.clear();
+			for (int i = 0; i < (int)rocks.size(); i++)
+				grid.insert(i, rocks[i]->getCurrentPoint(), (float)rocks[i]->getRadius());
+			grid.build();
+			wave.advance(grid, hits);
+			for (int i = 0; i < (int)hits.size(); i++)
+			{
+				score += rocks[hits[i]]->getValue();
+				std::vector<Rocks *> pieces = rocks[hits[i]]->killRocks();
+				rocks.insert(rocks.end(), pieces.begin(), pieces.end());
+			}
+			// throw the dead ones away, the same as the game does every tick
+			int kept = 0;
+			for (int i = 0; i < (int)rocks.size(); i++)
+			{
+				if (rocks[i]->isAlive())
+					rocks[kept++] = rocks[i];
+				else
+					delete rocks[i];
+			}
+			rocks.resize(kept);
+			std::chrono::duration<double, std::milli> tickTime =
+				std::chrono::high_resolution_clock::now() - start;
+			waveTime += tickTime;
+			worstTime = std::max(worstTime, tickTime);
+			ticks++;
+		}
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << allTime.count() << std::setw(10) << ticks
+		    << std::setw(14) << waveTime.count() / std::max(1, ticks)
+		    << std::setw(14) << worstTime.count() << std::setw(10) << rocks.size() << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * STEER SAUCERS
+ * Run the flock for BENCHMARK_TICKS ticks and say how long it took a tick
+ ******************************************/
+static double steerSaucers(std::vector<Saucer> saucers, const SpatialGrid & rocks, bool parallel)
+{
+	Flock flock;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+	{
+		flock.steer(saucers, rocks, Point(0, 0), true, parallel);
+		for (int i = 0; i < (int)saucers.size(); i++)
+			saucers[i].advance();
+	}
+	std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+	return time.count() / BENCHMARK_TICKS;
+}
+
+void benchmarkSaucers(std::ostream & out)
+{
+	const int counts[] = { 1000, 5000, 20000, 50000 };
+	srand(1);
+
+	out << "Saucers: milliseconds per tick to steer and move the flock (on 1 and " << threadCount()
+	    << " threads),\nand to find every saucer's flock mates (how many on average) by checking every pair\n";
+	out << std::setw(10) << "saucers" << std::setw(14) << "one thread" << std::setw(14) << "all threads"
+	    << std::setw(14) << "every pair" << std::setw(10) << "mates" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_SAUCER) / 2.0f;
+		std::vector<Saucer> saucers;
+		for (int i = 0; i < count; i++)
+			saucers.push_back(Saucer(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)),
+			                         Velocity(random(-1.0, 1.0), random(-1.0, 1.0))));
+
+		// a rock for every ten saucers to keep away from
+		std::vector<Rocks *> rocks = makeField(count / 10, halfSize);
+		SpatialGrid rockGrid;
+		for (int i = 0; i < (int)rocks.size(); i++)
+			rockGrid.insert(i, rocks[i]->getCurrentPoint(), (float)rocks[i]->getRadius());
+		rockGrid.build();
+
+		double oneThread = steerSaucers(saucers, rockGrid, false);
+		double allThreads = steerSaucers(saucers, rockGrid, true);
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << oneThread << std::setw(14) << allThreads;
+		if (count <= BENCHMARK_MAX_ALL_PAIRS)
+		{
+			// only finding the flock mates, none of the steering
+			int seen = 0;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < (int)saucers.size(); i++)
+				for (int j = 0; j < (int)saucers.size(); j++)
+				{
+					float dx = saucers[i].getPoint().getX() - saucers[j].getPoint().getX();
+					float dy = saucers[i].getPoint().getY() - saucers[j].getPoint().getY();
+					if (i != j && dx * dx + dy * dy <= FLOCK_SIGHT * FLOCK_SIGHT)
+						seen++;
+				}
+			std::chrono::duration<double, std::milli> pairTime =
+				std::chrono::high_resolution_clock::now() - start;
+			out << std::setw(14) << pairTime.count() << std::setw(10) << (float)seen / count;
+		}
+		else
+			out << std::setw(14) << "-" << std::setw(10) << "-";
+		out << "\n";
+		deleteField(rocks);
+	}
+}
+
+void benchmarkOutlines(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 100000 };
+	srand(1);
+
+	out << "Outlines: pool bytes per rock, microseconds to make a rock with its outline,\n"
+	    << "and pool bytes per rock after half the rocks are replaced ten times\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "bytes" << std::setw(14) << "make"
+	    << std::setw(14) << "after churn" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		std::chrono::duration<double, std::micro> makeTime =
+			std::chrono::high_resolution_clock::now() - start;
+		double bytes = (double)OutlinePool::getBytes() / OutlinePool::size();
+
+		// break up and remake half the field over and over, like a game does
+		for (int round = 0; round < 10; round++)
+		{
+			for (int i = round % 2; i < (int)rocks.size(); i += 2)
+			{
+				delete rocks[i];
+				rocks[i] = new MediumRock(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)));
+			}
+		}
+		double churnBytes = (double)OutlinePool::getBytes() / OutlinePool::size();
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << bytes << std::setw(14) << makeTime.count() / count
+		    << std::setw(14) << churnBytes << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * THREATS BY STEPPING
+ * The slow way: move every rock and the ship ahead a tick at a time and
+ * see which rocks come within reach.
+ ******************************************/
+static std::vector<Rocks *> threatsByStepping(const std::vector<Rocks *> & rocks, const Point & ship,
+                                            const Velocity & speed, float halfSize, int ticks)
+{
+	std::vector<Rocks *> found;
+	for (int i = 0; i < (int)rocks.size(); i++)
+	{
+		float radius = (float)rocks[i]->getRadius();
+		float reach = THREAT_DISTANCE + radius;
+		Point at = rocks[i]->getCurrentPoint();
+		float x = at.getX();
+		float y = at.getY();
+		float shipX = ship.getX();
+		float shipY = ship.getY();
+		for (int tick = 0; tick <= ticks; tick++)
+		{
+			if ((x - shipX) * (x - shipX) + (y - shipY) * (y - shipY) <= reach * reach)
+			{
+				found.push_back(rocks[i]);
+				break;
+			}
+			x += rocks[i]->getVelocity().getDx();
+			y += rocks[i]->getVelocity().getDy();
+			// a rock comes out across the edge it went off
+			if (std::abs(x) > halfSize + radius)
+				x -= std::copysign(2 * (halfSize + radius), x);
+			if (std::abs(y) > halfSize + radius)
+				y -= std::copysign(2 * (halfSize + radius), y);
+			shipX += speed.getDx();
+			shipY += speed.getDy();
+			if (std::abs(shipX) > halfSize + SHIP_SIZE || std::abs(shipY) > halfSize + SHIP_SIZE)
+			{
+				bool flipY = std::abs(shipY) >= halfSize;
+				bool flipX = std::abs(shipX) >= halfSize;
+				shipX = flipX ? -shipX : shipX;
+				shipY = flipY ? -shipY : shipY;
+			}
+		}
+	}
+	return found;
+}
+
+void benchmarkThreats(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 50000, 100000 };
+	const int ticks = (int)(THREAT_TICKS * FRAMES_VARIABLES_MULTIPLIER);
+	srand(1);
+
+	out << "Threats: milliseconds per tick to keep the list of rocks that will come near\n"
+	    << "the ship in the next " << ticks << " ticks, with " << BENCHMARK_THREAT_KILLS
+	    << " rocks broken up each tick and the ship thrusting every tick\n"
+	    << "and turning every " << BENCHMARK_THREAT_TURN << ", against moving everything ahead each tick\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "tracker" << std::setw(10) << "rescans"
+	    << std::setw(10) << "rechecks"
+	    << std::setw(14) << "stepping" << std::setw(10) << "threats" << std::setw(10) << "missed"
+	    << std::setw(10) << "extra" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		Point ship(0, 0);
+		Velocity speed(1.5f / FRAMES_VARIABLES_MULTIPLIER, 0.5f / FRAMES_VARIABLES_MULTIPLIER);
+
+		ThreatTracker tracker;
+		tracker.setWorld(Point(-halfSize, halfSize), Point(halfSize, -halfSize));
+		int watcher = tracker.watch(THREAT_DISTANCE, ticks);
+		for (int i = 0; i < (int)rocks.size(); i++)
+			tracker.add(rocks[i]);
+
+		// the slow way is only done on some ticks once there are a lot of rocks
+		int stepEvery = std::max(1, count / 10000);
+		int stepped = 0;
+		int threatCount = 0;
+		int missed = 0;
+		int extra = 0;
+		std::vector<Threat> threats;
+		std::chrono::duration<double, std::milli> trackTime(0);
+		std::chrono::duration<double, std::milli> stepTime(0);
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			moveField();
+			ship.addX(speed.getDx());
+			ship.addY(speed.getDy());
+			if (std::abs(ship.getX()) > halfSize + SHIP_SIZE || std::abs(ship.getY()) > halfSize + SHIP_SIZE)
+				ship = Point(std::abs(ship.getX()) >= halfSize ? -ship.getX() : ship.getX(),
+				             std::abs(ship.getY()) >= halfSize ? -ship.getY() : ship.getY());
+			if (tick % BENCHMARK_THREAT_TURN == 0)
+				speed = Velocity(speed.getDy(), -speed.getDx());
+			float push = BENCHMARK_THREAT_THRUST / FRAMES_VARIABLES_MULTIPLIER /
+			             sqrt(speed.getDx() * speed.getDx() + speed.getDy() * speed.getDy());
+			speed = Velocity(speed.getDx() * (1 + push), speed.getDy() * (1 + push));
+
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int kill = 0; kill < BENCHMARK_THREAT_KILLS; kill++)
+			{
+				int which = random(0, (int)rocks.size());
+				std::vector<Rocks *> pieces = rocks[which]->killRocks();
+				tracker.remove(rocks[which]);
+				delete rocks[which];
+				rocks[which] = rocks.back();
+				rocks.pop_back();
+				for (int piece = 0; piece < (int)pieces.size(); piece++)
+				{
+					rocks.push_back(pieces[piece]);
+					tracker.add(pieces[piece]);
+				}
+			}
+			tracker.tick();
+			tracker.follow(watcher, ship, speed, SHIP_SIZE);
+			tracker.getThreats(watcher, ticks, threats);
+			trackTime += std::chrono::high_resolution_clock::now() - start;
+
+			if (tick % stepEvery != 0)
+				continue;
+			start = std::chrono::high_resolution_clock::now();
+			std::vector<Rocks *> expected = threatsByStepping(rocks, ship, speed, halfSize, ticks);
+			stepTime += std::chrono::high_resolution_clock::now() - start;
+			stepped++;
+
+			threatCount += (int)expected.size();
+			for (int i = 0; i < (int)expected.size(); i++)
+			{
+				bool listed = false;
+				for (int j = 0; j < (int)threats.size() && !listed; j++)
+					listed = (threats[j].rock == expected[i]);
+				if (!listed)
+					missed++;
+			}
+			extra += (int)threats.size() - ((int)expected.size() - missed);
+		}
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << trackTime.count() / BENCHMARK_TICKS
+		    << std::setw(10) << tracker.getRescans()
+		    << std::setw(10) << tracker.getRechecks() / BENCHMARK_TICKS
+		    << std::setw(14) << stepTime.count() / stepped
+		    << std::setw(10) << threatCount / stepped
+		    << std::setw(10) << missed
+		    << std::setw(10) << extra << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * BENCHMARK KINETIC
+ ******************************************/
+void benchmarkKinetic(std::ostream & out)
+{
+	const float spacings[] = { 20, 40, 80, 160, 320, 640 };
+	const float shotSpeed = BULLET_SPEED / FRAMES_VARIABLES_MULTIPLIER;
+
+	out << "Kinetic: milliseconds per tick for " << BENCHMARK_KINETIC_SHOTS << " shots against "
+	    << BENCHMARK_KINETIC_ROCKS << " rocks, " << BENCHMARK_KINETIC_TURNS << " shots turning each tick,\n"
+	    << "spread out more and more. The grid moves everything and builds the grid every\n"
+	    << "tick, the kinetic queue only handles cells crossed and hits. Putting everything\n"
+	    << "in the queue the first time is timed on its own.\n";
+	out << std::setw(10) << "spacing" << std::setw(14) << "grid" << std::setw(10) << "hits"
+	    << std::setw(14) << "kinetic" << std::setw(10) << "hits" << std::setw(12) << "events"
+	    << std::setw(12) << "setup" << "\n";
+	for (float spacing : spacings)
+	{
+		srand(1);
+		float halfSize = spacing * sqrt((float)BENCHMARK_KINETIC_ROCKS) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(BENCHMARK_KINETIC_ROCKS, halfSize);
+		float maxRadius = 0;
+		for (int i = 0; i < (int)rocks.size(); i++)
+			maxRadius = std::max(maxRadius, (float)rocks[i]->getRadius());
+
+		std::vector<Point> shotStarts;
+		std::vector<Velocity> shotSpeeds;
+		for (int i = 0; i < BENCHMARK_KINETIC_SHOTS; i++)
+		{
+			float angle = (float)random(0.0, 2.0 * M_PI);
+			shotStarts.push_back(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)));
+			shotSpeeds.push_back(Velocity(shotSpeed * cos(angle), shotSpeed * sin(angle)));
+		}
+		std::vector<int> turned;
+		std::vector<Velocity> turns;
+		for (int i = 0; i < BENCHMARK_TICKS * BENCHMARK_KINETIC_TURNS; i++)
+		{
+			float angle = (float)random(0.0, 2.0 * M_PI);
+			turned.push_back(random(0, BENCHMARK_KINETIC_SHOTS));
+			turns.push_back(Velocity(shotSpeed * cos(angle), shotSpeed * sin(angle)));
+		}
+		Point topLeft(-halfSize, halfSize);
+		Point bottomRight(halfSize, -halfSize);
+
+		// every tick: move everything, build the grid, look around every shot
+		std::vector<Point> rockAt;
+		for (int i = 0; i < (int)rocks.size(); i++)
+			rockAt.push_back(rocks[i]->getCurrentPoint());
+		std::vector<Point> shotAt = shotStarts;
+		std::vector<Velocity> shotMove = shotSpeeds;
+		std::vector<bool> shotAlive(BENCHMARK_KINETIC_SHOTS, true);
+		SpatialGrid grid;
+		int gridHits = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			for (int i = 0; i < BENCHMARK_KINETIC_TURNS; i++)
+				shotMove[turned[tick * BENCHMARK_KINETIC_TURNS + i]] = turns[tick * BENCHMARK_KINETIC_TURNS + i];
+
+			grid.clear();
+			for (int i = 0; i < (int)rockAt.size(); i++)
+			{
+				Velocity speed = rocks[i]->getVelocity();
+				rockAt[i] = World::fold(Point(rockAt[i].getX() + speed.getDx(), rockAt[i].getY() + speed.getDy()),
+				                        topLeft, bottomRight);
+				grid.insert(i, rockAt[i], (float)rocks[i]->getRadius());
+			}
+			grid.build();
+			for (int i = 0; i < (int)shotAt.size(); i++)
+			{
+				if (!shotAlive[i])
+					continue;
+				shotAt[i] = World::fold(Point(shotAt[i].getX() + shotMove[i].getDx(), shotAt[i].getY() + shotMove[i].getDy()),
+				                        topLeft, bottomRight);
+				float x = shotAt[i].getX();
+				float y = shotAt[i].getY();
+				grid.query(x, y, x, y, [&](const GridEntry & rock)
+				{
+					float dx = rock.x - x;
+					float dy = rock.y - y;
+					if (shotAlive[i] && dx * dx + dy * dy <= rock.radius * rock.radius)
+					{
+						shotAlive[i] = false;
+						gridHits++;
+					}
+				});
+			}
+		}
+		std::chrono::duration<double, std::milli> gridTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		// the same with the queue
+		start = std::chrono::high_resolution_clock::now();
+		KineticCollisions kinetic;
+		kinetic.setWorld(halfSize, halfSize, std::max(2 * maxRadius, spacing));
+		for (int i = 0; i < (int)rocks.size(); i++)
+			kinetic.add(KINETIC_ROCK, rocks[i]->getCurrentPoint(), rocks[i]->getVelocity(), (float)rocks[i]->getRadius());
+		std::vector<int> shotIds;
+		for (int i = 0; i < BENCHMARK_KINETIC_SHOTS; i++)
+			shotIds.push_back(kinetic.add(KINETIC_SHOT, shotStarts[i], shotSpeeds[i], 0));
+		std::chrono::duration<double, std::milli> setupTime =
+			std::chrono::high_resolution_clock::now() - start;
+		std::vector<bool> kineticAlive(BENCHMARK_KINETIC_SHOTS, true);
+		int kineticHits = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+		{
+			for (int i = 0; i < BENCHMARK_KINETIC_TURNS; i++)
+			{
+				int shot = turned[tick * BENCHMARK_KINETIC_TURNS + i];
+				if (kineticAlive[shot])
+					kinetic.setMotion(shotIds[shot], kinetic.getPoint(shotIds[shot]),
+					                  turns[tick * BENCHMARK_KINETIC_TURNS + i]);
+			}
+			kinetic.advance((float)(tick + 1), [&](int rock, int shot)
+			{
+				kinetic.remove(shot);
+				kineticAlive[shot - shotIds[0]] = false;
+				kineticHits++;
+			});
+		}
+		std::chrono::duration<double, std::milli> kineticTime =
+			std::chrono::high_resolution_clock::now() - start;
+
+		out << std::setw(10) << (int)spacing << std::fixed << std::setprecision(3)
+		    << std::setw(14) << gridTime.count() / BENCHMARK_TICKS << std::setw(10) << gridHits
+		    << std::setw(14) << kineticTime.count() / BENCHMARK_TICKS << std::setw(10) << kineticHits
+		    << std::setw(12) << kinetic.getEvents() << std::setw(12) << setupTime.count() << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * COUNT BATCH
+ * Stands in for the screen: just counts what it is handed
+ ******************************************/
+static long batchVertices = 0;
+static void countBatch(int primitive, const unsigned char * color, const float * vertices, int count)
+{
+	batchVertices += count;
+}
+
+/******************************************
+ * BENCHMARK BATCHES
+ ******************************************/
+void benchmarkBatches(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 100000 };
+	srand(1);
+
+	out << "Batches: draw calls for a frame of rocks with a bullet for every four rocks,\n"
+	    << "one for each draw the old way against the batch, and milliseconds to fill\n"
+	    << "and flush the batch (without the screen) on one thread and on every core ("
+	    << threadCount() << ")\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "draws" << std::setw(14) << "batched"
+	    << std::setw(14) << "ms" << std::setw(14) << "threads ms" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		std::vector<Bullet> bullets;
+		for (int i = 0; i < count / 4; i++)
+			bullets.push_back(Bullet(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)),
+			                         (float)random(0.0, 360.0), Velocity()));
+
+		DrawBuffer buffer;
+		int draws = 0;
+		double times[2];
+		for (int parallel = 0; parallel < 2; parallel++)
+		{
+			batchVertices = 0;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+			{
+				beginBatch(buffer);
+				buffer.setLayer(0);
+				if (parallel)
+				{
+					drawParallel((int)rocks.size(), [&](int begin, int end)
+					{
+						for (int i = begin; i < end; i++)
+							rocks[i]->draw();
+					});
+				}
+				else
+				{
+					for (int i = 0; i < (int)rocks.size(); i++)
+						rocks[i]->draw();
+				}
+				buffer.setLayer(1);
+				if (parallel)
+				{
+					drawParallel((int)bullets.size(), [&](int begin, int end)
+					{
+						for (int i = begin; i < end; i++)
+							bullets[i].draw();
+					});
+				}
+				else
+				{
+					for (int i = 0; i < (int)bullets.size(); i++)
+						bullets[i].draw();
+				}
+				endBatch();
+				buffer.flush(countBatch);
+				draws = buffer.getDraws();
+			}
+			std::chrono::duration<double, std::milli> time =
+				std::chrono::high_resolution_clock::now() - start;
+			times[parallel] = time.count() / BENCHMARK_TICKS;
+		}
+
+		out << std::setw(10) << count << std::setw(14) << draws << std::setw(14) << buffer.getCalls()
+		    << std::fixed << std::setprecision(3) << std::setw(14) << times[0]
+		    << std::setw(14) << times[1] << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * BENCHMARK TRIG
+ ******************************************/
+bool benchmarkTrig(std::ostream & out)
+{
+	srand(1);
+	std::vector<float> angles;
+	for (int i = 0; i < BENCHMARK_TRIG_ANGLES; i++)
+		angles.push_back((float)random(-720.0, 720.0));
+	// whole degrees too, which is what most of the game turns by
+	for (int i = 0; i < 360; i++)
+		angles[i] = (float)i;
+
+	double worstSin = 0;
+	double worstCos = 0;
+	for (int i = 0; i < (int)angles.size(); i++)
+	{
+		double radians = M_PI / 180.0 * angles[i];
+		worstSin = std::max(worstSin, std::abs(sinDeg(angles[i]) - sin(radians)));
+		worstCos = std::max(worstCos, std::abs(cosDeg(angles[i]) - cos(radians)));
+	}
+
+	// add them up so the calls are not thrown away
+	volatile float sum = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < (int)angles.size(); i++)
+		sum += cos(M_PI / 180.0 * angles[i]) + sin(M_PI / 180.0 * angles[i]);
+	std::chrono::duration<double, std::nano> libraryTime =
+		std::chrono::high_resolution_clock::now() - start;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < (int)angles.size(); i++)
+		sum += cosDeg(angles[i]) + sinDeg(angles[i]);
+	std::chrono::duration<double, std::nano> tableTime =
+		std::chrono::high_resolution_clock::now() - start;
+
+	out << "Trig: the table against the library for " << angles.size() << " angles between\n"
+	    << "-720 and 720 degrees. The worst error has to be under " << TRIG_ERROR << ".\n";
+	out << std::setw(12) << "worst sin" << std::setw(12) << "worst cos" << std::setw(16) << "library ns"
+	    << std::setw(14) << "table ns" << "\n";
+	out << std::scientific << std::setprecision(2) << std::setw(12) << worstSin << std::setw(12) << worstCos
+	    << std::fixed << std::setprecision(3) << std::setw(16) << libraryTime.count() / angles.size()
+	    << std::setw(14) << tableTime.count() / angles.size() << "\n";
+	bool within = worstSin < TRIG_ERROR && worstCos < TRIG_ERROR;
+	out << (within ? "within" : "NOT within") << " the error\n";
+	return within;
+}
+
+/******************************************
+ * BENCHMARK RASTER
+ ******************************************/
+void benchmarkRaster(std::ostream & out)
+{
+	const int counts[] = { 1000, 10000, 100000 };
+	srand(1);
+
+	out << "Raster: milliseconds to draw a frame of rocks with a bullet for every four\n"
+	    << "rocks onto " << BENCHMARK_RASTER_SIZE << " by " << BENCHMARK_RASTER_SIZE
+	    << " pixels in software, on one thread and on every core (" << threadCount() << ")\n";
+	out << std::setw(10) << "rocks" << std::setw(14) << "1 thread" << std::setw(14) << "threads"
+	    << std::setw(14) << "speedup" << "\n";
+	for (int count : counts)
+	{
+		float halfSize = sqrt(count * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+		std::vector<Rocks *> rocks = makeField(count, halfSize);
+		std::vector<Bullet> bullets;
+		for (int i = 0; i < count / 4; i++)
+			bullets.push_back(Bullet(Point(random(-halfSize, halfSize), random(-halfSize, halfSize)),
+			                         (float)random(0.0, 360.0), Velocity()));
+
+		Raster raster(BENCHMARK_RASTER_SIZE, BENCHMARK_RASTER_SIZE);
+		raster.setView(Point(-halfSize, halfSize), Point(halfSize, -halfSize));
+		double times[2];
+		for (int parallel = 0; parallel < 2; parallel++)
+		{
+			raster.setParallel(parallel == 1);
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int tick = 0; tick < BENCHMARK_TICKS; tick++)
+			{
+				raster.clear();
+				beginSoftware(raster);
+				for (int i = 0; i < (int)rocks.size(); i++)
+					rocks[i]->draw();
+				for (int i = 0; i < (int)bullets.size(); i++)
+					bullets[i].draw();
+				endSoftware();
+			}
+			std::chrono::duration<double, std::milli> time =
+				std::chrono::high_resolution_clock::now() - start;
+			times[parallel] = time.count() / BENCHMARK_TICKS;
+		}
+
+		out << std::setw(10) << count << std::fixed << std::setprecision(3)
+		    << std::setw(14) << times[0] << std::setw(14) << times[1]
+		    << std::setprecision(2) << std::setw(14) << times[0] / times[1] << "\n";
+		deleteField(rocks);
+	}
+}
+
+/******************************************
+ * BENCHMARK PACER
+ * The old way is what drawCallback() did: sleep for whatever is left,
+ * then set the next frame one period from before the sleep.
+ ******************************************/
+void benchmarkPacer(std::ostream & out)
+{
+	using Clock = std::chrono::steady_clock;
+	const double period = 1.0 / 60.0;
+	srand(1);
+	std::vector<double> work;
+	for (int i = 0; i < BENCHMARK_PACER_FRAMES; i++)
+		work.push_back(random(0.0, BENCHMARK_PACER_WORK));
+	auto busy = [](double seconds)
+	{
+		Clock::time_point until = Clock::now() +
+			std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+		while (Clock::now() < until)
+			;
+	};
+	auto seconds = [](Clock::duration time) { return std::chrono::duration<double>(time).count(); };
+
+	out << "Pacer: " << BENCHMARK_PACER_FRAMES << " frames at 60 a second with up to "
+	    << BENCHMARK_PACER_WORK * 1000 << " ms of work each, how far behind the\n"
+	    << "last frame ended up and how late the frames woke (microseconds)\n";
+	out << std::setw(10) << "pacer" << std::setw(14) << "behind ms" << std::setw(14) << "mean late"
+	    << std::setw(14) << "worst late" << std::setw(14) << "over 1 ms" << "\n";
+
+	// the old way
+	{
+		Clock::time_point start = Clock::now();
+		Clock::time_point next = start;
+		double totalLate = 0;
+		double worstLate = 0;
+		int overMs = 0;
+		for (int i = 0; i < (int)work.size(); i++)
+		{
+			busy(work[i]);
+			Clock::time_point currentTime = Clock::now();
+			if (next > currentTime)
+				std::this_thread::sleep_for(next - currentTime);
+			double late = std::max(0.0, seconds(Clock::now() - next));
+			totalLate += late;
+			worstLate = std::max(worstLate, late);
+			overMs += (late > 0.001);
+			next = currentTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+		}
+		double behind = seconds(Clock::now() - start) - work.size() * period;
+		out << std::setw(10) << "sleep" << std::fixed << std::setprecision(3)
+		    << std::setw(14) << behind * 1000 << std::setprecision(1)
+		    << std::setw(14) << totalLate / work.size() * 1e6 << std::setw(14) << worstLate * 1e6
+		    << std::setw(14) << overMs << "\n";
+	}
+
+	// the pacer, which starts its deadlines at its first wait
+	FramePacer pacer;
+	pacer.wait(period);
+	Clock::time_point start = Clock::now();
+	int overMs = 0;
+	for (int i = 0; i < (int)work.size(); i++)
+	{
+		busy(work[i]);
+		overMs += (pacer.wait(period) > 0.001);
+	}
+	double behind = seconds(Clock::now() - start) - work.size() * period;
+	out << std::setw(10) << "deadline" << std::fixed << std::setprecision(3)
+	    << std::setw(14) << behind * 1000 << std::setprecision(1)
+	    << std::setw(14) << pacer.getMeanLate() * 1e6 << std::setw(14) << pacer.getWorstLate() * 1e6
+	    << std::setw(14) << overMs << "\n";
+
+	out << "\nHow late the pacer's frames woke\n";
+	for (int i = 0; i < PACER_BUCKETS; i++)
+	{
+		if (i < PACER_BUCKETS - 1)
+			out << "  under " << std::setw(8) << std::setprecision(0) << FramePacer::getBucketTop(i) * 1e6 << " us";
+		else
+			out << "  the rest        ";
+		out << std::setw(8) << pacer.getBucket(i) << "\n";
+	}
+	out << "  resyncs          " << std::setw(8) << pacer.getResyncs() << "\n";
+}
+
+/******************************************
+ * BENCHMARK CAPTURE
+ * The frame is drawn once in software and recorded over and over, at
+ * 60 a second like the window and then as fast as it can be added.
+ ******************************************/
+void benchmarkCapture(std::ostream & out)
+{
+	srand(1);
+	float halfSize = sqrt(1000 * BENCHMARK_AREA_PER_ROCK) / 2.0f;
+	std::vector<Rocks *> rocks = makeField(1000, halfSize);
+	Raster raster(BENCHMARK_RASTER_SIZE, BENCHMARK_RASTER_SIZE);
+	raster.setView(Point(-halfSize, halfSize), Point(halfSize, -halfSize));
+	beginSoftware(raster);
+	for (int i = 0; i < (int)rocks.size(); i++)
+		rocks[i]->draw();
+	endSoftware();
+	deleteField(rocks);
+
+	out << "Capture: " << BENCHMARK_CAPTURE_FRAMES << " frames of " << BENCHMARK_RASTER_SIZE << " by "
+	    << BENCHMARK_RASTER_SIZE << " recorded to " << BENCHMARK_CAPTURE_FILE << ", milliseconds each\n"
+	    << "frame took on the thread drawing them, and how many the writer kept up with\n";
+	out << std::setw(10) << "scale" << std::setw(10) << "rate" << std::setw(12) << "mean ms"
+	    << std::setw(12) << "worst ms" << std::setw(10) << "written" << std::setw(10) << "dropped" << "\n";
+	const int scales[] = { 1, 2, 1 };
+	for (int row = 0; row < 3; row++)
+	{
+		bool paced = row < 2;
+		FrameCapture capture(BENCHMARK_CAPTURE_FILE, raster.getWidth(), raster.getHeight(), scales[row], 60);
+		if (!capture.isOpen())
+		{
+			out << "Could not write " << BENCHMARK_CAPTURE_FILE << "\n";
+			return;
+		}
+		FramePacer pacer;
+		for (int frame = 0; frame < BENCHMARK_CAPTURE_FRAMES; frame++)
+		{
+			capture.add(raster.getPixels(), false);
+			if (paced)
+				pacer.wait(1.0 / 60.0);
+		}
+		capture.finish();
+		out << std::setw(10) << scales[row] << std::setw(10) << (paced ? "60" : "flat out")
+		    << std::fixed << std::setprecision(3)
+		    << std::setw(12) << capture.getMeanTime() * 1000 << std::setw(12) << capture.getWorstTime() * 1000
+		    << std::setw(10) << capture.getWritten() << std::setw(10) << capture.getDropped() << "\n";
+	}
+	remove(BENCHMARK_CAPTURE_FILE);
+}
@@ -0,0 +1,128 @@
+/***********************************************************************
+ * Header File:
+ *    Benchmark : timing runs for the optional game modes
+ * Summary:
+ *    These run without opening a window so they can be used on any
+ *    machine. Each one prints a table to the stream it is given.
+ *    They are started from the command line, see driver.cpp.
+ ************************************************************************/
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <iostream>
+
+/******************************************
+ * BENCHMARK BOUNCE
+ * Time per tick of bouncing rocks for a growing number of rocks,
+ * using the grid and (while it is still bearable) every pair.
+ ******************************************/
+void benchmarkBounce(std::ostream & out);
+
+/******************************************
+ * BENCHMARK GRAVITY
+ * Time per tick to work out the pull on every body, for a growing
+ * number of bodies, with the given opening angle. Small fields are
+ * also done the slow exact way to show how far off the tree is.
+ ******************************************/
+void benchmarkGravity(std::ostream & out, float theta);
+
+/******************************************
+ * BENCHMARK PARTICLES
+ * Time per tick to move the particles and build their draw lists,
+ * for a growing number of live particles, up to the full budget.
+ ******************************************/
+void benchmarkParticles(std::ostream & out);
+
+/******************************************
+ * BENCHMARK BEAM
+ * Time per beam against a growing number of rocks, walking the grid,
+ * and checked against testing every rock.
+ ******************************************/
+void benchmarkBeam(std::ostream & out);
+
+/******************************************
+ * BENCHMARK MISSILES
+ * Time per tick for every missile to find the rock nearest it against
+ * a growing number of rocks, using the grid and looking at every rock.
+ ******************************************/
+void benchmarkMissiles(std::ostream & out);
+
+/******************************************
+ * BENCHMARK SHOCK WAVE
+ * How long the shock wave takes each tick to go over a growing number
+ * of rocks, against breaking them all up in one tick.
+ ******************************************/
+void benchmarkShockWave(std::ostream & out);
+
+/******************************************
+ * BENCHMARK SAUCERS
+ * Time per tick to steer and move a growing number of flocking
+ * saucers through a field of rocks, on one core and on all of them.
+ ******************************************/
+void benchmarkSaucers(std::ostream & out);
+
+/******************************************
+ * BENCHMARK OUTLINES
+ * How much memory the rock outlines take per rock and how long they
+ * take to make, for a growing number of rocks, and whether the pool
+ * grows when rocks keep being deleted and made.
+ ******************************************/
+void benchmarkOutlines(std::ostream & out);
+
+/******************************************
+ * BENCHMARK THREATS
+ * Time per tick to keep the list of rocks that are going to come near
+ * the ship up to date as rocks are broken up, against a growing number
+ * of rocks, and checked against moving everything ahead every tick.
+ ******************************************/
+void benchmarkThreats(std::ostream & out);
+
+/******************************************
+ * BENCHMARK BATCHES
+ * How many draw calls a frame of rocks and bullets takes drawn one at
+ * a time and through a draw buffer, and how long filling the buffer
+ * takes on one thread and on every core, for a growing number of rocks.
+ ******************************************/
+void benchmarkBatches(std::ostream & out);
+
+/******************************************
+ * BENCHMARK KINETIC
+ * Time per tick for shots to hit rocks found ahead of time by the
+ * kinetic queue, against moving everything and using the grid every
+ * tick, as the field is spread out more and more.
+ ******************************************/
+void benchmarkKinetic(std::ostream & out);
+
+/******************************************
+ * BENCHMARK TRIG
+ * How far the sine and cosine table is from the library, and how long
+ * each takes per angle for a sine and a cosine. Returns false if the
+ * table is not within TRIG_ERROR.
+ ******************************************/
+bool benchmarkTrig(std::ostream & out);
+
+/******************************************
+ * BENCHMARK RASTER
+ * Time to draw a frame of rocks and bullets onto pixels in memory with
+ * the software raster, on one thread and on every core, for a growing
+ * number of rocks.
+ ******************************************/
+void benchmarkRaster(std::ostream & out);
+
+/******************************************
+ * BENCHMARK PACER
+ * How far behind a run of frames with changing amounts of work ends up,
+ * and how late each frame wakes, with the old sleep for what is left
+ * and with the frame pacer's deadlines.
+ ******************************************/
+void benchmarkPacer(std::ostream & out);
+
+/******************************************
+ * BENCHMARK CAPTURE
+ * How long recording a frame takes on the thread drawing it, and how
+ * many frames the writer thread keeps up with, at the window's rate and
+ * as fast as they can be added.
+ ******************************************/
+void benchmarkCapture(std::ostream & out);
+
+#endif // BENCHMARK_H
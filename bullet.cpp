@@ -5,6 +5,7 @@
  *********************************************************************/
 #include "bullet.h"
 #include "uiInteract.h"
+#include "trig.h"
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES 
@@ -31,8 +32,8 @@ Bullet::Bullet(const Point & point_, const float & angle, const Velocity & shipV
 	float dx;
 	float dy;
 
-	dx = ((BULLET_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle))) + shipV.getDx();
-	dy = ((BULLET_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle))) + shipV.getDy();
+	dx = ((BULLET_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle))) + shipV.getDx();
+	dy = ((BULLET_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle))) + shipV.getDy();
 
 	speed.setDx(dx);
 	speed.setDy(dy);
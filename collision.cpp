@@ -0,0 +1,188 @@
+/*********************************************************************
+ * File: collision.cpp
+ * Description: Contains the implementaiton of the collision
+ *  functions.
+ *********************************************************************/
+#include "collision.h"
+
+// These are needed for the getClosestDistance function...
+#include <limits>
+#include <algorithm>
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//Extra room given to the quick rejects so rounding can never make them
+//throw out something the exact test would have kept.
+constexpr float REJECT_MARGIN = 1.0;
+
+/**********************************************************
+ * Function: getClosestDistance
+ * Description: Determine how close these two objects will
+ *   get in between the frames.
+ **********************************************************/
+float getClosestDistance(const FlyingObject &obj1, const FlyingObject &obj2)
+{
+   // find the maximum distance traveled
+   float dMax = std::max(std::abs(obj1.getVelocity().getDx()), std::abs(obj1.getVelocity().getDy()));
+   dMax = std::max(dMax, std::abs(obj2.getVelocity().getDx()));
+   dMax = std::max(dMax, std::abs(obj2.getVelocity().getDy()));
+   dMax = std::max(dMax, 0.1f); // when dx and dy are 0.0. Go through the loop once.
+   
+   // rocks work out where they are, so only ask once
+   Point start1 = obj1.getCurrentPoint();
+   Point start2 = obj2.getCurrentPoint();
+
+   float distMin = std::numeric_limits<float>::max();
+   for (float i = 0.0; i <= dMax; i++)
+   {
+      Point point1(start1.getX() + (obj1.getVelocity().getDx() * i / dMax),
+                     start1.getY() + (obj1.getVelocity().getDy() * i / dMax));
+      Point point2(start2.getX() + (obj2.getVelocity().getDx() * i / dMax),
+                     start2.getY() + (obj2.getVelocity().getDy() * i / dMax));
+      
+      float xDiff = point1.getX() - point2.getX();
+      float yDiff = point1.getY() - point2.getY();
+      
+      float distSquared = (xDiff * xDiff) +(yDiff * yDiff);
+      
+      distMin = std::min(distMin, distSquared);
+   }
+   
+   return sqrt(distMin);
+}
+
+/******************************************
+ * IS WITHIN DISTANCE
+ * Over the frame the gap between the two can shrink by at most
+ * how far they move relative to each other.
+ ******************************************/
+bool isWithinDistance(const FlyingObject & obj1, const FlyingObject & obj2, float reach)
+{
+	Point point1 = obj1.getCurrentPoint();
+	Point point2 = obj2.getCurrentPoint();
+	float xDiff = point1.getX() - point2.getX();
+	float yDiff = point1.getY() - point2.getY();
+	float dxDiff = obj1.getVelocity().getDx() - obj2.getVelocity().getDx();
+	float dyDiff = obj1.getVelocity().getDy() - obj2.getVelocity().getDy();
+
+	float farthest = reach + sqrt((dxDiff * dxDiff) + (dyDiff * dyDiff)) + REJECT_MARGIN;
+	if ((xDiff * xDiff) + (yDiff * yDiff) > farthest * farthest)
+		return false;
+
+	return reach >= getClosestDistance(obj1, obj2);
+}
+
+/**************************************************************************
+ * IS ON SCREEN
+ * Determines if a given point is on the screen.
+ **************************************************************************/
+bool isOnScreen(const Point & point, int radius, const Point & topLeft, const Point & bottomRight)
+{
+	return (point.getX() >= topLeft.getX() - radius
+		&& point.getX() <= bottomRight.getX() + radius
+		&& point.getY() >= bottomRight.getY() - radius
+		&& point.getY() <= topLeft.getY() + radius);
+}
+
+void wrapAround(FlyingObject & obj, int radius, const Point & topLeft, const Point & bottomRight)
+{
+	if (!isOnScreen(obj.getPoint(), radius, topLeft, bottomRight))
+	{
+		obj.flipSide(std::abs(obj.getPoint().getY()) >= topLeft.getY(), std::abs(obj.getPoint().getX()) >= bottomRight.getX());
+	}
+}
+
+void hitRocks(Bullet & bullet, std::vector<Rocks *> & rocks, const RockHitCallback & onHit)
+{
+	// check if the asteroid is at this point (in case it was hit)
+	for (int asteroidCount = 0; asteroidCount < (int)rocks.size(); asteroidCount++)
+	{
+		if (rocks[asteroidCount]->isAlive())
+		{
+			if ((rocks[asteroidCount]->getRadius()) >= getClosestDistance(bullet, *(rocks[asteroidCount])))
+			{
+				//we have a hit!
+				std::vector<Rocks*> temp;
+				temp = rocks[asteroidCount]->killRocks();
+				for (int tempCount = 0; tempCount < (int)temp.size(); tempCount++)
+				{
+					rocks.push_back(temp[tempCount]);
+				}
+
+				// the bullet is dead as well
+				bullet.kill();
+
+				onHit(*rocks[asteroidCount]);
+			}
+		}
+	}
+}
+
+/******************************************
+ * ROCK BROAD PHASE : BUILD
+ ******************************************/
+void RockBroadPhase::build(const std::vector<Rocks *> & rocks)
+{
+	grid.clear();
+	maxSpeed = 0;
+	for (int i = 0; i < (int)rocks.size(); i++)
+	{
+		if (rocks[i]->isAlive())
+		{
+			grid.insert(i, rocks[i]->getCurrentPoint(), rocks[i]->getRadius());
+			Velocity speed = rocks[i]->getVelocity();
+			maxSpeed = std::max(maxSpeed, std::abs(speed.getDx()) + std::abs(speed.getDy()));
+		}
+	}
+	grid.build();
+	built = (int)rocks.size();
+}
+
+/******************************************
+ * ROCK BROAD PHASE : HIT ROCKS
+ * The rocks have to be checked in the same order hitRocks would
+ * check them, so the ones from the grid are sorted first. Pieces of
+ * rocks that broke after build() are not in the grid, they are
+ * checked one by one at the end just like hitRocks does.
+ ******************************************/
+void RockBroadPhase::hitRocks(Bullet & bullet, std::vector<Rocks *> & rocks, const RockHitCallback & onHit)
+{
+	Point point = bullet.getPoint();
+	Velocity speed = bullet.getVelocity();
+	float reach = std::abs(speed.getDx()) + std::abs(speed.getDy()) + maxSpeed + REJECT_MARGIN;
+
+	candidates.clear();
+	grid.query(point.getX() - reach, point.getY() - reach, point.getX() + reach, point.getY() + reach,
+		[this](const GridEntry & entry) { candidates.push_back(entry.id); });
+	std::sort(candidates.begin(), candidates.end());
+
+	for (int i = 0; i < (int)candidates.size(); i++)
+	{
+		Rocks * rock = rocks[candidates[i]];
+		if (rock->isAlive() && isWithinDistance(bullet, *rock, (float)rock->getRadius()))
+		{
+			std::vector<Rocks*> temp = rock->killRocks();
+			rocks.insert(rocks.end(), temp.begin(), temp.end());
+			bullet.kill();
+			onHit(*rocks[candidates[i]]);
+		}
+	}
+
+	for (int i = built; i < (int)rocks.size(); i++)
+	{
+		if (rocks[i]->isAlive() && isWithinDistance(bullet, *rocks[i], (float)rocks[i]->getRadius()))
+		{
+			std::vector<Rocks*> temp = rocks[i]->killRocks();
+			rocks.insert(rocks.end(), temp.begin(), temp.end());
+			bullet.kill();
+			onHit(*rocks[i]);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/***********************************************************************
+ * Header File:
+ *    Collision : the tests the game uses to decide what hit what
+ * Summary:
+ *    These used to live inside the game class. They were pulled out so
+ *    they can be run on their own, both by the game and by the kernel
+ *    check (see kernelCheck.h) that makes sure faster versions make the
+ *    exact same decisions.
+ *
+ *    The functions marked REFERENCE are what the game does. The ones
+ *    marked CANDIDATE are faster versions that must give the same
+ *    answers before the game is allowed to switch over to them.
+ ************************************************************************/
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "flyingObject.h"
+#include "bullet.h"
+#include "rocks.h"
+#include "spatialGrid.h"
+#include <vector>
+#include <functional>
+
+//What is called when a bullet hits a rock. The rock has already been
+//killed and its pieces are already at the end of the list.
+using RockHitCallback = std::function<void(Rocks &)>;
+
+/******************************************
+ * GET CLOSEST DISTANCE (REFERENCE)
+ * Determine how close these two objects will get in between
+ * the frames.
+ ******************************************/
+float getClosestDistance(const FlyingObject & obj1, const FlyingObject & obj2);
+
+/******************************************
+ * IS WITHIN DISTANCE (CANDIDATE)
+ * Same answer as reach >= getClosestDistance(), but throws out
+ * objects that are obviously too far apart without the loop.
+ ******************************************/
+bool isWithinDistance(const FlyingObject & obj1, const FlyingObject & obj2, float reach);
+
+/******************************************
+ * IS ON SCREEN (REFERENCE)
+ * Determines if a given point is on the screen.
+ ******************************************/
+bool isOnScreen(const Point & point, int radius, const Point & topLeft, const Point & bottomRight);
+
+/******************************************
+ * WRAP AROUND (REFERENCE)
+ * If the object went off the screen, move it to the other side.
+ ******************************************/
+void wrapAround(FlyingObject & obj, int radius, const Point & topLeft, const Point & bottomRight);
+
+/******************************************
+ * WRAP COORDINATES (CANDIDATE)
+ * Same thing on bare coordinates with no branches, so it can be run
+ * over whole arrays. Only for screens centered on (0, 0).
+ ******************************************/
+inline void wrapCoordinates(float & x, float & y, float radius, float halfWidth, float halfHeight)
+{
+	float absX = x < 0.0f ? -x : x;
+	float absY = y < 0.0f ? -y : y;
+	bool off = (absX > halfWidth + radius) | (absY > halfHeight + radius);
+	x = (off & (absX >= halfWidth)) ? -x : x;
+	y = (off & (absY >= halfHeight)) ? -y : y;
+}
+
+/******************************************
+ * HIT ROCKS (REFERENCE)
+ * Check one bullet against every rock, the way handleCollisions
+ * always has. A rock that is hit is split right away and its pieces
+ * go on the end of the list, so they get checked by this bullet too.
+ ******************************************/
+void hitRocks(Bullet & bullet, std::vector<Rocks *> & rocks, const RockHitCallback & onHit);
+
+/******************************************
+ * ROCK BROAD PHASE (CANDIDATE)
+ * The same check as hitRocks, but only against the rocks the grid
+ * says could be close. build() is called once a frame before any
+ * bullets are checked.
+ ******************************************/
+class RockBroadPhase
+{
+public:
+	RockBroadPhase() : built(0), maxSpeed(0) {   }
+
+	void build(const std::vector<Rocks *> & rocks);
+	void hitRocks(Bullet & bullet, std::vector<Rocks *> & rocks, const RockHitCallback & onHit);
+
+private:
+	SpatialGrid grid;
+	int built;                    // how many rocks were in the list at build()
+	float maxSpeed;               // fastest rock at build()
+	std::vector<int> candidates;  // kept so it is not allocated every bullet
+};
+
+#endif // COLLISION_H
@@ -0,0 +1,77 @@
+/*********************************************************************
+ * File: detail.cpp
+ * Description: Contains the implementaiton of the detail map class
+ *  methods.
+ *********************************************************************/
+#include "detail.h"
+
+#include <algorithm>
+#include <cmath>
+
+//What an unmarked cell starts as, further than anything is counted
+constexpr unsigned char DETAIL_FAR = DETAIL_MIDDLE_CELLS + 1;
+
+DetailMap::DetailMap(float cellSize)
+	: cellSize(cellSize), left(0), bottom(0), columns(1), rows(1), distance(1, DETAIL_FAR)
+{
+}
+
+void DetailMap::clear(const Point & topLeft, const Point & bottomRight)
+{
+	left = topLeft.getX();
+	bottom = bottomRight.getY();
+	columns = std::max(1, (int)std::ceil((bottomRight.getX() - topLeft.getX()) / cellSize));
+	rows = std::max(1, (int)std::ceil((topLeft.getY() - bottomRight.getY()) / cellSize));
+	distance.assign(columns * rows, DETAIL_FAR);
+}
+
+void DetailMap::mark(const Point & point)
+{
+	distance[cellOf(point)] = 0;
+}
+
+/******************************************
+ * BUILD
+ * Grow the marks out one cell at a time. The world wraps, so the cells
+ * on one edge are next to the cells on the other.
+ ******************************************/
+void DetailMap::build()
+{
+	for (int pass = 0; pass < DETAIL_MIDDLE_CELLS; pass++)
+	{
+		spread = distance;
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < columns; col++)
+			{
+				unsigned char nearest = distance[row * columns + col];
+				if (nearest != pass)
+					continue;
+				for (int dRow = -1; dRow <= 1; dRow++)
+					for (int dCol = -1; dCol <= 1; dCol++)
+					{
+						int other = ((row + dRow + rows) % rows) * columns + (col + dCol + columns) % columns;
+						spread[other] = std::min(spread[other], (unsigned char)(nearest + 1));
+					}
+			}
+		distance.swap(spread);
+	}
+}
+
+int DetailMap::getPeriod(const Point & point) const
+{
+	int cells = distance[cellOf(point)];
+	if (cells <= DETAIL_NEAR_CELLS)
+		return 1;
+	if (cells <= DETAIL_MIDDLE_CELLS)
+		return 2;
+	return DETAIL_FAR_PERIOD;
+}
+
+int DetailMap::cellOf(const Point & point) const
+{
+	int col = (int)((point.getX() - left) / cellSize);
+	int row = (int)((point.getY() - bottom) / cellSize);
+	col = std::max(0, std::min(columns - 1, col));
+	row = std::max(0, std::min(rows - 1, row));
+	return row * columns + col;
+}
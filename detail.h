@@ -0,0 +1,67 @@
+/***********************************************************************
+ * Header File:
+ *    Detail Map : decides how often each star needs moving, and which
+ *    rocks are close enough to be hit
+ * Summary:
+ *    The world is cut into cells and every cell with the ship or a bullet
+ *    in it is marked. Anything within a cell or so of a mark is moved
+ *    every tick. Further out it is moved every other tick, and further
+ *    still every fourth, each time catching up all the ticks it missed
+ *    in one step. Rocks are never moved (see Rocks::getCurrentPoint),
+ *    only the ones within a cell or so are checked for hits.
+ *
+ *    Nothing is left behind close enough to a bullet or the ship that it
+ *    could be hit, and the game keeps anything near the view at full rate
+ *    so nobody can see the difference.
+ ************************************************************************/
+#ifndef DETAIL_H
+#define DETAIL_H
+
+#include "point.h"
+
+#include <vector>
+
+//Size of each cell in the map
+constexpr float DETAIL_CELL_SIZE = 128.0;
+
+//Within this many cells of the ship or a bullet, move every tick
+constexpr int DETAIL_NEAR_CELLS = 1;
+
+//Within this many, move every other tick. Beyond it, every DETAIL_FAR_PERIOD ticks.
+constexpr int DETAIL_MIDDLE_CELLS = 3;
+constexpr int DETAIL_FAR_PERIOD = 4;
+
+//How far outside the view things are still moved every tick, more
+//than anything can move in DETAIL_FAR_PERIOD ticks
+constexpr float DETAIL_VIEW_MARGIN = 64.0;
+
+class DetailMap
+{
+public:
+	DetailMap(float cellSize = DETAIL_CELL_SIZE);
+
+	//Start over with no marks for a world with these corners
+	void clear(const Point & topLeft, const Point & bottomRight);
+
+	//The ship or a bullet is here
+	void mark(const Point & point);
+
+	//Work out how far every cell is from a mark. Call after marking.
+	void build();
+
+	//How many ticks apart something here needs moving (1, 2 or DETAIL_FAR_PERIOD)
+	int getPeriod(const Point & point) const;
+
+private:
+	int cellOf(const Point & point) const;
+
+	float cellSize;
+	float left;
+	float bottom;
+	int columns;
+	int rows;
+	std::vector<unsigned char> distance;  // cells to the nearest mark, stops counting past DETAIL_MIDDLE_CELLS
+	std::vector<unsigned char> spread;    // room to work in build()
+};
+
+#endif // DETAIL_H
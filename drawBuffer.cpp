@@ -0,0 +1,100 @@
+/*********************************************************************
+ * File: drawBuffer.cpp
+ * Description: Contains the implementaiton of the draw buffer class
+ *  methods.
+ *********************************************************************/
+#include "drawBuffer.h"
+
+#include <algorithm>
+
+DrawBuffer::DrawBuffer()
+	: layer(0), draws(0), lastDraws(0), lastCalls(0), last(-1)
+{
+}
+
+float * DrawBuffer::add(int primitive, float red, float green, float blue, int count)
+{
+	// colors are kept to what the screen can show, so a color that fades
+	// does not make a new bucket every frame
+	auto toByte = [](float value) -> std::uint64_t
+	{
+		return (std::uint64_t)(std::max(0.0f, std::min(1.0f, value)) * 255.0f + 0.5f);
+	};
+	std::uint64_t key = ((std::uint64_t)layer << 32) | ((std::uint64_t)primitive << 24) |
+	                    (toByte(red) << 16) | (toByte(green) << 8) | toByte(blue);
+
+	// most draws are the same as the one before
+	if (last < 0 || buckets[last].key != key)
+		last = bucketFor(key);
+
+	draws++;
+	std::vector<float> & vertices = buckets[last].vertices;
+	vertices.resize(vertices.size() + 2 * count);
+	return &vertices[vertices.size() - 2 * count];
+}
+
+int DrawBuffer::bucketFor(std::uint64_t key)
+{
+	auto found = indexes.find(key);
+	if (found != indexes.end())
+		return found->second;
+	buckets.push_back(Bucket());
+	buckets.back().key = key;
+	indexes[key] = (int)buckets.size() - 1;
+	return (int)buckets.size() - 1;
+}
+
+/******************************************
+ * APPEND
+ * The buckets are put with the ones of the same key here. The order
+ * within a bucket is other's after this one's.
+ ******************************************/
+void DrawBuffer::append(DrawBuffer & other)
+{
+	for (int i = 0; i < (int)other.buckets.size(); i++)
+	{
+		std::vector<float> & from = other.buckets[i].vertices;
+		if (from.empty())
+			continue;
+		std::vector<float> & to = buckets[bucketFor(other.buckets[i].key)].vertices;
+		to.insert(to.end(), from.begin(), from.end());
+		from.clear();
+	}
+	draws += other.draws;
+	other.draws = 0;
+	other.last = -1;
+	last = -1;
+}
+
+/******************************************
+ * FLUSH
+ * The buckets are sorted again only when one was added since the last
+ * flush. Empty ones are kept for next time.
+ ******************************************/
+void DrawBuffer::flush(DrawSubmit submit)
+{
+	auto before = [](const Bucket & a, const Bucket & b) { return a.key < b.key; };
+	if (!std::is_sorted(buckets.begin(), buckets.end(), before))
+	{
+		std::sort(buckets.begin(), buckets.end(), before);
+		for (int i = 0; i < (int)buckets.size(); i++)
+			indexes[buckets[i].key] = i;
+	}
+
+	lastCalls = 0;
+	for (int i = 0; i < (int)buckets.size(); i++)
+	{
+		std::vector<float> & vertices = buckets[i].vertices;
+		if (vertices.empty())
+			continue;
+		unsigned char color[3] = { (unsigned char)(buckets[i].key >> 16),
+		                           (unsigned char)(buckets[i].key >> 8),
+		                           (unsigned char)buckets[i].key };
+		submit((int)((buckets[i].key >> 24) & 0xff), color, vertices.data(), (int)vertices.size() / 2);
+		vertices.clear();
+		lastCalls++;
+	}
+	lastDraws = draws;
+	draws = 0;
+	last = -1;
+}
@@ -0,0 +1,79 @@
+/***********************************************************************
+ * Header File:
+ *    Draw Buffer : draws that are kept and sent out together
+ * Summary:
+ *    Each dot, line or outline used to be its own glBegin/glEnd with its
+ *    own color. Here every draw is put in a bucket by what it needs set
+ *    (the layer, points or lines, and the color) and all of a bucket's
+ *    vertices are sent out in one call when the buffer is flushed, so
+ *    every red bullet on the screen is one call.
+ *
+ *    Buckets are sent out in order of layer, so something on a higher
+ *    layer is drawn over a lower one. Within a layer the order draws go
+ *    out in is not kept. Outlines are kept as separate lines so that
+ *    every outline of a color can go out together.
+ *
+ *    The buckets and their memory are kept from one flush to the next.
+ ************************************************************************/
+#ifndef DRAW_BUFFER_H
+#define DRAW_BUFFER_H
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+//What a bucket is drawn as
+constexpr int DRAW_POINTS = 0;
+constexpr int DRAW_LINES = 1;
+
+//Gets each bucket when it is flushed: what it is drawn as, its color
+//(red, green, blue, 0 - 255), and count x, y pairs
+using DrawSubmit = void (*)(int primitive, const unsigned char * color,
+                            const float * vertices, int count);
+
+class DrawBuffer
+{
+public:
+	DrawBuffer();
+
+	//What layer the draws after this go on (0 - 255)
+	void setLayer(int layer_) { layer = layer_; }
+	int getLayer() const { return layer; }
+
+	/******************************************
+	 * ADD
+	 * Make room for count vertices of the given kind and color and hand
+	 * back where to write their x, y pairs. It is only good until the
+	 * next add.
+	 ******************************************/
+	float * add(int primitive, float red, float green, float blue, int count);
+
+	//Send every bucket out, lowest layer first, and empty them
+	void flush(DrawSubmit submit);
+
+	//Move everything in other into this one, other is left empty
+	void append(DrawBuffer & other);
+
+	//How many draws went in, and how many calls they went out in, at the last flush
+	int getDraws() const { return lastDraws; }
+	int getCalls() const { return lastCalls; }
+
+private:
+	int bucketFor(std::uint64_t key);
+
+	struct Bucket
+	{
+		std::uint64_t key;            // layer, then kind, then color
+		std::vector<float> vertices;
+	};
+
+	int layer;
+	int draws;
+	int lastDraws;
+	int lastCalls;
+	int last;                                        // the bucket added to last
+	std::vector<Bucket> buckets;                     // sorted by key at each flush
+	std::unordered_map<std::uint64_t, int> indexes;  // where each key's bucket is
+};
+
+#endif // DRAW_BUFFER_H
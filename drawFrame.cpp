@@ -0,0 +1,85 @@
+/*********************************************************************
+ * File: drawFrame.cpp
+ * Description: Contains the implementaiton of the draw frame class
+ *  methods.
+ *********************************************************************/
+#include "drawFrame.h"
+
+DrawFrame::DrawFrame()
+	: textCount(0)
+{
+}
+
+void DrawFrame::clear()
+{
+	steps.clear();
+	vertices.clear();
+	colors.clear();
+	textCount = 0;
+}
+
+DrawFrame::Step & DrawFrame::addStep(int kind)
+{
+	steps.push_back(Step());
+	Step & step = steps.back();
+	step.kind = kind;
+	step.primitive = 0;
+	step.color[0] = step.color[1] = step.color[2] = 255;
+	step.first = 0;
+	step.firstColor = 0;
+	step.count = 0;
+	step.x = 0;
+	step.y = 0;
+	step.font = NULL;
+	return step;
+}
+
+void DrawFrame::addCall(int primitive, const unsigned char * color, const float * vertices_, int count)
+{
+	Step & step = addStep(FRAME_CALL);
+	step.primitive = primitive;
+	step.color[0] = color[0];
+	step.color[1] = color[1];
+	step.color[2] = color[2];
+	step.first = (int)vertices.size() / 2;
+	step.count = count;
+	vertices.insert(vertices.end(), vertices_, vertices_ + 2 * count);
+}
+
+void DrawFrame::addPoints(const float * vertices_, const unsigned char * colors_, int count)
+{
+	Step & step = addStep(FRAME_POINTS);
+	step.first = (int)vertices.size() / 2;
+	step.count = count;
+	vertices.insert(vertices.end(), vertices_, vertices_ + 2 * count);
+	step.firstColor = (int)colors.size() / 3;
+	colors.insert(colors.end(), colors_, colors_ + 3 * count);
+}
+
+void DrawFrame::addText(void * font, float x, float y, const unsigned char * color, const std::string & text)
+{
+	Step & step = addStep(FRAME_TEXT);
+	step.font = font;
+	step.x = x;
+	step.y = y;
+	step.color[0] = color[0];
+	step.color[1] = color[1];
+	step.color[2] = color[2];
+	step.first = textCount++;
+	if ((int)texts.size() < textCount)
+		texts.push_back(text);
+	else
+		texts[step.first] = text;
+}
+
+void DrawFrame::addCamera(float x, float y)
+{
+	Step & step = addStep(FRAME_CAMERA);
+	step.x = x;
+	step.y = y;
+}
+
+void DrawFrame::addEndCamera()
+{
+	addStep(FRAME_END_CAMERA);
+}
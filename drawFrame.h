@@ -0,0 +1,69 @@
+/***********************************************************************
+ * Header File:
+ *    Draw Frame : a whole frame, kept so it can be drawn later
+ * Summary:
+ *    Everything a frame draws, in the order it is drawn: the buckets of
+ *    each draw buffer as they are flushed, the moves of the camera, the
+ *    points with their own colors and the text. Nothing in here needs
+ *    OpenGL to be made, so a frame can be made on one thread and drawn
+ *    on the one with the window. See beginFrame() in uiDraw.h.
+ *
+ *    Drawing a frame does not empty it, so the same one can be drawn
+ *    again. The memory is kept from one frame to the next.
+ ************************************************************************/
+#ifndef DRAW_FRAME_H
+#define DRAW_FRAME_H
+
+#include <vector>
+#include <string>
+
+//What each step of a frame does
+constexpr int FRAME_CALL = 0;         // a bucket of lines or points in one color
+constexpr int FRAME_POINTS = 1;       // points that each have their own color
+constexpr int FRAME_TEXT = 2;         // a string in a bitmap font
+constexpr int FRAME_CAMERA = 3;       // move everything after so x, y is in the middle
+constexpr int FRAME_END_CAMERA = 4;   // stop moving things
+
+class DrawFrame
+{
+public:
+	struct Step
+	{
+		int kind;
+		int primitive;              // DRAW_POINTS or DRAW_LINES for a call
+		unsigned char color[3];     // for a call or text
+		int first;                  // the first vertex, or which text
+		int firstColor;             // the first color of a points step
+		int count;                  // how many vertices
+		float x;                    // where the text or camera is
+		float y;
+		void * font;
+	};
+
+	DrawFrame();
+
+	//Take everything out, to start the next frame
+	void clear();
+
+	void addCall(int primitive, const unsigned char * color, const float * vertices, int count);
+	void addPoints(const float * vertices, const unsigned char * colors, int count);
+	void addText(void * font, float x, float y, const unsigned char * color, const std::string & text);
+	void addCamera(float x, float y);
+	void addEndCamera();
+
+	const std::vector<Step> & getSteps() const { return steps; }
+	const float * getVertices(const Step & step) const { return &vertices[2 * step.first]; }
+	const unsigned char * getColors(const Step & step) const { return &colors[3 * step.firstColor]; }
+	const std::string & getText(const Step & step) const { return texts[step.first]; }
+
+private:
+	Step & addStep(int kind);
+
+	std::vector<Step> steps;
+	std::vector<float> vertices;        // x, y pairs for every call and points step
+	std::vector<unsigned char> colors;  // red, green, blue for each point of a points step
+	std::vector<std::string> texts;
+	int textCount;                      // texts in use, the rest are kept for their memory
+};
+
+#endif // DRAW_FRAME_H
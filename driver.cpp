@@ -12,6 +12,15 @@
  ******************************************************/
 #include "game.h"
 #include "uiInteract.h"
+#include "benchmark.h"
+#include "kernelCheck.h"
+#include "gravity.h"
+#include "stress.h"
+#include "frameCapture.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
 
 //Added this global veriable to easy change screen size
 constexpr int SIZE_OF_SCREEN = 400;
@@ -43,6 +52,160 @@ int main(int argc, char ** argv)
 	Point topLeft(-(SIZE_OF_SCREEN), SIZE_OF_SCREEN);      //adjusted size from -200, 200 to -400, 400
 	Point bottomRight(SIZE_OF_SCREEN, -(SIZE_OF_SCREEN));
 
+	// The stress test can run with or without a window
+	bool stress = false;
+	bool headless = false;
+	StressTargets targets = { STRESS_ROCKS, STRESS_BULLETS, STRESS_STARS };
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+			headless = true;
+		else if (strcmp(argv[i], "--big-world") == 0)
+			Interface::setBigWorld(true);
+		else if (strcmp(argv[i], "--pipeline") == 0)
+			Interface::setPipelined(true);
+		else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+		{
+			const char * fileName = argv[++i];
+			int scale = 1;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				scale = atoi(argv[++i]);
+			if (!FrameCapture::isGoodName(fileName))
+			{
+				std::cerr << "Cannot record to " << fileName << ": a pattern needs exactly one %d\n";
+				return 1;
+			}
+			Interface::setCapture(fileName, scale > 0 ? scale : 1);
+		}
+		else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc)
+		{
+			const char * fileName = argv[++i];
+			int ticks = SNAPSHOT_TICKS;
+			int rocks = SNAPSHOT_ROCKS;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				ticks = atoi(argv[++i]);
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				rocks = atoi(argv[++i]);
+			if (!FrameCapture::isGoodName(fileName))
+			{
+				std::cerr << "Cannot record to " << fileName << ": a pattern needs exactly one %d\n";
+				return 1;
+			}
+			if (!runSnapshot(fileName, ticks, rocks, topLeft, bottomRight))
+			{
+				std::cerr << "Could not write " << fileName << "\n";
+				return 1;
+			}
+			return 0;
+		}
+		else if (strcmp(argv[i], "--stress") == 0)
+		{
+			stress = true;
+			int * counts[] = { &targets.rocks, &targets.bullets, &targets.stars };
+			for (int j = 0; j < 3 && i + 1 < argc && argv[i + 1][0] != '-'; j++)
+				*counts[j] = atoi(argv[++i]);
+		}
+	}
+	if (stress && headless)
+	{
+		runStress(std::cout, targets, topLeft, bottomRight);
+		return 0;
+	}
+	else if (stress)
+	{
+		Interface ui(argc, argv, "Asteroids - stress test", topLeft, bottomRight);
+		Game game(topLeft, bottomRight);
+		StressTest test(game, targets, true);
+		ui.setStress(true);
+		ui.run(stressCallBack, &test);
+		return 0;
+	}
+
+	// Benchmarks run without a window and then quit
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--bench-bounce") == 0)
+		{
+			benchmarkBounce(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-batches") == 0)
+		{
+			benchmarkBatches(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-capture") == 0)
+		{
+			benchmarkCapture(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-beam") == 0)
+		{
+			benchmarkBeam(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-missiles") == 0)
+		{
+			benchmarkMissiles(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-shockwave") == 0)
+		{
+			benchmarkShockWave(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-saucers") == 0)
+		{
+			benchmarkSaucers(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-kinetic") == 0)
+		{
+			benchmarkKinetic(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-pacer") == 0)
+		{
+			benchmarkPacer(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-raster") == 0)
+		{
+			benchmarkRaster(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-trig") == 0)
+		{
+			return benchmarkTrig(std::cout) ? 0 : 1;
+		}
+		else if (strcmp(argv[i], "--bench-threats") == 0)
+		{
+			benchmarkThreats(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-outlines") == 0)
+		{
+			benchmarkOutlines(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-particles") == 0)
+		{
+			benchmarkParticles(std::cout);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--bench-gravity") == 0)
+		{
+			float theta = (i + 1 < argc) ? (float)atof(argv[i + 1]) : 0.0f;
+			benchmarkGravity(std::cout, theta > 0.0f ? theta : GRAVITY_THETA);
+			return 0;
+		}
+		else if (strcmp(argv[i], "--verify-kernels") == 0)
+		{
+			int scenes = (i + 1 < argc) ? atoi(argv[i + 1]) : 1000;
+			return verifyKernels(std::cout, 1, scenes > 0 ? scenes : 1000) == 0 ? 0 : 1;
+		}
+	}
+
    Interface ui(argc, argv, "Asteroids", topLeft, bottomRight);
    Game game(topLeft, bottomRight);
    ui.run(callBack, &game);
@@ -0,0 +1,165 @@
+/*********************************************************************
+ * File: flock.cpp
+ * Description: Contains the implementaiton of the flock class
+ *  methods.
+ *********************************************************************/
+#include "flock.h"
+#include "parallel.h"
+#include "uiInteract.h"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+void Flock::steer(std::vector<Saucer> & saucers, const SpatialGrid & rocks, const Point & ship,
+                  bool chase, bool parallel)
+{
+	grid.clear();
+	for (int i = 0; i < (int)saucers.size(); i++)
+	{
+		if (saucers[i].isAlive())
+			grid.insert(i, saucers[i].getPoint(), (float)saucers[i].getRadius());
+	}
+	grid.build();
+
+	next.resize(saucers.size());
+	auto work = [this, &saucers, &rocks, &ship, chase](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			if (saucers[i].isAlive())
+				next[i] = steerOne(saucers, i, rocks, ship, chase);
+		}
+	};
+	if (parallel)
+		parallelFor((int)saucers.size(), FLOCK_MIN_CHUNK, work);
+	else
+		work(0, (int)saucers.size());
+
+	// nobody is reading the old speeds any more
+	for (int i = 0; i < (int)saucers.size(); i++)
+	{
+		if (saucers[i].isAlive())
+			saucers[i].setVelocity(next[i]);
+	}
+}
+
+Velocity Flock::steerOne(const std::vector<Saucer> & saucers, int me, const SpatialGrid & rocks,
+                         const Point & ship, bool chase) const
+{
+	const float topSpeed = SAUCER_SPEED / FRAMES_VARIABLES_MULTIPLIER;
+	float x = saucers[me].getPoint().getX();
+	float y = saucers[me].getPoint().getY();
+	float dx = saucers[me].getVelocity().getDx();
+	float dy = saucers[me].getVelocity().getDy();
+
+	// the nearest flock mates it can see, kept in a heap with the
+	// farthest on top so a nearer one can take its place
+	std::pair<float, const GridEntry *> nearest[FLOCK_NEIGHBORS];
+	auto nearer = [](const std::pair<float, const GridEntry *> & a,
+	                 const std::pair<float, const GridEntry *> & b) { return a.first < b.first; };
+	int seen = 0;
+	grid.query(x - FLOCK_SIGHT, y - FLOCK_SIGHT, x + FLOCK_SIGHT, y + FLOCK_SIGHT,
+	           [&](const GridEntry & other)
+	{
+		if (other.id == me)
+			return;
+		float toX = x - other.x;
+		float toY = y - other.y;
+		float distance = toX * toX + toY * toY;
+		if (distance > FLOCK_SIGHT * FLOCK_SIGHT)
+			return;
+		if (seen == FLOCK_NEIGHBORS)
+		{
+			if (distance >= nearest[0].first)
+				return;
+			std::pop_heap(nearest, nearest + seen--, nearer);
+		}
+		nearest[seen++] = std::make_pair(distance, &other);
+		std::push_heap(nearest, nearest + seen, nearer);
+	});
+
+	float apartX = 0, apartY = 0;
+	float headingX = 0, headingY = 0;
+	float middleX = 0, middleY = 0;
+	for (int i = 0; i < seen; i++)
+	{
+		const GridEntry & other = *nearest[i].second;
+		float toX = x - other.x;
+		float toY = y - other.y;
+		float distance = std::sqrt(nearest[i].first);
+		if (distance < FLOCK_SPACE && distance > 0.0f)
+		{
+			float push = (FLOCK_SPACE - distance) / (FLOCK_SPACE * distance);
+			apartX += toX * push;
+			apartY += toY * push;
+		}
+		headingX += saucers[other.id].getVelocity().getDx();
+		headingY += saucers[other.id].getVelocity().getDy();
+		middleX += other.x;
+		middleY += other.y;
+	}
+
+	float pushX = FLOCK_SEPARATION * apartX;
+	float pushY = FLOCK_SEPARATION * apartY;
+	float turnX = 0, turnY = 0;
+	if (seen > 0)
+	{
+		pushX += FLOCK_COHESION * (middleX / seen - x) / FLOCK_SIGHT;
+		pushY += FLOCK_COHESION * (middleY / seen - y) / FLOCK_SIGHT;
+		turnX = FLOCK_ALIGNMENT * (headingX / seen - dx);
+		turnY = FLOCK_ALIGNMENT * (headingY / seen - dy);
+	}
+
+	// keep away from the rocks, harder the closer it is. A rock counts
+	// while its edge is within FLOCK_ROCK_SPACE of the saucer's, so the
+	// box reaches that far past the saucer, and query() widens it again
+	// by the biggest rock in the grid.
+	float reach = FLOCK_ROCK_SPACE + SAUCER_SIZE;
+	rocks.query(x - reach, y - reach, x + reach, y + reach, [&](const GridEntry & rock)
+	{
+		float toX = x - rock.x;
+		float toY = y - rock.y;
+		float distance = std::sqrt(toX * toX + toY * toY);
+		float gap = distance - rock.radius - SAUCER_SIZE;
+		if (gap < FLOCK_ROCK_SPACE && distance > 0.0f)
+		{
+			float push = FLOCK_AVOID * (FLOCK_ROCK_SPACE - std::max(gap, 0.0f)) / (FLOCK_ROCK_SPACE * distance);
+			pushX += toX * push;
+			pushY += toY * push;
+		}
+	});
+
+	if (chase)
+	{
+		float toX = ship.getX() - x;
+		float toY = ship.getY() - y;
+		float distance = std::sqrt(toX * toX + toY * toY);
+		if (distance > 0.0f)
+		{
+			pushX += FLOCK_CHASE * toX / distance;
+			pushY += FLOCK_CHASE * toY / distance;
+		}
+	}
+
+	// the pushes are in parts of top speed, the turn is already a speed
+	float changeX = pushX * topSpeed + turnX;
+	float changeY = pushY * topSpeed + turnY;
+	float change = std::sqrt(changeX * changeX + changeY * changeY);
+	float mostChange = FLOCK_TURN * topSpeed;
+	if (change > mostChange)
+	{
+		changeX *= mostChange / change;
+		changeY *= mostChange / change;
+	}
+	dx += changeX;
+	dy += changeY;
+
+	float speed = std::sqrt(dx * dx + dy * dy);
+	if (speed > topSpeed)
+	{
+		dx *= topSpeed / speed;
+		dy *= topSpeed / speed;
+	}
+	return Velocity(dx, dy);
+}
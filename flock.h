@@ -0,0 +1,74 @@
+/***********************************************************************
+ * Header File:
+ *    Flock : steers every saucer at once
+ * Summary:
+ *    Each saucer keeps clear of the saucers right next to it
+ *    (separation), turns to fly the same way as the ones it can see
+ *    (alignment), drifts toward the middle of them (cohesion), keeps away
+ *    from rocks and heads for the ship. The saucers are put in a spatial
+ *    grid once a tick and every saucer asks it for its neighbors, so it
+ *    never looks at every pair. The saucers are steered on every core at
+ *    once; each one only reads the others and writes its own new speed.
+ ************************************************************************/
+#ifndef FLOCK_H
+#define FLOCK_H
+
+#include "saucer.h"
+#include "spatialGrid.h"
+#include "velocity.h"
+#include "point.h"
+
+#include <vector>
+
+//How far a saucer can see the rest of its flock
+constexpr float FLOCK_SIGHT = 50.0;
+
+//Saucers closer than this push each other apart
+constexpr float FLOCK_SPACE = 20.0;
+
+//The most flock mates a saucer pays attention to (the nearest ones), so a
+//crowd costs no more
+constexpr int FLOCK_NEIGHBORS = 12;
+
+//How far past the edge of a rock saucers try to stay
+constexpr float FLOCK_ROCK_SPACE = 30.0;
+
+//How much each urge counts
+constexpr float FLOCK_SEPARATION = 1.5;
+constexpr float FLOCK_ALIGNMENT = 0.1;
+constexpr float FLOCK_COHESION = 0.5;
+constexpr float FLOCK_AVOID = 2.5;
+constexpr float FLOCK_CHASE = 0.3;
+
+//The most a saucer can change its speed in a tick, as a part of its top speed
+constexpr float FLOCK_TURN = 0.15;
+
+//Each thread gets at least this many saucers
+constexpr int FLOCK_MIN_CHUNK = 256;
+
+class Flock
+{
+public:
+	Flock() : grid(FLOCK_SIGHT) {   }
+
+	/******************************************
+	 * STEER
+	 * Give every saucer its new speed from where the others (as they
+	 * are now), the rocks in rocks and the ship are. Set parallel to
+	 * false to do it all on this thread.
+	 ******************************************/
+	void steer(std::vector<Saucer> & saucers, const SpatialGrid & rocks, const Point & ship,
+	           bool chase, bool parallel = true);
+
+	//The saucers where they were at the last steer(), id is their place in the list
+	const SpatialGrid & getGrid() const { return grid; }
+
+private:
+	Velocity steerOne(const std::vector<Saucer> & saucers, int me, const SpatialGrid & rocks,
+	                  const Point & ship, bool chase) const;
+
+	SpatialGrid grid;
+	std::vector<Velocity> next;  // the new speeds, kept so they are not allocated every tick
+};
+
+#endif // FLOCK_H
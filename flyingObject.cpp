@@ -5,6 +5,8 @@
  *********************************************************************/
 #include "flyingObject.h"
 
+unsigned int FlyingObject::currentTick = 0;
+
 //Move the object along
 void FlyingObject::advance()
 {
@@ -12,6 +14,12 @@ void FlyingObject::advance()
 	point.addY(speed.getDy());
 }
 
+void FlyingObject::catchUp(int ticks)
+{
+	for (int i = 0; i < ticks && alive; i++)
+		advance();
+}
+
 //If off screen have move to the otherside with same velocity and direction
 void FlyingObject::flipSide(const bool & isY, const bool & isX)
 {
@@ -23,8 +23,16 @@ protected:
 	Point point;
 	//How fast is it going?
 	Velocity speed;
+	//The tick point was right on. Something that is not moved every tick
+	//is where its line from there says (see getCurrentPoint), so falling
+	//further behind writes nothing.
+	unsigned int since;
+	//How many ticks the game has moved everything along
+	static unsigned int currentTick;
+	//Which body it is in the game's kinetic collisions, or -1 (see kinetic.h)
+	int kineticId;
 public:
-	FlyingObject() : point(Point()), speed(Velocity()), alive(true) {  }
+	FlyingObject() : alive(true), point(Point()), speed(Velocity()), since(currentTick), kineticId(-1) {  }
 	//virtual destructor for child classes.
 	virtual ~FlyingObject() { };
 	Point getPoint() const
@@ -40,10 +48,12 @@ public:
 	void setPoint(const Point & point_)
 	{
 		point = point_;
+		since = currentTick;
 	}
 
 	void setVelocity(const Velocity & speed_)
 	{
+		rebase();
 		speed = speed_;
 	}
 
@@ -52,6 +62,14 @@ public:
 		return speed;
 	}
 
+	//Speed up in some direction (used by gravity)
+	void accelerate(const Velocity & pull)
+	{
+		rebase();
+		speed.setDx(speed.getDx() + pull.getDx());
+		speed.setDy(speed.getDy() + pull.getDy());
+	}
+
 	void kill()
 	{
 		alive = false;
@@ -62,7 +80,33 @@ public:
 
 	//Virtual for those objects that move differently
 	virtual void advance();
+
+	//Move along several ticks at once. Override when it can be done in one step.
+	virtual void catchUp(int ticks);
+
+	int getLag() const { return (int)(currentTick - since); }
+	void setLag(int ticks) { since = currentTick - ticks; }
+
+	//Where it really is this tick. Most things are moved every tick, so
+	//that is their point. Override for those that are left behind.
+	virtual Point getCurrentPoint() const { return point; }
+
+	//Call once a tick before anything is moved
+	static void nextTick() { currentTick++; }
+	static unsigned int getTick() { return currentTick; }
+
+	int getKineticId() const { return kineticId; }
+	void setKineticId(int id) { kineticId = id; }
+
 	void flipSide(const bool & isY, const bool & isX);
+
+protected:
+	//Start its line over from where it is now, before its speed changes
+	void rebase()
+	{
+		point = getCurrentPoint();
+		since = currentTick;
+	}
 };
 
 #endif  // !FLYING_OBJECT_H
\ No newline at end of file
@@ -0,0 +1,361 @@
+/*********************************************************************
+ * File: frameCapture.cpp
+ * Description: Contains the implementaiton of the frame capture class
+ *  methods.
+ *********************************************************************/
+#include "frameCapture.h"
+
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef __APPLE__
+#include <openGL/gl.h>    // Main OpenGL library, which has pixel buffer objects
+#define CAPTURE_PIXEL_BUFFERS
+#endif // __APPLE__
+
+#ifdef __linux__
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>    // Main OpenGL library
+#include <GL/glext.h> // pixel buffer objects
+#define CAPTURE_PIXEL_BUFFERS
+#endif // __linux__
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Gl/glut.h>           // OpenGL library we copied, only 1.1
+#endif // _WIN32
+
+FrameCapture::FrameCapture(const char * fileName, int width, int height, int scale, int framesPerSecond)
+	: width(width), height(height), scale(scale < 1 ? 1 : scale), open(false), file(NULL),
+	  stopping(false), useReadbacks(false), frames(0),
+	  written(0), dropped(0), calls(0), totalTime(0), worstTime(0)
+{
+	y4m = (strchr(fileName, '%') == NULL);
+	outWidth = width / this->scale;
+	outHeight = height / this->scale;
+
+	// the colors are half as wide and high as the picture in the stream
+	if (y4m)
+	{
+		outWidth &= ~1;
+		outHeight &= ~1;
+	}
+	if (outWidth < 2 || outHeight < 2 || strlen(fileName) >= sizeof(pattern) || !isGoodName(fileName))
+		return;
+	strcpy(pattern, fileName);
+
+	if (y4m)
+	{
+		file = fopen(fileName, "wb");
+		if (!file)
+			return;
+		fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", outWidth, outHeight, framesPerSecond);
+	}
+
+	for (int i = 0; i < CAPTURE_QUEUE; i++)
+	{
+		buffers.push_back(std::vector<unsigned char>(4 * width * height));
+		flipped.push_back(false);
+		spare.push_back(i);
+	}
+	open = true;
+	writer = std::thread(&FrameCapture::write, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+	finish(false);
+}
+
+/******************************************
+ * IS GOOD NAME
+ * The pattern is handed to snprintf() with the frame number, so it has
+ * to take one int and nothing else.
+ ******************************************/
+bool FrameCapture::isGoodName(const char * fileName)
+{
+	const char * percent = strchr(fileName, '%');
+	if (percent == NULL)
+		return true;
+	if (strchr(percent + 1, '%') != NULL)
+		return false;
+
+	const char * at = percent + 1 + strspn(percent + 1, "-+ 0#");
+	at += strspn(at, "0123456789");
+	if (*at == '.')
+		at += 1 + strspn(at + 1, "0123456789");
+	return *at == 'd' || *at == 'i';
+}
+
+/******************************************
+ * ADD
+ * Only copies. The writer does the rest.
+ ******************************************/
+bool FrameCapture::add(const unsigned char * pixels, bool bottomFirst)
+{
+	auto start = std::chrono::steady_clock::now();
+	bool added = addFrame(pixels, bottomFirst);
+	countTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	return added;
+}
+
+bool FrameCapture::addFrame(const unsigned char * pixels, bool bottomFirst, bool wait)
+{
+	int buffer;
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		if (wait)
+			freed.wait(guard, [this] { return !open || stopping || !spare.empty(); });
+		if (!open || stopping || spare.empty())
+		{
+			dropped += open && !stopping;
+			return false;
+		}
+		buffer = spare.back();
+		spare.pop_back();
+	}
+
+	memcpy(buffers[buffer].data(), pixels, buffers[buffer].size());
+
+	std::lock_guard<std::mutex> guard(lock);
+	flipped[buffer] = bottomFirst;
+	waiting.push_back(buffer);
+	ready.notify_one();
+	return true;
+}
+
+/******************************************
+ * READ WINDOW
+ * The newest frame is read into the next pixel buffer object, which is
+ * also the oldest one, so what is in it is added first.
+ ******************************************/
+void FrameCapture::readWindow()
+{
+	if (!open)
+		return;
+	auto start = std::chrono::steady_clock::now();
+
+#ifdef CAPTURE_PIXEL_BUFFERS
+	// pixel buffer objects came in with OpenGL 2.1
+	if (frames == 0)
+	{
+		const char * version = (const char *)glGetString(GL_VERSION);
+		useReadbacks = version && atof(version) >= 2.1 - 0.001;
+		if (useReadbacks)
+		{
+			glGenBuffers(CAPTURE_READBACKS, readbacks);
+			for (int i = 0; i < CAPTURE_READBACKS; i++)
+			{
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readbacks[i]);
+				glBufferData(GL_PIXEL_PACK_BUFFER, 4 * width * height, NULL, GL_STREAM_READ);
+			}
+		}
+	}
+
+	if (useReadbacks)
+	{
+		int slot = frames % CAPTURE_READBACKS;
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readbacks[slot]);
+		if (frames >= CAPTURE_READBACKS)
+		{
+			const unsigned char * pixels = (const unsigned char *)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+			if (pixels)
+				addFrame(pixels, true);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		glReadBuffer(GL_BACK);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		frames++;
+		countTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		return;
+	}
+#endif // CAPTURE_PIXEL_BUFFERS
+
+	frames++;
+	direct.resize(4 * width * height);
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, direct.data());
+	addFrame(direct.data(), true);
+	countTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void FrameCapture::finish(bool windowOpen)
+{
+	if (windowOpen)
+		readRemaining();
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+		ready.notify_one();
+	}
+	if (writer.joinable())
+		writer.join();
+}
+
+/******************************************
+ * READ REMAINING
+ * The last CAPTURE_READBACKS frames read are still in their pixel buffer
+ * objects, oldest first from the slot after the newest. Nothing else is
+ * coming, so these wait for a spare buffer instead of being dropped.
+ ******************************************/
+void FrameCapture::readRemaining()
+{
+#ifdef CAPTURE_PIXEL_BUFFERS
+	if (!open || !useReadbacks)
+		return;
+	int first = frames > CAPTURE_READBACKS ? frames - CAPTURE_READBACKS : 0;
+	for (int frame = first; frame < frames; frame++)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readbacks[frame % CAPTURE_READBACKS]);
+		const unsigned char * pixels = (const unsigned char *)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+		if (pixels)
+			addFrame(pixels, true, true);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glDeleteBuffers(CAPTURE_READBACKS, readbacks);
+	useReadbacks = false;
+#endif // CAPTURE_PIXEL_BUFFERS
+}
+
+void FrameCapture::report() const
+{
+	if (!open)
+		return;
+	printf("Capture: %d frames written, %d dropped, %.3f ms a frame on the drawing thread (%.3f ms at worst)\n",
+	       written, dropped, getMeanTime() * 1000, worstTime * 1000);
+}
+
+void FrameCapture::countTime(double seconds)
+{
+	calls++;
+	totalTime += seconds;
+	if (seconds > worstTime)
+		worstTime = seconds;
+}
+
+/******************************************
+ * WRITE
+ * The writer thread. A buffer goes back as soon as it has been shrunk,
+ * before the slow part, and what is waiting is written before it stops.
+ ******************************************/
+void FrameCapture::write()
+{
+	for (;;)
+	{
+		int buffer;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			ready.wait(guard, [this] { return stopping || !waiting.empty(); });
+			if (waiting.empty())
+				break;
+			buffer = waiting.front();
+			waiting.erase(waiting.begin());
+		}
+
+		shrink(buffers[buffer].data(), flipped[buffer]);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			spare.push_back(buffer);
+			freed.notify_one();
+		}
+
+		if (writeFrame())
+			written++;
+	}
+
+	if (file)
+		fclose(file);
+	file = NULL;
+}
+
+/******************************************
+ * SHRINK
+ * Into rgb, the top row first, each pixel the average of the scale by
+ * scale square of pixels it covers
+ ******************************************/
+void FrameCapture::shrink(const unsigned char * pixels, bool bottomFirst)
+{
+	rgb.resize(3 * outWidth * outHeight);
+	int area = scale * scale;
+	for (int y = 0; y < outHeight; y++)
+	{
+		unsigned char * out = &rgb[3 * y * outWidth];
+		for (int x = 0; x < outWidth; x++)
+		{
+			int sum[3] = { 0, 0, 0 };
+			for (int dy = 0; dy < scale; dy++)
+			{
+				int row = y * scale + dy;
+				if (bottomFirst)
+					row = height - 1 - row;
+				const unsigned char * in = &pixels[4 * (row * width + x * scale)];
+				for (int dx = 0; dx < scale; dx++, in += 4)
+				{
+					sum[0] += in[0];
+					sum[1] += in[1];
+					sum[2] += in[2];
+				}
+			}
+			out[3 * x] = sum[0] / area;
+			out[3 * x + 1] = sum[1] / area;
+			out[3 * x + 2] = sum[2] / area;
+		}
+	}
+}
+
+/******************************************
+ * WRITE FRAME
+ * rgb as the next PPM, or as the next frame of the stream: brightness
+ * for every pixel, then the two colors for every two by two square
+ * (full range, like a JPEG)
+ ******************************************/
+bool FrameCapture::writeFrame()
+{
+	if (!y4m)
+	{
+		char fileName[sizeof(pattern) + 32];
+		snprintf(fileName, sizeof(fileName), pattern, written);
+		FILE * picture = fopen(fileName, "wb");
+		if (!picture)
+			return false;
+		fprintf(picture, "P6\n%d %d\n255\n", outWidth, outHeight);
+		fwrite(rgb.data(), 1, rgb.size(), picture);
+		return fclose(picture) == 0;
+	}
+
+	int pixelCount = outWidth * outHeight;
+	yuv.resize(pixelCount + pixelCount / 2);
+	unsigned char * u = &yuv[pixelCount];
+	unsigned char * v = u + pixelCount / 4;
+	for (int i = 0; i < pixelCount; i++)
+	{
+		const unsigned char * p = &rgb[3 * i];
+		yuv[i] = (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8;
+	}
+	for (int y = 0; y < outHeight; y += 2)
+		for (int x = 0; x < outWidth; x += 2)
+		{
+			int r = 0, g = 0, b = 0;
+			for (int dy = 0; dy < 2; dy++)
+				for (int dx = 0; dx < 2; dx++)
+				{
+					const unsigned char * p = &rgb[3 * ((y + dy) * outWidth + x + dx)];
+					r += p[0];
+					g += p[1];
+					b += p[2];
+				}
+			int cb = (-43 * r - 85 * g + 128 * b + 4 * 32896) >> 10;
+			int cr = (128 * r - 107 * g - 21 * b + 4 * 32896) >> 10;
+			int at = (y / 2) * (outWidth / 2) + x / 2;
+			u[at] = cb > 255 ? 255 : cb;
+			v[at] = cr > 255 ? 255 : cr;
+		}
+
+	fputs("FRAME\n", file);
+	return fwrite(yuv.data(), 1, yuv.size(), file) == yuv.size();
+}
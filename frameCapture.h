@@ -0,0 +1,123 @@
+/***********************************************************************
+ * Header File:
+ *    Frame Capture : records the frames drawn to a video file
+ * Summary:
+ *    Every frame is copied into one of CAPTURE_QUEUE buffers, and a
+ *    writer thread of its own turns them into the file, shrinking them
+ *    first if asked. The thread drawing the frames only ever copies: if
+ *    the disk falls behind and every buffer is still waiting to be
+ *    written, the frame is dropped and counted rather than waited for.
+ *
+ *    A name with a % in it is a printf() pattern for a PPM picture of
+ *    each frame (shot%05d.ppm). Anything else is one raw YUV4MPEG2
+ *    (.y4m) stream, which ffmpeg and most players read as is.
+ *
+ *    In the window, readWindow() reads the frame into one of
+ *    CAPTURE_READBACKS pixel buffer objects, which the graphics card
+ *    fills while the game goes on, and adds the one read that many
+ *    frames before, which is done by then. So there is no waiting on the
+ *    graphics card either.
+ ************************************************************************/
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+
+//How many frames can be waiting for the writer before they are dropped
+constexpr int CAPTURE_QUEUE = 8;
+
+//How many frames the graphics card can be reading back at once
+constexpr int CAPTURE_READBACKS = 3;
+
+class FrameCapture
+{
+public:
+	//Frames are width by height pixels, and are written scale times
+	//smaller across and down. Check isOpen() after.
+	FrameCapture(const char * fileName, int width, int height, int scale, int framesPerSecond);
+	~FrameCapture();
+
+	bool isOpen() const { return open; }
+
+	//Whether a name is one this can record to: no % at all, or exactly
+	//one integer conversion (%d or %i, with flags and a width) and no
+	//other %. Anything else would be an unsafe printf() pattern.
+	static bool isGoodName(const char * fileName);
+
+	//Copy a frame of red, green, blue and alpha pixels to be written.
+	//OpenGL gives the bottom row first. Returns false if it was dropped.
+	bool add(const unsigned char * pixels, bool bottomFirst);
+
+	//Read the window's back buffer (call before it is swapped)
+	void readWindow();
+
+	//Add the frames the graphics card is still reading back, write what
+	//is waiting, close the file and stop the writer. The frames being
+	//read back need the window's OpenGL context, so this is called where
+	//readWindow() is; if the window has already gone they are lost.
+	void finish(bool windowOpen = true);
+
+	//How many frames were written and dropped, and how long add() and
+	//readWindow() took on the thread drawing the frames
+	int getWritten() const { return written; }
+	int getDropped() const { return dropped; }
+	double getMeanTime() const { return calls ? totalTime / calls : 0.0; }
+	double getWorstTime() const { return worstTime; }
+
+	//Print the counts and times
+	void report() const;
+
+private:
+	bool addFrame(const unsigned char * pixels, bool bottomFirst, bool wait = false);
+	void readRemaining();
+	void write();
+	void shrink(const unsigned char * pixels, bool bottomFirst);
+	bool writeFrame();
+	void countTime(double seconds);
+
+	int width;
+	int height;
+	int scale;
+	int outWidth;
+	int outHeight;
+	bool open;
+	bool y4m;
+	char pattern[256];
+	FILE * file;
+
+	// the buffers, which are free, waiting for the writer, or being
+	// filled or written
+	std::vector<std::vector<unsigned char> > buffers;
+	std::vector<char> flipped;           // the buffer's bottom row is first
+	std::vector<int> spare;
+	std::vector<int> waiting;
+	bool stopping;
+	std::mutex lock;
+	std::condition_variable ready;
+	std::condition_variable freed;       // a buffer went back to spare
+	std::thread writer;
+
+	// only the writer touches these
+	std::vector<unsigned char> rgb;
+	std::vector<unsigned char> yuv;
+
+	// the pixel buffer objects, and how many frames have been read. When
+	// there are none (before OpenGL 2.1) the window is read straight into
+	// direct instead, which waits for the graphics card.
+	unsigned int readbacks[CAPTURE_READBACKS];
+	bool useReadbacks;
+	int frames;
+	std::vector<unsigned char> direct;
+
+	int written;
+	int dropped;
+	int calls;
+	double totalTime;
+	double worstTime;
+};
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * File: framePacer.cpp
+ * Description: Contains the implementaiton of the frame pacer class
+ *  methods.
+ *********************************************************************/
+#include "framePacer.h"
+
+#include <thread>
+
+#ifdef __linux__
+#include <time.h>
+#include <cerrno>
+#endif // __linux__
+
+FramePacer::FramePacer()
+	: started(false)
+{
+	clearStats();
+}
+
+void FramePacer::clearStats()
+{
+	for (int i = 0; i < PACER_BUCKETS; i++)
+		histogram[i] = 0;
+	frames = 0;
+	resyncs = 0;
+	worstLate = 0;
+	totalLate = 0;
+}
+
+double FramePacer::getBucketTop(int bucket)
+{
+	if (bucket >= PACER_BUCKETS - 1)
+		return 1e30;
+	return PACER_FIRST_BUCKET * (double)(1 << bucket);
+}
+
+/******************************************
+ * WAIT
+ * The first frame only sets the first deadline.
+ ******************************************/
+double FramePacer::wait(double period)
+{
+	auto step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+	Clock::time_point now = Clock::now();
+	if (!started)
+	{
+		started = true;
+		deadline = now + step;
+		return 0;
+	}
+
+	// a whole frame behind, start over from now rather than catch up
+	if (now > deadline + step)
+	{
+		resyncs++;
+		deadline = now + step;
+		return 0;
+	}
+
+	auto spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(PACER_SPIN));
+	if (deadline - now > spin)
+		sleepUntil(deadline - spin);
+	while ((now = Clock::now()) < deadline)
+		;
+
+	double late = std::chrono::duration<double>(now - deadline).count();
+	int bucket = 0;
+	while (bucket < PACER_BUCKETS - 1 && late >= getBucketTop(bucket))
+		bucket++;
+	histogram[bucket]++;
+	frames++;
+	totalLate += late;
+	if (late > worstLate)
+		worstLate = late;
+
+	deadline += step;
+	return late;
+}
+
+/******************************************
+ * SLEEP UNTIL
+ * steady_clock is CLOCK_MONOTONIC on Linux, so its time can be handed
+ * straight to clock_nanosleep, which sleeps until that time however
+ * many times it is woken early.
+ ******************************************/
+void FramePacer::sleepUntil(Clock::time_point until)
+{
+#ifdef __linux__
+	auto since = until.time_since_epoch();
+	auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since);
+	timespec at;
+	at.tv_sec = (time_t)seconds.count();
+	at.tv_nsec = (long)std::chrono::duration_cast<std::chrono::nanoseconds>(since - seconds).count();
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &at, NULL) == EINTR)
+		;
+#else
+	std::this_thread::sleep_until(until);
+#endif // __linux__
+}
@@ -0,0 +1,68 @@
+/***********************************************************************
+ * Header File:
+ *    Frame Pacer : wait until each frame is due, on time
+ * Summary:
+ *    The frames used to be waited for with a sleep for however long was
+ *    left, and the next one was set from when the sleep ended, so every
+ *    time the sleep ran over the whole game slipped back by that much.
+ *    Here every frame has a deadline one period after the last one's
+ *    deadline, not after when it woke up, so running over does not add
+ *    up. The wait sleeps until PACER_SPIN before the deadline (with
+ *    clock_nanosleep on an absolute time on Linux) and spins the rest,
+ *    since a sleep can wake late but a spin cannot.
+ *
+ *    How late each frame woke up is kept in a histogram the HUD and
+ *    --bench-pacer read. A frame more than a whole period behind (the
+ *    game was slow, or idle) starts the deadlines over from now instead
+ *    of rushing to catch up, and is only counted as a resync.
+ ************************************************************************/
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+//How long before the deadline the sleep ends and the spin starts
+constexpr double PACER_SPIN = 0.0005;
+
+//The histogram buckets. The first is anything under PACER_FIRST_BUCKET
+//late, and each one after is twice as wide, the last is everything after.
+constexpr int PACER_BUCKETS = 10;
+constexpr double PACER_FIRST_BUCKET = 0.000025;
+
+class FramePacer
+{
+public:
+	FramePacer();
+
+	//Wait until the next frame is due, period seconds after the last.
+	//Returns how many seconds late it woke.
+	double wait(double period);
+
+	//Forget the histogram
+	void clearStats();
+
+	//The histogram, and the latest lateness each bucket goes up to
+	int getBucket(int bucket) const { return histogram[bucket]; }
+	static double getBucketTop(int bucket);
+
+	int getFrames() const { return frames; }
+	int getResyncs() const { return resyncs; }
+	double getWorstLate() const { return worstLate; }
+	double getMeanLate() const { return frames ? totalLate / frames : 0.0; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void sleepUntil(Clock::time_point until);
+
+	Clock::time_point deadline;
+	bool started;
+
+	int histogram[PACER_BUCKETS];
+	int frames;
+	int resyncs;
+	double worstLate;
+	double totalLate;
+};
+
+#endif // FRAME_PACER_H
@@ -5,10 +5,18 @@
  *********************************************************************/
 
 #include "game.h"
+#include "physics.h"
+#include "collision.h"
+#include "trig.h"
 
-// These are needed for the getClosestDistance function...
-#include <limits>
-#include <algorithm>
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
 
 
 /******************************************
@@ -32,8 +40,15 @@ bool Game::bonusWeapon = false;
  * GAME CONSTRUCTOR
  ***************************************/
 Game::Game(Point tl, Point br)
-	: topLeft(tl), bottomRight(br)
+	: topLeft(tl), bottomRight(br), world(br.getX() - tl.getX()), bigWorld(false),
+	  worldTopLeft(tl), worldBottomRight(br), camera(0, 0), useDetail(false),
+	  beamOn(false), kineticOn(false), kineticEpoch(0)
 {
+	threats.setWorld(tl, br);
+	Rocks::setWorld(tl, br);
+	shipWatcher = threats.watch(THREAT_DISTANCE, (int)(THREAT_TICKS * FRAMES_VARIABLES_MULTIPLIER));
+	blackHoles.push_back(Point(tl.getX() / 2, tl.getY() / 2));
+	blackHoles.push_back(Point(br.getX() / 2, br.getY() / 2));
 }
 
 /****************************************
@@ -49,6 +64,8 @@ Game :: ~Game()
 	}
 	if (!(bullets.empty()))
 		bullets.clear();
+	if (!(missiles.empty()))
+		missiles.clear();
 
 	if (!(background.empty()))
 		background.clear();
@@ -70,22 +87,84 @@ void Game::advance()
 	* so created ui for static variables in this method to pass down as reference 
 	*/
 	Interface ui;
+	if (ui.isBigWorld() != bigWorld)
+		setBigWorld(ui.isBigWorld());
+
 	if (!ui.isPause())
 	{
+		// the kinetic collisions need everything going in straight lines,
+		// and nothing moving without them (bullets do while the password is up)
+		if (ui.isBounce() || ui.isGravity() || ui.displayPassword())
+			kineticOn = false;
+
+		if (ui.isGravity() && !ui.displayPassword())
+			applyGravity();
 		advanceBackground();
 		advanceBullets();
 		if (!ui.displayPassword())
 		{
+			FlyingObject::nextTick();
+			buildDetail(ui);
 			advanceRocks(ui);
+			// a bounce changes a rock's speed, so its line is no good
+			if (ui.isBounce())
+			{
+				bounced.clear();
+				bounceRocks(asteroids, rockGrid, &bounced);
+				for (int i = 0; i < (int)bounced.size(); i++)
+					threats.update(bounced[i]);
+			}
+		}
+
+		// the missiles, shock wave and saucers share one grid of the rocks
+		// where they are after moving, built once a tick
+		if (!missiles.empty() || shockWave.isOn() || ui.isSaucers())
+			buildRockGrid();
+		advanceMissiles();
+		if (!ui.displayPassword())
+		{
+			advanceShockWave();
+			advanceSaucers(ui);
 			advanceShip();
 			advanceStars(ui);
 			handleCollisions(ui);
 		}
 		cleanUpZombies(ui);
+		particles.advance();
+		if (ui.isClearScreen())
+		{
+			particles.clear();
+			world.clear();
+			shockWave.stop();
+		}
+		if (bigWorld)
+		{
+			// practice stars never move, so they are never put to sleep
+			std::vector<Stars *> noStars;
+			world.stream(asteroids, ui.isPractice() ? noStars : stars, ship.getPoint());
+			camera = world.getCamera(ship.getPoint(), bottomRight.getX(), topLeft.getY());
+			for (int i = 0; i < (int)world.getSleptRocks().size(); i++)
+			{
+				threats.remove(world.getSleptRocks()[i]);
+				dropKinetic(*world.getSleptRocks()[i]);
+			}
+			for (int i = 0; i < (int)world.getWokenRocks().size(); i++)
+			{
+				threats.add(world.getWokenRocks()[i]);
+				addKinetic(world.getWokenRocks()[i]);
+			}
+		}
+
+		// nothing moved while the password was up
+		if (!ui.displayPassword())
+		{
+			threats.tick();
+			threats.follow(shipWatcher, ship.getPoint(), ship.getVelocity(), ship.getRadius());
+		}
 		frameCount++;
 	}
 
-	if (score > highScore && !ui.isPractice())
+	if (score > highScore && !ui.isPractice() && !ui.isStress())
 	{
 		highScore = score;
 		changeHighScore = true;
@@ -111,15 +190,147 @@ void Game::advanceBullets()
 			// this bullet is alive, so tell it to move forward
 			bullets[i].advance();
 
-			if (!isOnScreen(bullets[i].getPoint(), 2))
+			wrapAround(bullets[i], 2, worldTopLeft, worldBottomRight);
+
+		}
+	}
+}
+
+/***************************************
+ * GAME :: ADVANCE MISSILES
+ * Each missile turns toward the nearest rock that not too many other
+ * missiles are already after, then moves. Every missile asks the rock
+ * grid advance() built, rather than each looking at every rock.
+ ***************************************/
+void Game::advanceMissiles()
+{
+	if (missiles.empty())
+		return;
+
+	missileClaims.assign(asteroids.size(), 0);
+	for (int i = 0; i < (int)missiles.size(); i++)
+	{
+		if (missiles[i].isAlive())
+		{
+			rockGrid.nearest(missiles[i].getPoint().getX(), missiles[i].getPoint().getY(),
+			                 1, MISSILE_SIGHT, [this](const GridEntry & rock)
 			{
-				bullets[i].flipSide(abs(bullets[i].getPoint().getY()) >= topLeft.getY(), abs(bullets[i].getPoint().getX()) >= bottomRight.getX());
+				return missileClaims[rock.id] < MISSILE_PER_ROCK;
+			}, missileTarget);
+
+			if (!missileTarget.empty())
+			{
+				missiles[i].steer(Point(missileTarget[0].x, missileTarget[0].y));
+				missileClaims[missileTarget[0].id]++;
 			}
+			missiles[i].advance();
+
+			wrapAround(missiles[i], 2, worldTopLeft, worldBottomRight);
+		}
+	}
+}
+
+/***************************************
+ * GAME :: ADVANCE SHOCK WAVE
+ * Grow the shock wave and split every rock under its front. The pieces
+ * are still under it, so they are split again over the next few ticks.
+ ***************************************/
+void Game::advanceShockWave()
+{
+	if (!shockWave.isOn())
+		return;
+
+	shockWave.advance(rockGrid, waveHits);
+	for (int i = 0; i < (int)waveHits.size(); i++)
+	{
+		Rocks * rock = asteroids[waveHits[i]];
+
+		score += rock->getValue();
+		particles.burst(rock->getCurrentPoint(), rock->getVelocity(), rock->getRadius() * 4, 3.0f,
+		                (int)(25 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_SHOCK);
+		std::vector<Rocks *> pieces = rock->killRocks();
+		for (int piece = 0; piece < (int)pieces.size(); piece++)
+			addRock(pieces[piece]);
+	}
+}
+
+/***************************************
+ * GAME :: ADVANCE SAUCERS
+ * While U is on a new flock of saucers comes in every so often. The whole
+ * flock is steered together, then each saucer moves and, if the ship is
+ * close, shoots at it.
+ ***************************************/
+void Game::advanceSaucers(const Interface & ui)
+{
+	for (int i = 0; i < (int)saucerShots.size(); i++)
+	{
+		if (saucerShots[i].isAlive())
+		{
+			saucerShots[i].advance();
+			wrapAround(saucerShots[i], 2, worldTopLeft, worldBottomRight);
+		}
+	}
+
+	if (!ui.isSaucers() || ui.isMenu())
+	{
+		saucers.clear();
+		return;
+	}
+	if (saucers.size() + SAUCER_FLOCK <= SAUCER_MOST &&
+	    frameCount % (int)(SAUCER_SPAWN_TICKS * FRAMES_VARIABLES_MULTIPLIER) == 0)
+		makeFlock();
 
+	flock.steer(saucers, rockGrid, ship.getPoint(), ship.isAlive());
+	for (int i = 0; i < (int)saucers.size(); i++)
+	{
+		if (!saucers[i].isAlive())
+			continue;
+		saucers[i].advance();
+		wrapAround(saucers[i], saucers[i].getRadius(), worldTopLeft, worldBottomRight);
+
+		float toX = ship.getPoint().getX() - saucers[i].getPoint().getX();
+		float toY = ship.getPoint().getY() - saucers[i].getPoint().getY();
+		if (saucers[i].reloaded() && ship.isAlive() && !justDied &&
+		    toX * toX + toY * toY < SAUCER_SHOT_RANGE * SAUCER_SHOT_RANGE)
+		{
+			float angle = (float)(atan2(toY, toX) * 180.0 / M_PI);
+			saucerShots.push_back(SaucerShot(saucers[i].getPoint(), angle, saucers[i].getVelocity()));
+			saucers[i].shoot();
 		}
 	}
 }
 
+/***************************************
+ * GAME :: MAKE FLOCK
+ * A bunch of saucers come in together from one side of the view
+ ***************************************/
+void Game::makeFlock()
+{
+	Point start(camera.getX() + random(topLeft.getX(), bottomRight.getX()), camera.getY() + topLeft.getY());
+	Velocity heading(0, -SAUCER_SPEED / FRAMES_VARIABLES_MULTIPLIER);
+	switch (random(0, 4))
+	{
+	case 1:
+		start = Point(camera.getX() + random(topLeft.getX(), bottomRight.getX()), camera.getY() + bottomRight.getY());
+		heading = Velocity(0, SAUCER_SPEED / FRAMES_VARIABLES_MULTIPLIER);
+		break;
+	case 2:
+		start = Point(camera.getX() + topLeft.getX(), camera.getY() + random(bottomRight.getY(), topLeft.getY()));
+		heading = Velocity(SAUCER_SPEED / FRAMES_VARIABLES_MULTIPLIER, 0);
+		break;
+	case 3:
+		start = Point(camera.getX() + bottomRight.getX(), camera.getY() + random(bottomRight.getY(), topLeft.getY()));
+		heading = Velocity(-SAUCER_SPEED / FRAMES_VARIABLES_MULTIPLIER, 0);
+		break;
+	}
+
+	for (int i = 0; i < SAUCER_FLOCK; i++)
+	{
+		Point point(start.getX() + random(-30.0, 30.0), start.getY() + random(-30.0, 30.0));
+		saucers.push_back(Saucer(World::fold(point, worldTopLeft, worldBottomRight), heading));
+	}
+}
+
 /**********
 * Advance Background
 **********/
@@ -133,10 +344,7 @@ void Game::advanceBackground()
 	{
 		background[i].advance();
 
-		if (!isOnScreen(background[i].getPoint(), 2))
-		{
-			background[i].flipSide(abs(background[i].getPoint().getY()) >= topLeft.getY(), abs(background[i].getPoint().getX()) >= bottomRight.getX());
-		}
+		wrapAround(background[i], 2, topLeft, bottomRight);
 	}
 }
 
@@ -145,24 +353,20 @@ void Game::advanceBackground()
  **************************************************************************/
 void Game::advanceRocks(const Interface & ui)
 {
-	if ((ui.isPractice() || ui.isMenu()) && !(ui.isClearScreen()))
+	nearRocks.clear();
+	if ((ui.isPractice() || ui.isMenu() || ui.isStress()) && !(ui.isClearScreen()))
 	{
 		if (asteroids.size() < 5)
-			asteroids.push_back(makeLargeRocks());
+			addRock(makeLargeRocks());
 
 		for (int i = 0; i < asteroids.size(); i++)
 		{
 			// we have a asteroid, make sure it's alive
 			if (asteroids[i]->isAlive())
 			{
-				// move it forward
-				asteroids[i]->advance();
-
-				// check if the rock has gone off the screen
-				if (!isOnScreen(asteroids[i]->getPoint(), asteroids[i]->getRadius()))
-				{
-					asteroids[i]->flipSide(abs(asteroids[i]->getPoint().getY()) >= topLeft.getY(), abs(asteroids[i]->getPoint().getX()) >= bottomRight.getX());
-				}
+				// it moves by itself, only see if it is close enough to be hit
+				if (followRock(*asteroids[i]))
+					nearRocks.push_back(asteroids[i]);
 			}
 		}
 	}
@@ -174,19 +378,19 @@ void Game::advanceRocks(const Interface & ui)
 			if (numSmallRocks < level.getLevel() % 3)
 			{
 				numSmallRocks++;
-				asteroids.push_back(makeSmallRocks());
+				addRock(makeSmallRocks());
 			}
 			else if (numMediumRocks < (level.getLevel() % 9) / 3)
 			{
 				numMediumRocks++;
-				asteroids.push_back(makeMediumRocks());
+				addRock(makeMediumRocks());
 			}
 			else if (numLargeRocks < level.getLevel() / 9)
 			{
 				numLargeRocks++;
-				asteroids.push_back(makeLargeRocks());
+				addRock(makeLargeRocks());
 			}
-			else if (asteroids.empty())
+			else if (asteroids.empty() && world.getSleepingRocks() == 0)
 			{
 				level.addLevel();
 				numSmallRocks = 0;
@@ -207,14 +411,9 @@ void Game::advanceRocks(const Interface & ui)
 			// we have a asteroid, make sure it's alive
 			if (asteroids[i]->isAlive())
 			{
-				// move it forward
-				asteroids[i]->advance();
-
-				// check if the rock has gone off the screen
-				if (!isOnScreen(asteroids[i]->getPoint(), asteroids[i]->getRadius()))
-				{
-					asteroids[i]->flipSide(abs(asteroids[i]->getPoint().getY()) >= topLeft.getY(), abs(asteroids[i]->getPoint().getX()) >= bottomRight.getX());
-				}
+				// it moves by itself, only see if it is close enough to be hit
+				if (followRock(*asteroids[i]))
+					nearRocks.push_back(asteroids[i]);
 			}
 		}
 	
@@ -231,8 +430,449 @@ void Game::advanceShip()
 	if (ship.isAlive())
 		ship.advance();
 	//if ship goes off screen then move to opposite side
-	if (!isOnScreen(ship.getPoint(), ship.getRadius()))
-		ship.flipSide(abs(ship.getPoint().getY()) >= topLeft.getY(), abs(ship.getPoint().getX()) >= bottomRight.getX());
+	wrapAround(ship, ship.getRadius(), worldTopLeft, worldBottomRight);
+}
+
+/**************************************************************************
+* GAME :: SET BIG WORLD
+* Switch between a world the size of the screen and one many screens
+* across. Going back to the screen brings every rock back onto it.
+***************************************************************************/
+void Game::setBigWorld(bool on)
+{
+	bigWorld = on;
+	kineticOn = false;
+	if (on)
+	{
+		// the rocks wrap somewhere else now, so start them from where they are
+		for (int i = 0; i < (int)asteroids.size(); i++)
+			asteroids[i]->setPoint(asteroids[i]->getCurrentPoint());
+		worldTopLeft = world.getTopLeft();
+		worldBottomRight = world.getBottomRight();
+		Rocks::setWorld(worldTopLeft, worldBottomRight);
+		trackAllRocks();
+		return;
+	}
+
+	world.wakeAll(asteroids, stars);
+	shockWave.stop();
+	worldTopLeft = topLeft;
+	worldBottomRight = bottomRight;
+	camera = Point(0, 0);
+	for (int i = 0; i < (int)asteroids.size(); i++)
+		asteroids[i]->setPoint(World::fold(asteroids[i]->getCurrentPoint(), topLeft, bottomRight));
+	Rocks::setWorld(topLeft, bottomRight);
+	for (int i = 0; i < (int)stars.size(); i++)
+		stars[i]->setPoint(World::fold(stars[i]->getCurrentPoint(), topLeft, bottomRight));
+	for (int i = 0; i < (int)bullets.size(); i++)
+		bullets[i].setPoint(World::fold(bullets[i].getPoint(), topLeft, bottomRight));
+	for (int i = 0; i < (int)missiles.size(); i++)
+		missiles[i].setPoint(World::fold(missiles[i].getPoint(), topLeft, bottomRight));
+	for (int i = 0; i < (int)saucers.size(); i++)
+		saucers[i].setPoint(World::fold(saucers[i].getPoint(), topLeft, bottomRight));
+	for (int i = 0; i < (int)saucerShots.size(); i++)
+		saucerShots[i].setPoint(World::fold(saucerShots[i].getPoint(), topLeft, bottomRight));
+	ship.setPoint(World::fold(ship.getPoint(), topLeft, bottomRight));
+	trackAllRocks();
+}
+
+/**************************************************************************
+* GAME :: IS IN VIEW
+* Is any part of a circle at this point on the screen?
+***************************************************************************/
+bool Game::isInView(const Point & point, int radius) const
+{
+	Point viewTopLeft(camera.getX() + topLeft.getX(), camera.getY() + topLeft.getY());
+	Point viewBottomRight(camera.getX() + bottomRight.getX(), camera.getY() + bottomRight.getY());
+	return isOnScreen(point, radius, viewTopLeft, viewBottomRight);
+}
+
+/**************************************************************************
+* GAME :: BUILD DETAIL
+* Mark where the ship and bullets are so stars far from them can be
+* moved less often, and rocks far from them are not looked at for hits.
+* Bouncing and gravity change how things move every tick, so then
+* everything is.
+***************************************************************************/
+void Game::buildDetail(const Interface & ui)
+{
+	useDetail = !ui.isBounce() && !ui.isGravity();
+	if (!useDetail)
+		return;
+
+	detail.clear(worldTopLeft, worldBottomRight);
+	detail.mark(ship.getPoint());
+	for (int i = 0; i < (int)bullets.size(); i++)
+	{
+		if (bullets[i].isAlive())
+			detail.mark(bullets[i].getPoint());
+	}
+	for (int i = 0; i < (int)missiles.size(); i++)
+	{
+		if (missiles[i].isAlive())
+			detail.mark(missiles[i].getPoint());
+	}
+
+	// the beam can hit anything along it
+	if (ui.isBeam())
+	{
+		Velocity along(cosDeg(ship.getAngle()), sinDeg(ship.getAngle()));
+		for (float reach = 0; reach <= BEAM_LENGTH; reach += DETAIL_CELL_SIZE / 2)
+			detail.mark(Point(ship.getPoint().getX() + along.getDx() * reach,
+			                  ship.getPoint().getY() + along.getDy() * reach));
+	}
+	detail.build();
+}
+
+/**************************************************************************
+* GAME :: MOVE
+* Move a star along a tick and wrap it. If it is far from the ship, the
+* bullets and the view it may be left a few ticks behind, then moved all
+* of them at once. Returns false when it is too far from the ship and
+* bullets to be hit this tick.
+***************************************************************************/
+bool Game::move(FlyingObject & object, int radius)
+{
+	int period = useDetail ? detail.getPeriod(object.getPoint()) : 1;
+	bool near = (period == 1);
+	if (!near && isInView(object.getPoint(), radius + (int)DETAIL_VIEW_MARGIN))
+		period = 1;
+
+	// nothing is written while it is behind, the tick counter keeps count
+	if (object.getLag() >= period)
+		catchUp(object, radius);
+	return near;
+}
+
+/**************************************************************************
+* GAME :: CATCH UP
+* Move something that was left behind all the ticks it missed, and wrap
+* it. Does nothing if it is not behind.
+***************************************************************************/
+void Game::catchUp(FlyingObject & object, int radius)
+{
+	int ticks = object.getLag();
+	if (ticks == 0)
+		return;
+	object.setLag(0);
+	if (ticks == 1)
+		object.advance();
+	else
+	{
+		// it may have gone a long way, so wrap it as many times as it takes
+		object.catchUp(ticks);
+		object.setPoint(World::fold(object.getPoint(),
+		                            Point(worldTopLeft.getX() - radius, worldTopLeft.getY() + radius),
+		                            Point(worldBottomRight.getX() + radius, worldBottomRight.getY() - radius)));
+	}
+	wrapAround(object, radius, worldTopLeft, worldBottomRight);
+}
+
+/**************************************************************************
+* GAME :: FOLLOW ROCK
+* Rocks are never moved, they are wherever their line says this tick
+* (see Rocks::getCurrentPoint). The kinetic collisions wrap at the edge
+* of the world and a rock only once it is all the way off it, so the
+* rock's line there is started over each time it wraps. Returns false
+* when it is too far from the ship and bullets to be hit this tick.
+***************************************************************************/
+bool Game::followRock(Rocks & rock)
+{
+	Point at = rock.getCurrentPoint();
+	int id = rock.getKineticId();
+	if (kineticOn && id >= 0 && FlyingObject::getTick() >= kineticWraps[id])
+	{
+		moveKinetic(rock, at);
+		kineticWraps[id] = rock.getWrapTick();
+	}
+	return !useDetail || detail.getPeriod(at) == 1;
+}
+
+/**************************************************************************
+* GAME :: FIRE BEAM
+* While V is held the beam comes out of the ship's nose and breaks up the
+* first few rocks in its way, every tick.
+***************************************************************************/
+void Game::fireBeam(const Interface & ui)
+{
+	beamOn = ui.isBeam() && ship.isAlive();
+	if (!beamOn)
+		return;
+
+	buildRockGrid();
+
+	float dx = cosDeg(ship.getAngle());
+	float dy = sinDeg(ship.getAngle());
+	beamStart = Point(ship.getPoint().getX() + dx * ship.getRadius(),
+	                  ship.getPoint().getY() + dy * ship.getRadius());
+	float reach = traceBeam(rockGrid, beamStart, ship.getAngle(), BEAM_LENGTH, BEAM_PIERCE, beamHits);
+	beamEnd = Point(beamStart.getX() + dx * reach, beamStart.getY() + dy * reach);
+
+	for (int i = 0; i < (int)beamHits.size(); i++)
+	{
+		Rocks * rock = asteroids[beamHits[i].id];
+		score += rock->getValue();
+		particles.burst(rock->getCurrentPoint(), rock->getVelocity(), rock->getRadius() * 6,
+		                2.0f, (int)(20 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_DUST);
+		std::vector<Rocks *> pieces = rock->killRocks();
+		for (int piece = 0; piece < (int)pieces.size(); piece++)
+			addRock(pieces[piece]);
+	}
+}
+
+/**************************************************************************
+* GAME :: BUILD ROCK GRID
+* Put every live rock in the grid by where it is in asteroids
+***************************************************************************/
+void Game::buildRockGrid()
+{
+	rockGrid.clear();
+	for (int i = 0; i < (int)asteroids.size(); i++)
+	{
+		if (asteroids[i]->isAlive())
+			rockGrid.insert(i, asteroids[i]->getCurrentPoint(), (float)asteroids[i]->getRadius());
+	}
+	rockGrid.build();
+}
+
+/**************************************************************************
+* GAME :: ADD ROCK
+* Every new rock goes through here so the threat tracker knows about it.
+***************************************************************************/
+void Game::addRock(Rocks * rock)
+{
+	asteroids.push_back(rock);
+	threats.add(rock);
+	addKinetic(rock);
+}
+
+/**************************************************************************
+* GAME :: TRACK ALL ROCKS
+* The world changed size, so start the threat tracker over with the
+* rocks that are awake.
+***************************************************************************/
+void Game::trackAllRocks()
+{
+	threats.setWorld(worldTopLeft, worldBottomRight);
+	for (int i = 0; i < (int)asteroids.size(); i++)
+		threats.add(asteroids[i]);
+}
+
+/**************************************************************************
+* GAME :: KINETIC TIME
+* The tick the game is on in the kinetic collisions' time. The kinetic
+* collisions are caught up to it in handleCollisions(), so until then
+* they are one tick behind.
+***************************************************************************/
+float Game::kineticTime() const
+{
+	return (float)(FlyingObject::getTick() - kineticEpoch);
+}
+
+/**************************************************************************
+* GAME :: KINETIC START
+* Where something that is at this point now was at the kinetic
+* collisions' time, which is where its line starts
+***************************************************************************/
+Point Game::kineticStart(const Point & at, const Velocity & speed) const
+{
+	float behind = kineticTime() - kinetic.getTime();
+	return Point(at.getX() - speed.getDx() * behind, at.getY() - speed.getDy() * behind);
+}
+
+/**************************************************************************
+* GAME :: START KINETIC
+* Take everything out and put the rocks back in. The shots go in when
+* they are next checked. Time starts one tick back so this tick's moves
+* are checked.
+***************************************************************************/
+void Game::startKinetic()
+{
+	kinetic.setWorld(worldBottomRight.getX(), worldTopLeft.getY(), KINETIC_CELL_SIZE);
+	kineticEpoch = FlyingObject::getTick() - 1;
+	kineticOn = true;
+	kineticRocks.clear();
+	kineticShots.clear();
+	for (int i = 0; i < (int)bullets.size(); i++)
+		bullets[i].setKineticId(-1);
+	for (int i = 0; i < (int)missiles.size(); i++)
+		missiles[i].setKineticId(-1);
+	for (int i = 0; i < (int)asteroids.size(); i++)
+	{
+		asteroids[i]->setKineticId(-1);
+		addKinetic(asteroids[i]);
+	}
+}
+
+/**************************************************************************
+* GAME :: ADD KINETIC
+* A rock goes in the kinetic collisions where it is now
+***************************************************************************/
+void Game::addKinetic(Rocks * rock)
+{
+	if (!kineticOn || !rock->isAlive() || rock->getKineticId() >= 0)
+		return;
+	int id = kinetic.add(KINETIC_ROCK, kineticStart(rock->getCurrentPoint(), rock->getVelocity()),
+	                     rock->getVelocity(), (float)rock->getRadius());
+	rock->setKineticId(id);
+	if (id >= (int)kineticRocks.size())
+	{
+		kineticRocks.resize(id + 1, NULL);
+		kineticWraps.resize(id + 1, 0);
+	}
+	kineticRocks[id] = rock;
+	kineticWraps[id] = rock->getWrapTick();
+}
+
+/**************************************************************************
+* GAME :: MOVE KINETIC / DROP KINETIC
+* It was put somewhere else or sped up, or it is gone
+***************************************************************************/
+void Game::moveKinetic(FlyingObject & object, const Point & at)
+{
+	if (kineticOn && object.getKineticId() >= 0)
+		kinetic.setMotion(object.getKineticId(), kineticStart(at, object.getVelocity()), object.getVelocity());
+}
+
+void Game::dropKinetic(FlyingObject & object)
+{
+	if (kineticOn && object.getKineticId() >= 0)
+		kinetic.remove(object.getKineticId());
+	object.setKineticId(-1);
+}
+
+/**************************************************************************
+* GAME :: SYNC SHOT
+* Put a new bullet or missile in the kinetic collisions, take a dead one
+* out, and start the line over if it turned (missiles steer every tick)
+* or was wrapped. Also says which shot its id is this tick.
+***************************************************************************/
+void Game::syncShot(Bullet & shot)
+{
+	int id = shot.getKineticId();
+	if (!shot.isAlive())
+	{
+		dropKinetic(shot);
+		return;
+	}
+	if (id < 0)
+	{
+		id = kinetic.add(KINETIC_SHOT, kineticStart(shot.getPoint(), shot.getVelocity()), shot.getVelocity(), 0);
+		shot.setKineticId(id);
+	}
+	else
+	{
+		// where the kinetic collisions will have it, the short way around
+		float width = worldBottomRight.getX() - worldTopLeft.getX();
+		float height = worldTopLeft.getY() - worldBottomRight.getY();
+		float behind = kineticTime() - kinetic.getTime();
+		Point there = kinetic.getPoint(id);
+		Velocity was = kinetic.getVelocity(id);
+		float dx = shot.getPoint().getX() - (there.getX() + was.getDx() * behind);
+		float dy = shot.getPoint().getY() - (there.getY() + was.getDy() * behind);
+		dx -= width * std::round(dx / width);
+		dy -= height * std::round(dy / height);
+		if (std::abs(dx) > 0.01f || std::abs(dy) > 0.01f ||
+		    was.getDx() != shot.getVelocity().getDx() || was.getDy() != shot.getVelocity().getDy())
+			moveKinetic(shot, shot.getPoint());
+	}
+	if (id >= (int)kineticShots.size())
+		kineticShots.resize(id + 1, NULL);
+	kineticShots[id] = &shot;
+}
+
+/**************************************************************************
+* GAME :: HIT ROCKS AHEAD
+* The same as hitRocks() for every bullet and missile, but only the hits
+* the kinetic collisions found between last tick and this one are looked
+* at. The pieces go at the end of nearRocks like hitRocks() does it, and
+* in the kinetic collisions straight away so the shots after can hit them.
+***************************************************************************/
+void Game::hitRocksAhead(const RockHitCallback & onRockHit)
+{
+	for (int i = 0; i < (int)bullets.size(); i++)
+		syncShot(bullets[i]);
+	for (int i = 0; i < (int)missiles.size(); i++)
+		syncShot(missiles[i]);
+	kinetic.advance(kineticTime(), [this, &onRockHit](int rockId, int shotId)
+	{
+		Rocks * rock = kineticRocks[rockId];
+		Bullet * shot = kineticShots[shotId];
+		if (!rock->isAlive() || !shot->isAlive())
+			return;
+
+		shot->kill();
+		dropKinetic(*shot);
+		dropKinetic(*rock);
+		std::vector<Rocks *> pieces = rock->killRocks();
+		for (int piece = 0; piece < (int)pieces.size(); piece++)
+		{
+			nearRocks.push_back(pieces[piece]);
+			addKinetic(pieces[piece]);
+		}
+		onRockHit(*rock);
+	});
+}
+
+/**************************************************************************
+* GAME :: APPLY GRAVITY
+* Rocks and black holes pull on the rocks, bullets and ship. This only
+* changes their speed, advance() still does the moving.
+***************************************************************************/
+void Game::applyGravity()
+{
+	gravitySources.clear();
+	gravityTargets.clear();
+	for (int i = 0; i < (int)asteroids.size(); i++)
+	{
+		if (asteroids[i]->isAlive())
+		{
+			Point at = asteroids[i]->getCurrentPoint();
+			GravitySource source = { at.getX(), at.getY(), asteroids[i]->getMass() };
+			GravityTarget target = { source.x, source.y, (int)gravitySources.size() };
+			gravitySources.push_back(source);
+			gravityTargets.push_back(target);
+		}
+	}
+	for (int i = 0; i < (int)blackHoles.size(); i++)
+	{
+		GravitySource source = { blackHoles[i].getX(), blackHoles[i].getY(), BLACK_HOLE_MASS };
+		gravitySources.push_back(source);
+	}
+	for (int i = 0; i < (int)bullets.size(); i++)
+	{
+		if (bullets[i].isAlive())
+		{
+			GravityTarget target = { bullets[i].getPoint().getX(), bullets[i].getPoint().getY(), -1 };
+			gravityTargets.push_back(target);
+		}
+	}
+	GravityTarget shipTarget = { ship.getPoint().getX(), ship.getPoint().getY(), -1 };
+	gravityTargets.push_back(shipTarget);
+
+	gravity.build(gravitySources);
+	gravity.pullAll(gravityTargets, gravityPulls);
+
+	// hand the pulls back out in the same order they were gathered
+	int next = 0;
+	for (int i = 0; i < (int)asteroids.size(); i++)
+	{
+		if (asteroids[i]->isAlive())
+		{
+			const Velocity & pull = gravityPulls[next++];
+			if (pull.getDx() == 0 && pull.getDy() == 0)
+				continue;
+			asteroids[i]->accelerate(pull);
+			threats.update(asteroids[i]);
+		}
+	}
+	for (int i = 0; i < (int)bullets.size(); i++)
+	{
+		if (bullets[i].isAlive())
+			bullets[i].accelerate(gravityPulls[next++]);
+	}
+	if (ship.isAlive())
+		ship.accelerate(gravityPulls[next]);
 }
 
 /************
@@ -274,14 +914,8 @@ void Game::advanceStars(const Interface & ui)
 		{
 			if (stars[i]->isAlive())
 			{
-				// move it forward
-				stars[i]->advance();
-
-				// check if the star has gone off the screen
-				if (!isOnScreen(stars[i]->getPoint(), stars[i]->getRadius()))
-				{
-					stars[i]->flipSide(abs(stars[i]->getPoint().getY()) >= topLeft.getY(), abs(stars[i]->getPoint().getX()) >= bottomRight.getX());
-				}
+				// move it forward, and wrap if it has gone off the screen
+				move(*stars[i], stars[i]->getRadius());
 			}
 		}
 	}
@@ -298,16 +932,16 @@ Rocks* Game::makeLargeRocks()
 	switch (side)
 	{
 	case 0:
-		rock = new BigRock(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new BigRock(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		rock = new BigRock(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new BigRock(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		rock = new BigRock(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		rock = new BigRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		rock = new BigRock(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		rock = new BigRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return rock;
@@ -324,16 +958,16 @@ Rocks* Game::makeMediumRocks()
 	switch (side)
 	{
 	case 0:
-		rock = new MediumRock(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new MediumRock(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		rock = new MediumRock(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new MediumRock(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		rock = new MediumRock(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		rock = new MediumRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		rock = new MediumRock(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		rock = new MediumRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return rock;
@@ -350,16 +984,16 @@ Rocks* Game::makeSmallRocks()
 	switch (side)
 	{
 	case 0:
-		rock = new SmallRock(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new SmallRock(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		rock = new SmallRock(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		rock = new SmallRock(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		rock = new SmallRock(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		rock = new SmallRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		rock = new SmallRock(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		rock = new SmallRock(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return rock;
@@ -385,16 +1019,16 @@ Stars * Game::makeRedStars()
 	switch (side)
 	{
 	case 0:
-		star = new RedStar(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new RedStar(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		star = new RedStar(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new RedStar(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		star = new RedStar(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		star = new RedStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		star = new RedStar(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		star = new RedStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return star;
@@ -410,16 +1044,16 @@ Stars * Game::makeBlueStars()
 	switch (side)
 	{
 	case 0:
-		star = new BlueStar(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new BlueStar(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		star = new BlueStar(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new BlueStar(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		star = new BlueStar(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		star = new BlueStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		star = new BlueStar(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		star = new BlueStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return star;
@@ -435,21 +1069,86 @@ Stars * Game::makeWhiteStars()
 	switch (side)
 	{
 	case 0:
-		star = new WhiteStar(Point(topLeft.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new WhiteStar(Point(worldTopLeft.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 1:
-		star = new WhiteStar(Point(bottomRight.getX(), random(bottomRight.getY(), topLeft.getY())));
+		star = new WhiteStar(Point(worldBottomRight.getX(), random(worldBottomRight.getY(), worldTopLeft.getY())));
 		break;
 	case 2:
-		star = new WhiteStar(Point(random(topLeft.getX(), bottomRight.getX()), topLeft.getY()));
+		star = new WhiteStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldTopLeft.getY()));
 		break;
 	case 3:
-		star = new WhiteStar(Point(random(topLeft.getX(), bottomRight.getX()), bottomRight.getY()));
+		star = new WhiteStar(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), worldBottomRight.getY()));
 		break;
 	}
 	return star;
 }
 
+/**************************************************************************
+ * GAME :: STRESS
+ * Fill the screen with rocks and stars until there are as many as asked
+ * for. Bullets come from the ship spinning and firing a few every tick,
+ * just enough that there are bulletCount in the air as the old ones die.
+ **************************************************************************/
+void Game::stress(int rockCount, int bulletCount, int starCount)
+{
+	while ((int)asteroids.size() + world.getSleepingRocks() < rockCount)
+	{
+		Rocks * rock = NULL;
+		switch (asteroids.size() % 3)
+		{
+		case 0:
+			rock = makeLargeRocks();
+			break;
+		case 1:
+			rock = makeMediumRocks();
+			break;
+		case 2:
+			rock = makeSmallRocks();
+			break;
+		}
+		// the make methods start them on the edge, spread them out instead
+		rock->setPoint(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), random(worldBottomRight.getY(), worldTopLeft.getY())));
+		addRock(rock);
+	}
+
+	static float fireAngle = 0;
+	int perTick = (bulletCount + BULLET_LIFE - 1) / BULLET_LIFE;
+	for (int i = 0; i < perTick && (int)bullets.size() < bulletCount; i++)
+	{
+		// the golden angle keeps the fan from lining up with itself
+		fireAngle += 137.5;
+		if (fireAngle >= 360)
+			fireAngle -= 360;
+		bullets.push_back(Bullet(ship.getPoint(), fireAngle, ship.getVelocity()));
+	}
+
+	while ((int)stars.size() + world.getSleepingStars() < starCount)
+	{
+		Stars * star = NULL;
+		switch (stars.size() % 3)
+		{
+		case 0:
+			star = makeRedStars();
+			break;
+		case 1:
+			star = makeBlueStars();
+			break;
+		case 2:
+			star = makeWhiteStars();
+			break;
+		}
+		star->setPoint(Point(random(worldTopLeft.getX(), worldBottomRight.getX()), random(worldBottomRight.getY(), worldTopLeft.getY())));
+		stars.push_back(star);
+	}
+}
+
+int Game::getEntityCount() const
+{
+	return (int)(asteroids.size() + bullets.size() + missiles.size() + stars.size()) +
+	       world.getSleepingRocks() + world.getSleepingStars();
+}
+
 /***************
 * Make stationary stars
 ****************/
@@ -462,18 +1161,6 @@ void Game::makeStarsPractice()
 	stars.push_back(star);
 }
 
-/**************************************************************************
- * GAME :: IS ON SCREEN
- * Determines if a given point is on the screen.
- **************************************************************************/
-bool Game::isOnScreen(const Point & point, int radius)
-{
-	return (point.getX() >= topLeft.getX() - radius
-		&& point.getX() <= bottomRight.getX() + radius
-		&& point.getY() >= bottomRight.getY() - radius
-		&& point.getY() <= topLeft.getY() + radius);
-}
-
 /**************************************************************************
  * GAME :: HANDLE COLLISIONS
  * Check for a collision between an asteroid and a bullet.
@@ -481,6 +1168,45 @@ bool Game::isOnScreen(const Point & point, int radius)
 void Game::handleCollisions(const Interface & ui)
 {
 	static int immortal = 0;
+	int firstPiece = (int)nearRocks.size();
+
+	// the shots are checked against the rocks ahead of time when nothing
+	// bounces or pulls, started over if that was not so until now
+	if (!ui.isBounce() && !ui.isGravity() &&
+	    (!kineticOn || kineticTime() > KINETIC_RESTART_TIME))
+		startKinetic();
+
+	// what happens to a rock a bullet or missile hits
+	RockHitCallback onRockHit = [this, &ui](Rocks & rock)
+	{
+		// hit the asteroid
+		int points = rock.getValue();
+		score += points; 
+		particles.burst(rock.getCurrentPoint(), rock.getVelocity(), rock.getRadius() * 6,
+		                2.0f, (int)(20 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_DUST);
+
+		// When asteroid dies randomly decide to make star
+		if ((ui.isLevels()) && !(ui.isClearScreen()))
+		{
+			if (random(0, (20 + level.getLevel())) <= 10)
+			{
+				int type = random(1, 4);
+				switch (type)
+				{
+				case 1:
+					stars.push_back(makeRedStars());
+					break;
+				case 2:
+					stars.push_back(makeBlueStars());
+					break; 
+				case 3:
+					stars.push_back(makeWhiteStars());
+					break;
+				}
+			}
+		}
+	};
+
 	// now check for a hit (if it is close enough to any live bullets)
 	for (int i = 0; i < bullets.size(); i++)
 	{
@@ -512,76 +1238,99 @@ void Game::handleCollisions(const Interface & ui)
 				}
 			}
 
-			// check if the asteroid is at this point (in case it was hit)
-			for (int asteroidCount = 0; asteroidCount < asteroids.size(); asteroidCount++)
-			{
-				if (asteroids[asteroidCount]->isAlive())
-				{
-					if ((asteroids[asteroidCount]->getRadius()) >= getClosestDistance(bullets[i], *(asteroids[asteroidCount])))
-					{
-						//we have a hit!
-						std::vector<Rocks*> temp;
-						temp = asteroids[asteroidCount]->killRocks();
-						for (int tempCount = 0; tempCount < temp.size(); tempCount++)
-						{
-							asteroids.push_back(temp[tempCount]);
-						}
-						// hit the asteroid
-						int points = asteroids[asteroidCount]->getValue();
-						score += points; 
+			// check if the asteroid is at this point (in case it was hit),
+			// only the near rocks can be
+			if (!kineticOn)
+				hitRocks(bullets[i], nearRocks, onRockHit);
 
-						// the bullet is dead as well
-						bullets[i].kill();
+		} // if bullet is alive
 
-						// When asteroid dies randomly decide to make star
-						if ((ui.isLevels()) && !(ui.isClearScreen()))
-						{
-							if (random(0, (20 + level.getLevel())) <= 10)
-							{
-								int type = random(1, 4);
-								switch (type)
-								{
-								case 1:
-									stars.push_back(makeRedStars());
-									break;
-								case 2:
-									stars.push_back(makeBlueStars());
-									break; 
-								case 3:
-									stars.push_back(makeWhiteStars());
-									break;
-								}
-							}
-						}
-					}
-				}			
+	} // for bullets
+
+	for (int i = 0; i < (int)missiles.size() && !kineticOn; i++)
+	{
+		if (missiles[i].isAlive())
+			hitRocks(missiles[i], nearRocks, onRockHit);
+	}
+	if (kineticOn)
+		hitRocksAhead(onRockHit);
+
+	// bullets and missiles against the saucers. The grid has the saucers
+	// where they were before they moved this tick, so look a little wider
+	auto hitSaucers = [this](Bullet & bullet)
+	{
+		float x = bullet.getPoint().getX();
+		float y = bullet.getPoint().getY();
+		float reach = SAUCER_SIZE + SAUCER_SPEED;
+		flock.getGrid().query(x - reach, y - reach, x + reach, y + reach, [&](const GridEntry & entry)
+		{
+			Saucer & saucer = saucers[entry.id];
+			if (bullet.isAlive() && saucer.isAlive() &&
+			    saucer.getRadius() >= getClosestDistance(bullet, saucer))
+			{
+				bullet.kill();
+				saucer.kill();
+				score += saucer.getValue();
+				particles.burst(saucer.getPoint(), saucer.getVelocity(), 60,
+				                2.5f, (int)(20 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_FIRE);
 			}
+		});
+	};
+	if (!saucers.empty())
+	{
+		for (int i = 0; i < (int)bullets.size(); i++)
+			hitSaucers(bullets[i]);
+		for (int i = 0; i < (int)missiles.size(); i++)
+			hitSaucers(missiles[i]);
+	}
 
-		} // if bullet is alive
+	// the pieces of any rocks that were hit were added to the end of nearRocks
+	for (int i = firstPiece; i < (int)nearRocks.size(); i++)
+		addRock(nearRocks[i]);
 
-	} // for bullets
+	// the ship blows up, unless it has a shield which is used up instead
+	auto hitShip = [this](FlyingObject & other)
+	{
+		justDied = true;
+		immortal = (30 * FRAMES_VARIABLES_MULTIPLIER * 3);
+		if (!bonusShield)
+		{
+			ship.kill();
+			particles.burst(ship.getPoint(), ship.getVelocity(), 400,
+			                3.0f, (int)(30 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_FIRE);
+		}
+		else
+		{
+			other.kill();
+			bonusShield = false;
+		}
+	};
 
 	// now check for collision with ship
 	if (ship.isAlive() && !justDied && !ui.isMenu())
 	{
-		for (int i = 0; i < asteroids.size(); i++)
+		for (int i = 0; i < (int)nearRocks.size(); i++)
 		{
-			if (asteroids[i]->isAlive())
+			if (nearRocks[i]->isAlive())
 			{
-				if ((asteroids[i]->getRadius() + ship.getRadius()) >= getClosestDistance(ship, *(asteroids[i])))
-				{
-					justDied = true;
-					immortal = (30 * FRAMES_VARIABLES_MULTIPLIER * 3);
-					if (!bonusShield)
-					{
-						ship.kill();
-					}
-					else
-					{
-						asteroids[i]->kill();
-						bonusShield = false;
-					}
-				}
+				if ((nearRocks[i]->getRadius() + ship.getRadius()) >= getClosestDistance(ship, *(nearRocks[i])))
+					hitShip(*nearRocks[i]);
+			}
+		}
+		for (int i = 0; i < (int)saucers.size() && !justDied; i++)
+		{
+			if (saucers[i].isAlive())
+			{
+				if ((saucers[i].getRadius() + ship.getRadius()) >= getClosestDistance(ship, saucers[i]))
+					hitShip(saucers[i]);
+			}
+		}
+		for (int i = 0; i < (int)saucerShots.size() && !justDied; i++)
+		{
+			if (saucerShots[i].isAlive())
+			{
+				if (ship.getRadius() >= getClosestDistance(ship, saucerShots[i]))
+					hitShip(saucerShots[i]);
 			}
 		}
 		for (int i = 0; i < stars.size(); i++)
@@ -616,6 +1365,9 @@ void Game::handleCollisions(const Interface & ui)
 			justDied = false;
 		}
 	}
+
+	// the dead ones are about to be deleted
+	nearRocks.clear();
 }
 
 /**************************************************************************
@@ -632,6 +1384,8 @@ void Game::cleanUpZombies(const Interface & ui)
 
 		if (!(pAsteroid->isAlive()) || ui.isClearScreen())
 		{
+			threats.remove(pAsteroid);
+			dropKinetic(*pAsteroid);
 			delete pAsteroid;
 			// remove from list and advance
 			asteroidIt = asteroids.erase(asteroidIt);
@@ -651,6 +1405,7 @@ void Game::cleanUpZombies(const Interface & ui)
 		if ((!bullet.isAlive()) || ui.isClearScreen())
 		{
 			// remove from list and advance
+			dropKinetic(*bulletIt);
 			bulletIt = bullets.erase(bulletIt);
 		}
 		else
@@ -659,6 +1414,50 @@ void Game::cleanUpZombies(const Interface & ui)
 		}
 	}
 
+	// Look for dead missiles
+	std::vector<Missile>::iterator missileIt = missiles.begin();
+	while (missileIt != missiles.end())
+	{
+		if ((!missileIt->isAlive()) || ui.isClearScreen())
+		{
+			// remove from list and advance
+			dropKinetic(*missileIt);
+			missileIt = missiles.erase(missileIt);
+		}
+		else
+		{
+			missileIt++; // advance
+		}
+	}
+
+	// Look for dead saucers and what they shot
+	std::vector<Saucer>::iterator saucerIt = saucers.begin();
+	while (saucerIt != saucers.end())
+	{
+		if ((!saucerIt->isAlive()) || ui.isClearScreen())
+		{
+			// remove from list and advance
+			saucerIt = saucers.erase(saucerIt);
+		}
+		else
+		{
+			saucerIt++; // advance
+		}
+	}
+	std::vector<SaucerShot>::iterator shotIt = saucerShots.begin();
+	while (shotIt != saucerShots.end())
+	{
+		if ((!shotIt->isAlive()) || ui.isClearScreen())
+		{
+			// remove from list and advance
+			shotIt = saucerShots.erase(shotIt);
+		}
+		else
+		{
+			shotIt++; // advance
+		}
+	}
+
 	std::vector<Background>::iterator backgroundIt = background.begin();
 	while (backgroundIt != background.end())
 	{
@@ -677,7 +1476,7 @@ void Game::cleanUpZombies(const Interface & ui)
 
 	if (!ship.isAlive() && !gameOver)
 	{
-		if (ui.isPractice())
+		if (ui.isPractice() || ui.isStress())
 		{
 			ship.reset();
 			score = 0;
@@ -722,6 +1521,7 @@ void Game::cleanUpZombies(const Interface & ui)
  ***************************************/
 void Game::handleInput(const Interface & ui)
 {
+	beamOn = false;
 	//need static variables.
 	if (!(ui.isMenu()) && !(gameOver) && !(ui.isPause())) //don't interact if on menu
 	{
@@ -760,6 +1560,15 @@ void Game::handleInput(const Interface & ui)
 			ship.strafe(false);
 		}
 
+		// exhaust out the back of the ship whenever it is pushing forward
+		if (ship.isAlive() && (ui.isUp() || ui.isStrafeL() || ui.isStrafeR()))
+		{
+			particles.spray(ship.getPoint(), ship.getVelocity(), 4, ship.getAngle() + 180,
+			                15.0f, 2.0f, (int)(8 * FRAMES_VARIABLES_MULTIPLIER), PARTICLE_EXHAUST);
+		}
+
+		fireBeam(ui);
+
 		// Check for "Spacebar
 		if (ui.isSpace())
 		{
@@ -767,16 +1576,24 @@ void Game::handleInput(const Interface & ui)
 			bullets.push_back(newBullet);
 		}
 
+		// R fires a fan of missiles that go after the nearest rocks
+		if (ui.isMissile() && ship.isAlive())
+		{
+			for (int i = 0; i < MISSILE_VOLLEY; i++)
+			{
+				float angle = ship.getAngle() + (i - (MISSILE_VOLLEY - 1) / 2.0f) * 15.0f;
+				missiles.push_back(Missile(ship.getPoint(), angle));
+			}
+		}
+
 		if (ui.shockWave())
 		{
 			if (bonusWeapon)
 			{
-				for (int i = 0; i < asteroids.size(); i++)
-				{
-					score += asteroids[i]->hit();
-					delete asteroids[i];
-				}
-				asteroids.clear();
+				// grows far enough to reach every corner of the screen from anywhere on it
+				float width = bottomRight.getX() - topLeft.getX();
+				float height = topLeft.getY() - bottomRight.getY();
+				shockWave.start(ship.getPoint(), sqrt(width * width + height * height));
 				bonusWeapon = false;
 			}
 		}
@@ -833,8 +1650,11 @@ void Game::handleInput(const Interface & ui)
 			bonusWeapon = false;
 		}
 		else if (ui.isQuit())
-			exit(0);
+			Interface::leave(0);
 	}
+
+	// nothing is being played, so the window does not need every frame
+	Interface::setIdle(ui.isMenu() || ui.isPause() || gameOver);
 }
 
 /*********************************************
@@ -843,40 +1663,127 @@ void Game::handleInput(const Interface & ui)
  *********************************************/
 void Game::draw(const Interface & ui)
 {
-	for (int i = 0; i < asteroids.size(); i++)
+	// draw background, it stays put on the screen. The long lists are
+	// cut up and drawn on every core.
+	beginBatch(batch);
+	batch.setLayer(0);
+	drawParallel((int)background.size(), [&](int begin, int end)
 	{
-		if (asteroids[i]->isAlive())
+		for (int i = begin; i < end; i++)
 		{
-			asteroids[i]->draw();
+			if (background[i].isAlive())
+			{
+				background[i].draw();
+			}
 		}
+	});
+	endBatch();
+	drawBatch(batch);
+
+	// everything else is drawn where it is in the world,
+	// and only if it can be seen
+	beginCamera(camera);
+	auto drawRocks = [&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			if (asteroids[i]->isAlive() && isInView(asteroids[i]->getCurrentPoint(), asteroids[i]->getRadius()))
+			{
+				asteroids[i]->draw();
+			}
+		}
+	};
+
+	// the rocks are drawn from their outlines on the card when going
+	// straight to the window, else they go in the batch first
+	const std::vector<signed char> & outlines = OutlinePool::getAll();
+	bool rocksDrawn = beginOutlines(outlines.data(), (int)outlines.size(), OutlinePool::getVersion());
+	if (rocksDrawn)
+	{
+		drawRocks(0, (int)asteroids.size());
+		endOutlines();
+	}
+
+	beginBatch(batch);
+	if (!rocksDrawn)
+	{
+		batch.setLayer(LAYER_ROCKS);
+		drawParallel((int)asteroids.size(), drawRocks);
 	}
 
 	// draw the bullets, if they are alive
-	for (int i = 0; i < bullets.size(); i++)
+	batch.setLayer(LAYER_SHOTS);
+	drawParallel((int)bullets.size(), [&](int begin, int end)
 	{
-		if (bullets[i].isAlive())
+		for (int i = begin; i < end; i++)
+		{
+			if (bullets[i].isAlive() && isInView(bullets[i].getPoint(), 2))
+			{
+				bullets[i].draw();
+			}
+		}
+	});
+
+	for (int i = 0; i < (int)missiles.size(); i++)
+	{
+		if (missiles[i].isAlive() && isInView(missiles[i].getPoint(), 6))
 		{
-			bullets[i].draw();
+			missiles[i].draw();
 		}
 	}
 
-	// draw background
-	for (int i = 0; i < background.size(); i++)
+	batch.setLayer(LAYER_SAUCERS);
+	for (int i = 0; i < (int)saucers.size(); i++)
 	{
-		if (background[i].isAlive())
+		if (saucers[i].isAlive() && isInView(saucers[i].getPoint(), saucers[i].getRadius()))
 		{
-			background[i].draw();
+			saucers[i].draw();
+		}
+	}
+	for (int i = 0; i < (int)saucerShots.size(); i++)
+	{
+		if (saucerShots[i].isAlive() && isInView(saucerShots[i].getPoint(), 2))
+		{
+			saucerShots[i].draw();
 		}
 	}
 
-	// draw the stars
-	for (int i = 0; i < stars.size(); i++)
+	batch.setLayer(LAYER_EFFECTS);
+	if (beamOn)
+		drawLine(beamStart, beamEnd, 0.4, 0.8, 1.0);
+
+	shockWave.draw();
+
+	// draw the black holes
+	if (ui.isGravity())
 	{
-		if (stars[i]->isAlive())
+		for (int i = 0; i < (int)blackHoles.size(); i++)
 		{
-			stars[i]->draw();
+			drawCircle(blackHoles[i], BLACK_HOLE_SIZE);
+			drawCircle(blackHoles[i], BLACK_HOLE_SIZE / 2);
 		}
 	}
+	endBatch();
+	drawBatch(batch);
+
+	// draw the sparks and dust
+	particles.draw();
+
+	// draw the stars, over the sparks
+	beginBatch(batch);
+	batch.setLayer(0);
+	drawParallel((int)stars.size(), [&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			if (stars[i]->isAlive() && isInView(stars[i]->getPoint(), stars[i]->getRadius()))
+			{
+				stars[i]->draw();
+			}
+		}
+	});
+	endBatch();
+	drawBatch(batch);
 
 	static int flashCount = 0; //Flash when just died
    	if (!ui.isMenu() && !gameOver && !ui.displayPassword())
@@ -899,20 +1806,56 @@ void Game::draw(const Interface & ui)
 			else if (flashCount >= 14 * FRAMES_VARIABLES_MULTIPLIER)
 				flashCount = 0;
 		}
+
+		// a red tick around the ship toward each rock that is about to
+		// come close, whiter the longer there is until it does
+		if (ui.isThreats() && ship.isAlive())
+		{
+			int ticks = (int)(THREAT_TICKS * FRAMES_VARIABLES_MULTIPLIER);
+			threats.getThreats(shipWatcher, ticks, shipThreats);
+			for (int i = 0; i < (int)shipThreats.size() && i < THREAT_SHOWN; i++)
+			{
+				// a rock that is behind has not been moved to where it is
+				Point rock = shipThreats[i].rock->getCurrentPoint();
+				float dx = rock.getX() - ship.getPoint().getX();
+				float dy = rock.getY() - ship.getPoint().getY();
+				float length = sqrt(dx * dx + dy * dy);
+				if (length < 1)
+					continue;
+				dx /= length;
+				dy /= length;
+				float fade = shipThreats[i].enter / ticks;
+				drawLine(Point(ship.getPoint().getX() + dx * 16, ship.getPoint().getY() + dy * 16),
+				         Point(ship.getPoint().getX() + dx * 28, ship.getPoint().getY() + dy * 28),
+				         1.0, fade, fade);
+			}
+		}
 	}
-	else if (ui.displayPassword())
+	endCamera();
+
+	if (ui.displayPassword())
 	{
 		displayPassword(Point(0, 0), level.getPasskey());
 	}
 
-	// Put the score on the screen
+	// Put the score on the screen, the numbers all go out together
+	beginBatch(batch);
+	batch.setLayer(0);
 	drawScore(Point(topLeft.getX() + 20, topLeft.getY() - 30), score);
 	drawHighScore(Point(-45, topLeft.getY() - 30), highScore);
 	if (bonusWeapon)
 		drawWeaponAvailable(Point(-120, bottomRight.getY() + 40));
 
 	if (ui.isFramesPerSecond())
+	{
 		drawNumber(Point(bottomRight.getX() - 60, topLeft.getY() - 40), ui.getFramesPerSecond());
+
+		// how late the ticks have been, on time on the left
+		int lateness[PACER_BUCKETS];
+		for (int i = 0; i < PACER_BUCKETS; i++)
+			lateness[i] = ui.getPacer().getBucket(i);
+		drawHistogram(Point(bottomRight.getX() - 60, topLeft.getY() - 80), lateness, PACER_BUCKETS, 20);
+	}
 	
 	if (ui.isLevels())
 	{
@@ -939,6 +1882,9 @@ void Game::draw(const Interface & ui)
 		}
 
 	}
+	endBatch();
+	drawBatch(batch);
+
 	if (gameOver)
 	{
 		drawGameOver(Point(-60, 90), highScore, changeHighScore);
@@ -947,37 +1893,4 @@ void Game::draw(const Interface & ui)
 	{
 		drawPause(Point(-35, 0));
 	}
-}
-
-/**********************************************************
- * Function: getClosestDistance
- * Description: Determine how close these two objects will
- *   get in between the frames.
- **********************************************************/
-
-float Game :: getClosestDistance(const FlyingObject &obj1, const FlyingObject &obj2) const
-{
-   // find the maximum distance traveled
-   float dMax = std::max(abs(obj1.getVelocity().getDx()), abs(obj1.getVelocity().getDy()));
-   dMax = std::max(dMax, abs(obj2.getVelocity().getDx()));
-   dMax = std::max(dMax, abs(obj2.getVelocity().getDy()));
-   dMax = std::max(dMax, 0.1f); // when dx and dy are 0.0. Go through the loop once.
-   
-   float distMin = std::numeric_limits<float>::max();
-   for (float i = 0.0; i <= dMax; i++)
-   {
-      Point point1(obj1.getPoint().getX() + (obj1.getVelocity().getDx() * i / dMax),
-                     obj1.getPoint().getY() + (obj1.getVelocity().getDy() * i / dMax));
-      Point point2(obj2.getPoint().getX() + (obj2.getVelocity().getDx() * i / dMax),
-                     obj2.getPoint().getY() + (obj2.getVelocity().getDy() * i / dMax));
-      
-      float xDiff = point1.getX() - point2.getX();
-      float yDiff = point1.getY() - point2.getY();
-      
-      float distSquared = (xDiff * xDiff) +(yDiff * yDiff);
-      
-      distMin = std::min(distMin, distSquared);
-   }
-   
-   return sqrt(distMin);
 }
\ No newline at end of file
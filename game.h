@@ -19,6 +19,26 @@
 #include "ship.h"
 #include "levels.h"
 #include "stars.h"
+#include "spatialGrid.h"
+#include "gravity.h"
+#include "particles.h"
+#include "world.h"
+#include "detail.h"
+#include "beam.h"
+#include "missile.h"
+#include "shockwave.h"
+#include "saucer.h"
+#include "flock.h"
+#include "threat.h"
+#include "drawBuffer.h"
+#include "kinetic.h"
+#include "collision.h"
+
+//The layers of the world's draw batch, lowest is drawn first
+constexpr int LAYER_ROCKS = 0;
+constexpr int LAYER_SHOTS = 1;
+constexpr int LAYER_SAUCERS = 2;
+constexpr int LAYER_EFFECTS = 3;
 
  /*****************************************
   * GAME
@@ -54,6 +74,16 @@ public:
 	 *********************************************/
 	void draw(const Interface & ui);
 
+	/*********************************************
+	 * Function: stress
+	 * Description: Tops the game up to the given number
+	 *  of rocks, bullets and stars. Used by the stress test.
+	 *********************************************/
+	void stress(int rockCount, int bulletCount, int starCount);
+
+	//How many rocks, bullets and stars are alive
+	int getEntityCount() const;
+
 private:
 	// The coordinates of the screen
 	Point topLeft;
@@ -96,16 +126,114 @@ private:
 	//Will hold all active stars
 	std::vector<Stars *> stars;
 
+	//Used to find rocks that are close to each other
+	SpatialGrid rockGrid;
+
+	//Where the black holes are when gravity is turned on
+	std::vector<Point> blackHoles;
+
+	//Works out the pull of gravity, the lists are kept to save allocating
+	GravityField gravity;
+	std::vector<GravitySource> gravitySources;
+	std::vector<GravityTarget> gravityTargets;
+	std::vector<Velocity> gravityPulls;
+
+	//The rocks a bounce changed the speed of this tick
+	std::vector<Rocks *> bounced;
+
+	//Sparks, dust and engine exhaust
+	Particles particles;
+
+	//The big world, rocks far from the ship sleep in it
+	World world;
+	bool bigWorld;
+
+	//The corners of the world everything wraps at (the screen unless the world is big)
+	Point worldTopLeft;
+	Point worldBottomRight;
+
+	//Where the middle of the screen is in the world
+	Point camera;
+
+	//Says which stars are far enough away to be moved less often, and
+	//which rocks are too far away to be hit
+	DetailMap detail;
+	bool useDetail;
+
+	//The rocks close enough to the ship or a bullet to be hit this tick
+	std::vector<Rocks *> nearRocks;
+
+	//The beam weapon, where it is and what it hit this tick
+	bool beamOn;
+	Point beamStart;
+	Point beamEnd;
+	std::vector<BeamHit> beamHits;
+
+	//Homing missiles, and how many are after each rock this tick
+	std::vector<Missile> missiles;
+	std::vector<int> missileClaims;
+	std::vector<GridEntry> missileTarget;
+
+	//The shock wave (F) and the rocks its front is over this tick
+	ShockWave shockWave;
+	std::vector<int> waveHits;
+
+	//The enemy saucers (U), what they have shot, and what steers them
+	std::vector<Saucer> saucers;
+	std::vector<SaucerShot> saucerShots;
+	Flock flock;
+
+	//Bullets and missiles against the rocks worked out ahead of time while
+	//nothing bounces or pulls. It is started over whenever it is turned
+	//back on. The lists find the rock or shot for each id, and the tick
+	//each rock next wraps at, and the epoch is the tick its time is
+	//counted from.
+	KineticCollisions kinetic;
+	bool kineticOn;
+	unsigned int kineticEpoch;
+	std::vector<Rocks *> kineticRocks;
+	std::vector<unsigned int> kineticWraps;
+	std::vector<Bullet *> kineticShots;
+
+	//Which rocks are going to come near the ship (T points them out)
+	ThreatTracker threats;
+	int shipWatcher;
+	std::vector<Threat> shipThreats;
+
+	//The dots, lines and rocks of a frame, sent out together
+	DrawBuffer batch;
 
 	/*************************************************
 	 * Private methods to help with the game logic.
 	 *************************************************/
-	bool isOnScreen(const Point & point, int radius);
 	void advanceBullets();
+	void advanceMissiles();
+	void advanceShockWave();
+	void advanceSaucers(const Interface & ui);
+	void makeFlock();
 	void advanceBackground();
 	void advanceRocks(const Interface & ui);
 	void advanceShip();
 	void advanceStars(const Interface & ui);
+	void applyGravity();
+	void setBigWorld(bool on);
+	bool isInView(const Point & point, int radius) const;
+	void buildDetail(const Interface & ui);
+	bool move(FlyingObject & object, int radius);
+	void catchUp(FlyingObject & object, int radius);
+	bool followRock(Rocks & rock);
+	void fireBeam(const Interface & ui);
+	void buildRockGrid();
+	void addRock(Rocks * rock);
+	void trackAllRocks();
+	float kineticTime() const;
+	Point kineticStart(const Point & at, const Velocity & speed) const;
+	void startKinetic();
+	void addKinetic(Rocks * rock);
+	void moveKinetic(FlyingObject & object, const Point & at);
+	void dropKinetic(FlyingObject & object);
+	void syncShot(Bullet & shot);
+	void hitRocksAhead(const RockHitCallback & onRockHit);
 
 	/****************************************
 	* Private methods to create objects
@@ -126,9 +254,6 @@ private:
 
 	//This method will clear out all dead objects
 	void cleanUpZombies(const Interface & ui);
-
-	//This method will help with high velocity collision detection
-	float getClosestDistance(const FlyingObject & obj1, const FlyingObject & obj2) const;
 };
 
 
@@ -0,0 +1,253 @@
+/*********************************************************************
+ * File: gravity.cpp
+ * Description: Contains the implementaiton of the gravity field
+ *  class methods.
+ *********************************************************************/
+#include "gravity.h"
+#include "parallel.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//What a leaf's source is set to when it holds nothing, or more than one
+constexpr int LEAF_EMPTY = -1;
+constexpr int LEAF_MANY = -2;
+
+//Squares are never split smaller than this, sources closer together
+//than this are just lumped into one leaf
+constexpr float GRAVITY_MIN_SIZE = 0.5;
+
+//Deep enough for any tree that stops at GRAVITY_MIN_SIZE
+constexpr int GRAVITY_STACK_SIZE = 256;
+
+//Fewest targets worth giving their own thread
+constexpr int GRAVITY_MIN_CHUNK = 512;
+
+/******************************************
+ * BUILD
+ ******************************************/
+void GravityField::build(const std::vector<GravitySource> & sources)
+{
+	nodes.clear();
+	treeOrder.clear();
+	sourceCount = (int)sources.size();
+	if (sources.empty())
+		return;
+
+	float minX = sources[0].x;
+	float maxX = sources[0].x;
+	float minY = sources[0].y;
+	float maxY = sources[0].y;
+	for (int i = 1; i < (int)sources.size(); i++)
+	{
+		minX = std::min(minX, sources[i].x);
+		maxX = std::max(maxX, sources[i].x);
+		minY = std::min(minY, sources[i].y);
+		maxY = std::max(maxY, sources[i].y);
+	}
+
+	Node root;
+	root.centerX = (minX + maxX) / 2.0f;
+	root.centerY = (minY + maxY) / 2.0f;
+	root.halfSize = std::max(maxX - minX, maxY - minY) / 2.0f + 1.0f;
+	root.massX = 0;
+	root.massY = 0;
+	root.mass = 0;
+	root.firstChild = -1;
+	root.source = LEAF_EMPTY;
+	nodes.reserve(sources.size() * 2);
+	nodes.push_back(root);
+
+	for (int i = 0; i < (int)sources.size(); i++)
+		insert(i, sources[i]);
+
+	// the sums become centers of mass
+	for (int i = 0; i < (int)nodes.size(); i++)
+	{
+		if (nodes[i].mass > 0.0f)
+		{
+			nodes[i].massX /= nodes[i].mass;
+			nodes[i].massY /= nodes[i].mass;
+		}
+	}
+
+	// list the sources leaf by leaf. Neighbors in this list are neighbors
+	// in space, so they walk nearly the same part of the tree.
+	std::vector<int> stack(1, 0);
+	while (!stack.empty())
+	{
+		int node = stack.back();
+		stack.pop_back();
+		if (nodes[node].firstChild != -1)
+		{
+			for (int i = 3; i >= 0; i--)
+				stack.push_back(nodes[node].firstChild + i);
+		}
+		else if (nodes[node].source >= 0)
+			treeOrder.push_back(nodes[node].source);
+	}
+}
+
+/******************************************
+ * INSERT
+ * Walk down from the root adding this source's mass to every square it
+ * is in. If it lands in a leaf that already has a source, the leaf is
+ * split and the old source moves down a level.
+ ******************************************/
+void GravityField::insert(int source, const GravitySource & body)
+{
+	int node = 0;
+	while (true)
+	{
+		nodes[node].mass += body.mass;
+		nodes[node].massX += body.mass * body.x;
+		nodes[node].massY += body.mass * body.y;
+
+		if (nodes[node].firstChild == -1)
+		{
+			if (nodes[node].source == LEAF_EMPTY)
+			{
+				nodes[node].source = source;
+				return;
+			}
+			if (nodes[node].halfSize < GRAVITY_MIN_SIZE || nodes[node].source == LEAF_MANY)
+			{
+				nodes[node].source = LEAF_MANY;
+				return;
+			}
+
+			// split, and move what was here into its child
+			int old = nodes[node].source;
+			float oldX = nodes[node].massX - body.mass * body.x;
+			float oldY = nodes[node].massY - body.mass * body.y;
+			float oldMass = nodes[node].mass - body.mass;
+			int first = makeChildren(node);
+			oldX /= oldMass;
+			oldY /= oldMass;
+			int child = first + (oldX >= nodes[node].centerX ? 1 : 0) + (oldY >= nodes[node].centerY ? 2 : 0);
+			nodes[child].mass = oldMass;
+			nodes[child].massX = oldMass * oldX;
+			nodes[child].massY = oldMass * oldY;
+			nodes[child].source = old;
+		}
+
+		node = nodes[node].firstChild +
+		       (body.x >= nodes[node].centerX ? 1 : 0) + (body.y >= nodes[node].centerY ? 2 : 0);
+	}
+}
+
+int GravityField::makeChildren(int node)
+{
+	int first = (int)nodes.size();
+	float quarter = nodes[node].halfSize / 2.0f;
+	for (int i = 0; i < 4; i++)
+	{
+		Node child;
+		child.centerX = nodes[node].centerX + ((i & 1) ? quarter : -quarter);
+		child.centerY = nodes[node].centerY + ((i & 2) ? quarter : -quarter);
+		child.halfSize = quarter;
+		child.massX = 0;
+		child.massY = 0;
+		child.mass = 0;
+		child.firstChild = -1;
+		child.source = LEAF_EMPTY;
+		nodes.push_back(child);
+	}
+	nodes[node].firstChild = first;
+	nodes[node].source = LEAF_EMPTY;
+	return first;
+}
+
+/******************************************
+ * PULL
+ * A square is used as a whole when it looks smaller than theta from
+ * where the target is. Otherwise its children are looked at instead.
+ ******************************************/
+Velocity GravityField::pull(const GravityTarget & target) const
+{
+	if (nodes.empty())
+		return Velocity();
+
+	float ax = 0;
+	float ay = 0;
+	float thetaSquared = theta * theta;
+
+	int stack[GRAVITY_STACK_SIZE];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const Node & node = nodes[stack[--top]];
+		if (node.mass <= 0.0f || (node.firstChild == -1 && node.source == target.self))
+			continue;
+
+		float xDiff = node.massX - target.x;
+		float yDiff = node.massY - target.y;
+		float distSquared = (xDiff * xDiff) + (yDiff * yDiff);
+		float size = node.halfSize * 2.0f;
+
+		if (node.firstChild == -1 || size * size < thetaSquared * distSquared ||
+		    top > GRAVITY_STACK_SIZE - 4)
+		{
+			distSquared += GRAVITY_SOFTENING * GRAVITY_SOFTENING;
+			float strength = GRAVITY_STRENGTH * node.mass / (distSquared * sqrt(distSquared));
+			ax += strength * xDiff;
+			ay += strength * yDiff;
+		}
+		else
+		{
+			for (int i = 0; i < 4; i++)
+				stack[top++] = node.firstChild + i;
+		}
+	}
+	return Velocity(ax, ay);
+}
+
+/******************************************
+ * PULL ALL
+ * Targets that are also sources are done in tree order, which keeps
+ * the tree in the cache far better than going in list order.
+ ******************************************/
+void GravityField::pullAll(const std::vector<GravityTarget> & targets, std::vector<Velocity> & pulls) const
+{
+	std::vector<int> targetOf(sourceCount, -1);
+	std::vector<int> order;
+	order.reserve(targets.size());
+	for (int i = 0; i < (int)targets.size(); i++)
+	{
+		if (targets[i].self >= 0 && targets[i].self < sourceCount)
+			targetOf[targets[i].self] = i;
+		else
+			order.push_back(i);
+	}
+	for (int i = 0; i < (int)treeOrder.size(); i++)
+	{
+		if (targetOf[treeOrder[i]] != -1)
+			order.push_back(targetOf[treeOrder[i]]);
+	}
+	// sources that share a leaf are not in treeOrder, pick them up too
+	if (order.size() < targets.size())
+	{
+		std::vector<bool> done(targets.size(), false);
+		for (int i = 0; i < (int)order.size(); i++)
+			done[order[i]] = true;
+		for (int i = 0; i < (int)targets.size(); i++)
+			if (!done[i])
+				order.push_back(i);
+	}
+
+	pulls.resize(targets.size());
+	parallelFor((int)order.size(), GRAVITY_MIN_CHUNK, [this, &targets, &pulls, &order](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+			pulls[order[i]] = pull(targets[order[i]]);
+	});
+}
@@ -0,0 +1,89 @@
+/***********************************************************************
+ * Header File:
+ *    Gravity : pulls everything toward black holes and heavy rocks
+ * Summary:
+ *    Adding up the pull of every source on every object would be far too
+ *    slow for a big field, so the sources are put in a quadtree
+ *    (Barnes-Hut). A clump of sources that is far enough away is treated
+ *    like one big source at its center of mass. How far is "far enough"
+ *    is set by theta, the opening angle: 0 is exact (and slow), bigger
+ *    is faster and rougher. The pull on each object is worked out on
+ *    every core at once.
+ ************************************************************************/
+#ifndef GRAVITY_H
+#define GRAVITY_H
+
+#include "velocity.h"
+#include <vector>
+
+//Default opening angle
+constexpr float GRAVITY_THETA = 0.5;
+
+//How strong gravity is. Pull is GRAVITY_STRENGTH * mass / distance^2
+constexpr float GRAVITY_STRENGTH = 1.0;
+
+//Keeps the pull from blowing up when something gets very close
+constexpr float GRAVITY_SOFTENING = 10.0;
+
+//How heavy a black hole is compared to the rocks (see rocks.h)
+constexpr float BLACK_HOLE_MASS = 200.0;
+constexpr int BLACK_HOLE_SIZE = 8;
+
+//Something that pulls
+struct GravitySource
+{
+	float x;
+	float y;
+	float mass;
+};
+
+//Something that is pulled. self is its place in the list of sources,
+//or -1 if it does not pull anything (so it does not pull on itself).
+struct GravityTarget
+{
+	float x;
+	float y;
+	int self;
+};
+
+class GravityField
+{
+public:
+	GravityField(float theta = GRAVITY_THETA) : theta(theta), sourceCount(0) {   }
+
+	void setTheta(float theta_) { theta = theta_; }
+	float getTheta() const { return theta; }
+
+	//Put the sources in the tree. Has to be called before pull().
+	void build(const std::vector<GravitySource> & sources);
+
+	//How much speed one target gains this tick
+	Velocity pull(const GravityTarget & target) const;
+
+	//pull() for every target, spread across all the cores
+	void pullAll(const std::vector<GravityTarget> & targets, std::vector<Velocity> & pulls) const;
+
+private:
+	//One square of the tree. The four children are stored together.
+	struct Node
+	{
+		float centerX;   // middle of the square
+		float centerY;
+		float halfSize;
+		float massX;     // while building: sum of mass * x, then center of mass
+		float massY;
+		float mass;
+		int firstChild;  // -1 if this is a leaf
+		int source;      // which source is in a leaf, see below
+	};
+
+	void insert(int source, const GravitySource & body);
+	int makeChildren(int node);
+
+	float theta;
+	std::vector<Node> nodes;
+	std::vector<int> treeOrder;  // sources in the order they sit in the tree
+	int sourceCount;
+};
+
+#endif // GRAVITY_H
@@ -0,0 +1,360 @@
+/*********************************************************************
+ * File: kernelCheck.cpp
+ * Description: Contains the implementaiton of the kernel check
+ *  functions.
+ *********************************************************************/
+#include "kernelCheck.h"
+#include "collision.h"
+#include "ship.h"
+
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//The scenes use the same screen as the game
+constexpr float CHECK_SCREEN = 400.0;
+
+//How many kinds of scenes makeScene can make
+constexpr int SCENE_KINDS = 5;
+
+const char * SIZE_NAMES[] = { "bullet", "small rock", "medium rock", "big rock" };
+
+/******************************************
+ * Helpers to make the objects for a scene
+ ******************************************/
+static Bullet makeBullet(const SceneObject & object)
+{
+	Bullet bullet;
+	bullet.setPoint(Point(object.x, object.y));
+	bullet.setVelocity(Velocity(object.dx, object.dy));
+	return bullet;
+}
+
+static Rocks * makeRock(const SceneObject & object)
+{
+	Point point(object.x, object.y);
+	Rocks * rock = NULL;
+	switch (object.size)
+	{
+	case 1:
+		rock = new SmallRock(point);
+		break;
+	case 2:
+		rock = new MediumRock(point);
+		break;
+	default:
+		rock = new BigRock(point);
+		break;
+	}
+	rock->setVelocity(Velocity(object.dx, object.dy));
+	return rock;
+}
+
+static int radiusOf(int size)
+{
+	switch (size)
+	{
+	case 0:
+		return 2;
+	case 1:
+		return SMALL_ROCK_SIZE;
+	case 2:
+		return MEDIUM_ROCK_SIZE;
+	default:
+		return BIG_ROCK_SIZE;
+	}
+}
+
+/******************************************
+ * MAKE SCENE
+ ******************************************/
+Scene makeScene(unsigned int seed)
+{
+	std::mt19937 generator(seed);
+	auto between = [&generator](float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(generator);
+	};
+	auto count = [&generator](int min, int max)
+	{
+		return std::uniform_int_distribution<int>(min, max)(generator);
+	};
+	auto object = [&](int size, float x, float y, float speed)
+	{
+		float angle = between(0.0f, 2.0f * (float)M_PI);
+		SceneObject made = { x, y, speed * (float)cos(angle), speed * (float)sin(angle), size };
+		return made;
+	};
+
+	Scene scene;
+	scene.seed = seed;
+	int bullets = count(1, 30);
+	int rocks = count(1, 50);
+
+	switch (seed % SCENE_KINDS)
+	{
+	case 0: // just random
+		for (int i = 0; i < bullets; i++)
+			scene.bullets.push_back(object(0, between(-CHECK_SCREEN, CHECK_SCREEN),
+			                               between(-CHECK_SCREEN, CHECK_SCREEN), between(0.0f, 10.0f)));
+		for (int i = 0; i < rocks; i++)
+			scene.rocks.push_back(object(count(1, 3), between(-CHECK_SCREEN, CHECK_SCREEN),
+			                             between(-CHECK_SCREEN, CHECK_SCREEN), between(0.0f, 2.0f)));
+		break;
+
+	case 1: // every rock is exactly touching a bullet, or just barely not
+		for (int i = 0; i < bullets; i++)
+		{
+			SceneObject bullet = object(0, between(-300.0f, 300.0f), between(-300.0f, 300.0f), 0.0f);
+			scene.bullets.push_back(bullet);
+			int size = count(1, 3);
+			float angle = between(0.0f, 2.0f * (float)M_PI);
+			float gap = radiusOf(size) + (count(0, 2) - 1) * 0.001f;
+			scene.rocks.push_back(object(size, bullet.x + gap * (float)cos(angle),
+			                             bullet.y + gap * (float)sin(angle), count(0, 1) * between(0.0f, 1.0f)));
+		}
+		break;
+
+	case 2: // bullets fast enough to jump over a rock in one frame
+		for (int i = 0; i < bullets; i++)
+			scene.bullets.push_back(object(0, between(-CHECK_SCREEN, CHECK_SCREEN),
+			                               between(-CHECK_SCREEN, CHECK_SCREEN), between(20.0f, 200.0f)));
+		for (int i = 0; i < rocks; i++)
+			scene.rocks.push_back(object(count(1, 3), between(-CHECK_SCREEN, CHECK_SCREEN),
+			                             between(-CHECK_SCREEN, CHECK_SCREEN), between(0.0f, 4.0f)));
+		break;
+
+	case 3: // rocks piled on top of each other, so one bullet breaks many
+	{
+		float x = between(-100.0f, 100.0f);
+		float y = between(-100.0f, 100.0f);
+		for (int i = 0; i < rocks; i++)
+			scene.rocks.push_back(object(count(1, 3), x + between(-2.0f, 2.0f), y + between(-2.0f, 2.0f),
+			                             between(0.0f, 2.0f)));
+		for (int i = 0; i < bullets; i++)
+			scene.bullets.push_back(object(0, x + between(-20.0f, 20.0f), y + between(-20.0f, 20.0f),
+			                               between(0.0f, 8.0f)));
+		break;
+	}
+
+	default: // everything sitting on the edge of the screen
+		for (int i = 0; i < bullets + rocks; i++)
+		{
+			int size = i < bullets ? 0 : count(1, 3);
+			float edge = CHECK_SCREEN + radiusOf(size) + between(-1.0f, 1.0f);
+			float along = between(-CHECK_SCREEN - 20.0f, CHECK_SCREEN + 20.0f);
+			float x = count(0, 1) ? edge : along;
+			float y = x == edge ? along : edge;
+			SceneObject made = object(size, count(0, 1) ? x : -x, count(0, 1) ? y : -y, between(0.0f, 5.0f));
+			if (size == 0)
+				scene.bullets.push_back(made);
+			else
+				scene.rocks.push_back(made);
+		}
+		break;
+	}
+	return scene;
+}
+
+/******************************************
+ * RUN HITS
+ * Every bullet against every rock, in the same order as the game.
+ * Each hit is written down as (bullet, place of the rock in the list).
+ ******************************************/
+static std::vector<std::pair<int, int> > runHits(const Scene & scene, bool candidate)
+{
+	// both runs need the same rock shapes, which set how big each rock is
+	srand(scene.seed);
+	OutlinePool::setSeed(scene.seed);
+	std::vector<Bullet> bullets;
+	std::vector<Rocks *> rocks;
+	for (int i = 0; i < (int)scene.bullets.size(); i++)
+		bullets.push_back(makeBullet(scene.bullets[i]));
+	for (int i = 0; i < (int)scene.rocks.size(); i++)
+		rocks.push_back(makeRock(scene.rocks[i]));
+
+	std::vector<std::pair<int, int> > hits;
+	RockBroadPhase broadPhase;
+	if (candidate)
+		broadPhase.build(rocks);
+
+	for (int i = 0; i < (int)bullets.size(); i++)
+	{
+		if (!bullets[i].isAlive())
+			continue;
+		RockHitCallback onHit = [&hits, &rocks, i](Rocks & rock)
+		{
+			int place = (int)(std::find(rocks.begin(), rocks.end(), &rock) - rocks.begin());
+			hits.push_back(std::make_pair(i, place));
+		};
+		if (candidate)
+			broadPhase.hitRocks(bullets[i], rocks, onHit);
+		else
+			hitRocks(bullets[i], rocks, onHit);
+	}
+
+	for (int i = 0; i < (int)rocks.size(); i++)
+		delete rocks[i];
+	std::sort(hits.begin(), hits.end());
+	return hits;
+}
+
+/******************************************
+ * CHECK SCENE
+ ******************************************/
+int checkScene(const Scene & scene, std::ostream * out)
+{
+	int mismatches = 0;
+
+	// the hit decisions
+	std::vector<std::pair<int, int> > reference = runHits(scene, false);
+	std::vector<std::pair<int, int> > candidate = runHits(scene, true);
+	std::vector<std::pair<int, int> > missed;
+	std::vector<std::pair<int, int> > extra;
+	std::set_difference(reference.begin(), reference.end(), candidate.begin(), candidate.end(),
+	                    std::back_inserter(missed));
+	std::set_difference(candidate.begin(), candidate.end(), reference.begin(), reference.end(),
+	                    std::back_inserter(extra));
+	mismatches += (int)(missed.size() + extra.size());
+	if (out)
+	{
+		for (int i = 0; i < (int)missed.size(); i++)
+			*out << "seed " << scene.seed << ": bullet " << missed[i].first << " hit rock "
+			     << missed[i].second << " in the reference but not in the candidate\n";
+		for (int i = 0; i < (int)extra.size(); i++)
+			*out << "seed " << scene.seed << ": bullet " << extra[i].first << " hit rock "
+			     << extra[i].second << " in the candidate but not in the reference\n";
+	}
+
+	// the distance test on its own, with a rock's reach and a ship's reach
+	srand(scene.seed);
+	for (int i = 0; i < (int)scene.bullets.size(); i++)
+	{
+		Bullet bullet = makeBullet(scene.bullets[i]);
+		for (int j = 0; j < (int)scene.rocks.size(); j++)
+		{
+			Rocks * rock = makeRock(scene.rocks[j]);
+			float reaches[] = { (float)rock->getRadius(), (float)(rock->getRadius() + SHIP_SIZE) };
+			for (float reach : reaches)
+			{
+				bool referenceHit = reach >= getClosestDistance(bullet, *rock);
+				bool candidateHit = isWithinDistance(bullet, *rock, reach);
+				if (referenceHit != candidateHit)
+				{
+					mismatches++;
+					if (out)
+						*out << "seed " << scene.seed << ": bullet " << i << " and rock " << j
+						     << " within " << reach << " is " << referenceHit
+						     << " in the reference but " << candidateHit << " in the candidate\n";
+				}
+			}
+			delete rock;
+		}
+	}
+
+	// going off the screen
+	Point topLeft(-CHECK_SCREEN, CHECK_SCREEN);
+	Point bottomRight(CHECK_SCREEN, -CHECK_SCREEN);
+	for (int i = 0; i < (int)(scene.bullets.size() + scene.rocks.size()); i++)
+	{
+		bool isBullet = i < (int)scene.bullets.size();
+		const SceneObject & object = isBullet ? scene.bullets[i] : scene.rocks[i - scene.bullets.size()];
+		Bullet moved = makeBullet(object);
+		wrapAround(moved, radiusOf(object.size), topLeft, bottomRight);
+		float x = object.x;
+		float y = object.y;
+		wrapCoordinates(x, y, (float)radiusOf(object.size), CHECK_SCREEN, CHECK_SCREEN);
+		if (x != moved.getPoint().getX() || y != moved.getPoint().getY())
+		{
+			mismatches++;
+			if (out)
+				*out << "seed " << scene.seed << ": " << SIZE_NAMES[object.size] << " at ("
+				     << object.x << ", " << object.y << ") wraps to " << moved.getPoint()
+				     << " in the reference but to (" << x << ", " << y << ") in the candidate\n";
+		}
+	}
+
+	return mismatches;
+}
+
+/******************************************
+ * SHRINK SCENE
+ * Keep taking things out as long as something still does not match.
+ ******************************************/
+static Scene shrinkScene(const Scene & scene)
+{
+	Scene smallest = scene;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int i = (int)smallest.bullets.size() - 1; i >= 0; i--)
+		{
+			Scene trial = smallest;
+			trial.bullets.erase(trial.bullets.begin() + i);
+			if (checkScene(trial, NULL) > 0)
+			{
+				smallest = trial;
+				changed = true;
+			}
+		}
+		for (int i = (int)smallest.rocks.size() - 1; i >= 0; i--)
+		{
+			Scene trial = smallest;
+			trial.rocks.erase(trial.rocks.begin() + i);
+			if (checkScene(trial, NULL) > 0)
+			{
+				smallest = trial;
+				changed = true;
+			}
+		}
+	}
+	return smallest;
+}
+
+static void printScene(std::ostream & out, const Scene & scene)
+{
+	out << "  smallest scene for seed " << scene.seed << ":\n";
+	for (int i = 0; i < (int)(scene.bullets.size() + scene.rocks.size()); i++)
+	{
+		bool isBullet = i < (int)scene.bullets.size();
+		const SceneObject & object = isBullet ? scene.bullets[i] : scene.rocks[i - scene.bullets.size()];
+		out << "    " << SIZE_NAMES[object.size] << " at (" << object.x << ", " << object.y
+		    << ") speed (" << object.dx << ", " << object.dy << ")\n";
+	}
+}
+
+/******************************************
+ * VERIFY KERNELS
+ ******************************************/
+int verifyKernels(std::ostream & out, unsigned int firstSeed, int count)
+{
+	int mismatches = 0;
+	int badScenes = 0;
+	out.precision(9);
+	for (unsigned int seed = firstSeed; seed < firstSeed + count; seed++)
+	{
+		Scene scene = makeScene(seed);
+		int found = checkScene(scene, &out);
+		if (found > 0)
+		{
+			mismatches += found;
+			badScenes++;
+			printScene(out, shrinkScene(scene));
+		}
+	}
+	out << count << " scenes checked, " << badScenes << " did not match ("
+	    << mismatches << " decisions)\n";
+	return mismatches;
+}
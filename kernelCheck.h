@@ -0,0 +1,57 @@
+/***********************************************************************
+ * Header File:
+ *    Kernel Check : runs the reference and candidate versions of the
+ *    collision and wrap code side by side (see collision.h)
+ * Summary:
+ *    Scenes of bullets and rocks are made from a seed. Some are just
+ *    random, others are built to be nasty (rocks exactly touching,
+ *    bullets fast enough to jump over rocks, rocks stacked on top of
+ *    each other, everything sitting on the edge of the screen). Every
+ *    decision that does not match is printed with its seed, followed by
+ *    the smallest part of the scene that still does not match.
+ *    This is run with --verify-kernels, see driver.cpp.
+ ************************************************************************/
+#ifndef KERNEL_CHECK_H
+#define KERNEL_CHECK_H
+
+#include <iostream>
+#include <vector>
+
+//One thing in a scene. Size is 0 for a bullet, 1 to 3 for small to big rocks
+struct SceneObject
+{
+	float x;
+	float y;
+	float dx;
+	float dy;
+	int size;
+};
+
+struct Scene
+{
+	unsigned int seed;
+	std::vector<SceneObject> bullets;
+	std::vector<SceneObject> rocks;
+};
+
+/******************************************
+ * MAKE SCENE
+ * The same seed always makes the same scene.
+ ******************************************/
+Scene makeScene(unsigned int seed);
+
+/******************************************
+ * CHECK SCENE
+ * Returns how many decisions did not match. Each one is printed if
+ * out is not NULL.
+ ******************************************/
+int checkScene(const Scene & scene, std::ostream * out);
+
+/******************************************
+ * VERIFY KERNELS
+ * Check count scenes starting at firstSeed. Returns how many
+ * decisions did not match in all of them.
+ ******************************************/
+int verifyKernels(std::ostream & out, unsigned int firstSeed, int count);
+
+#endif // KERNEL_CHECK_H
@@ -0,0 +1,347 @@
+/*********************************************************************
+ * File: kinetic.cpp
+ * Description: Contains the implementaiton of the kinetic collisions
+ *  class methods.
+ *********************************************************************/
+#include "kinetic.h"
+
+#include <algorithm>
+#include <cmath>
+
+KineticCollisions::KineticCollisions()
+	: halfWidth(0), halfHeight(0), cellWidth(1), cellHeight(1), columns(1), rows(1),
+	  now(0), handled(0)
+{
+	cells.resize(1);
+}
+
+void KineticCollisions::setWorld(float halfWidth_, float halfHeight_, float cellSize)
+{
+	halfWidth = halfWidth_;
+	halfHeight = halfHeight_;
+	columns = std::max(1, (int)(2 * halfWidth / cellSize));
+	rows = std::max(1, (int)(2 * halfHeight / cellSize));
+	cellWidth = 2 * halfWidth / columns;
+	cellHeight = 2 * halfHeight / rows;
+
+	now = 0;
+	bodies.clear();
+	unused.clear();
+	events.clear();
+	cells.assign(columns * rows, std::vector<int>());
+}
+
+int KineticCollisions::add(int kind, const Point & point, const Velocity & velocity, float radius)
+{
+	int id;
+	if (unused.empty())
+	{
+		id = (int)bodies.size();
+		bodies.push_back(Body());
+		bodies[id].version = 0;
+	}
+	else
+	{
+		id = unused.back();
+		unused.pop_back();
+	}
+
+	Body & body = bodies[id];
+	body.radius = radius;
+	body.kind = kind;
+	body.alive = true;
+	body.cell = -1;
+	setMotion(id, point, velocity);
+	return id;
+}
+
+void KineticCollisions::remove(int id)
+{
+	if (!bodies[id].alive)
+		return;
+	unplace(id);
+	bodies[id].alive = false;
+	bodies[id].version++;
+	unused.push_back(id);
+}
+
+/******************************************
+ * SET MOTION
+ * Start the body on a new line from now. Everything it was going to
+ * hit is forgotten (its version changes), so look again in every cell
+ * around it.
+ ******************************************/
+void KineticCollisions::setMotion(int id, const Point & point, const Velocity & velocity)
+{
+	Body & body = bodies[id];
+	Point folded = fold(point.getX(), point.getY());
+	body.x = folded.getX();
+	body.y = folded.getY();
+	body.dx = velocity.getDx();
+	body.dy = velocity.getDy();
+	body.since = now;
+	body.version++;
+
+	int cell = cellOf(folded);
+	if (body.cell != cell)
+	{
+		if (body.cell >= 0)
+			unplace(id);
+		place(id, cell);
+	}
+	start(id);
+
+	int around[9];
+	neighbors(cell, around);
+	for (int i = 0; i < 9 && around[i] >= 0; i++)
+		predictCell(id, around[i]);
+}
+
+Point KineticCollisions::getPoint(int id) const
+{
+	return position(bodies[id], now);
+}
+
+Velocity KineticCollisions::getVelocity(int id) const
+{
+	return Velocity(bodies[id].dx, bodies[id].dy);
+}
+
+/******************************************
+ * ADVANCE
+ * Handle everything in the queue up to time to, soonest first. Old
+ * events (one of the bodies changed since) are just thrown away.
+ ******************************************/
+void KineticCollisions::advance(float to, const KineticCallback & onContact)
+{
+	auto later = [](const Event & a, const Event & b) { return a.time > b.time; };
+	while (!events.empty() && events.front().time <= to)
+	{
+		std::pop_heap(events.begin(), events.end(), later);
+		Event event = events.back();
+		events.pop_back();
+
+		const Body & a = bodies[event.a];
+		if (!a.alive || a.version != event.versionA)
+			continue;
+		if (event.b >= 0 && (!bodies[event.b].alive || bodies[event.b].version != event.versionB))
+			continue;
+
+		now = std::max(now, event.time);
+		handled++;
+		if (event.b < 0)
+			crossing(event.a, event.b == -1);
+		else
+			onContact(event.a, event.b);
+	}
+	now = std::max(now, to);
+}
+
+/******************************************
+ * POSITION
+ * Where the body is at time, wrapped back into the world
+ ******************************************/
+Point KineticCollisions::position(const Body & body, float time) const
+{
+	return fold(body.x + body.dx * (time - body.since), body.y + body.dy * (time - body.since));
+}
+
+Point KineticCollisions::fold(float x, float y) const
+{
+	float width = 2 * halfWidth;
+	float height = 2 * halfHeight;
+	x = std::fmod(x + halfWidth, width);
+	y = std::fmod(y + halfHeight, height);
+	if (x < 0)
+		x += width;
+	if (y < 0)
+		y += height;
+	return Point(x - halfWidth, y - halfHeight);
+}
+
+int KineticCollisions::cellOf(const Point & point) const
+{
+	int col = (int)((point.getX() + halfWidth) / cellWidth);
+	int row = (int)((point.getY() + halfHeight) / cellHeight);
+	col = std::max(0, std::min(columns - 1, col));
+	row = std::max(0, std::min(rows - 1, row));
+	return row * columns + col;
+}
+
+/******************************************
+ * NEIGHBORS
+ * The cell and the ones around it, across the edges too, each only
+ * once. The list ends early with -1 when the grid is small.
+ ******************************************/
+void KineticCollisions::neighbors(int cell, int found[9]) const
+{
+	int col = cell % columns;
+	int row = cell / columns;
+	int count = 0;
+	for (int dRow = -1; dRow <= 1; dRow++)
+		for (int dCol = -1; dCol <= 1; dCol++)
+		{
+			int near = ((row + dRow + rows) % rows) * columns + (col + dCol + columns) % columns;
+			if (std::find(found, found + count, near) == found + count)
+				found[count++] = near;
+		}
+	for (int i = count; i < 9; i++)
+		found[i] = -1;
+}
+
+void KineticCollisions::place(int id, int cell)
+{
+	bodies[id].cell = cell;
+	bodies[id].inCell = (int)cells[cell].size();
+	cells[cell].push_back(id);
+}
+
+void KineticCollisions::unplace(int id)
+{
+	std::vector<int> & list = cells[bodies[id].cell];
+	int last = list.back();
+	list[bodies[id].inCell] = last;
+	bodies[last].inCell = bodies[id].inCell;
+	list.pop_back();
+	bodies[id].cell = -1;
+}
+
+/******************************************
+ * START
+ * Queue when the body next goes over an edge of its cell, and which way
+ * (b is -1 across a side, -2 across the top or bottom). The cell it is in
+ * is worked from its number and not where it is, so a body right on an
+ * edge cannot be put back in the same cell over and over.
+ ******************************************/
+void KineticCollisions::start(int id)
+{
+	const Body & body = bodies[id];
+	auto untilEdge = [](float inside, float speed, float size, float world) -> float
+	{
+		// inside is where it is from the cell's low edge, the short way around
+		if (inside > world / 2)
+			inside -= world;
+		else if (inside < -world / 2)
+			inside += world;
+		if (speed > 0)
+			return std::max(0.0f, (size - inside) / speed);
+		if (speed < 0)
+			return std::max(0.0f, inside / -speed);
+		return -1;
+	};
+	Point at = position(body, now);
+	float toX = untilEdge(at.getX() + halfWidth - (body.cell % columns) * cellWidth,
+	                      body.dx, cellWidth, 2 * halfWidth);
+	float toY = untilEdge(at.getY() + halfHeight - (body.cell / columns) * cellHeight,
+	                      body.dy, cellHeight, 2 * halfHeight);
+	if (toX < 0 && toY < 0)
+		return;
+	if (toY < 0 || (toX >= 0 && toX <= toY))
+		push({ now + toX, id, -1, body.version, 0 });
+	else
+		push({ now + toY, id, -2, body.version, 0 });
+}
+
+/******************************************
+ * CROSSING
+ * The body went into the next cell. It has already been checked against
+ * everything in the cells it was next to, so only check it against the
+ * ones it is next to now and was not before.
+ ******************************************/
+void KineticCollisions::crossing(int id, bool side)
+{
+	// start the line again from here so it never gets far from the world,
+	// it is the same line so nothing it was going to hit changes
+	Body & body = bodies[id];
+	Point here = position(body, now);
+	body.x = here.getX();
+	body.y = here.getY();
+	body.since = now;
+
+	int from = body.cell;
+	int col = from % columns;
+	int row = from / columns;
+	if (side)
+		col = (col + (body.dx > 0 ? 1 : columns - 1)) % columns;
+	else
+		row = (row + (body.dy > 0 ? 1 : rows - 1)) % rows;
+	int to = row * columns + col;
+	if (to != from)
+	{
+		unplace(id);
+		place(id, to);
+
+		int before[9];
+		int after[9];
+		neighbors(from, before);
+		neighbors(to, after);
+		for (int i = 0; i < 9 && after[i] >= 0; i++)
+		{
+			if (std::find(before, before + 9, after[i]) == before + 9)
+				predictCell(id, after[i]);
+		}
+	}
+	start(id);
+}
+
+void KineticCollisions::predictCell(int id, int cell)
+{
+	const std::vector<int> & list = cells[cell];
+	for (int i = 0; i < (int)list.size(); i++)
+	{
+		if (bodies[list[i]].kind != bodies[id].kind)
+			predict(id, list[i]);
+	}
+}
+
+/******************************************
+ * PREDICT
+ * When the two will first touch, if they ever do on the lines they are
+ * on. The gap between them is taken the short way around the world.
+ ******************************************/
+void KineticCollisions::predict(int a, int b)
+{
+	if (bodies[a].kind != KINETIC_ROCK)
+		std::swap(a, b);
+	const Body & rock = bodies[a];
+	const Body & shot = bodies[b];
+
+	Point rockAt = position(rock, now);
+	Point shotAt = position(shot, now);
+	float px = shotAt.getX() - rockAt.getX();
+	float py = shotAt.getY() - rockAt.getY();
+	if (px > halfWidth)
+		px -= 2 * halfWidth;
+	else if (px < -halfWidth)
+		px += 2 * halfWidth;
+	if (py > halfHeight)
+		py -= 2 * halfHeight;
+	else if (py < -halfHeight)
+		py += 2 * halfHeight;
+
+	float vx = shot.dx - rock.dx;
+	float vy = shot.dy - rock.dy;
+	float reach = rock.radius + shot.radius;
+	float c = px * px + py * py - reach * reach;
+	float ticks = 0;
+	if (c > 0)
+	{
+		// closing in, and close enough at the nearest point to touch
+		float speedSq = vx * vx + vy * vy;
+		float closing = px * vx + py * vy;
+		if (closing >= 0 || speedSq == 0)
+			return;
+		float discriminant = closing * closing - speedSq * c;
+		if (discriminant < 0)
+			return;
+		ticks = (-closing - std::sqrt(discriminant)) / speedSq;
+	}
+	push({ now + ticks, a, b, rock.version, shot.version });
+}
+
+void KineticCollisions::push(const Event & event)
+{
+	events.push_back(event);
+	std::push_heap(events.begin(), events.end(),
+	               [](const Event & a, const Event & b) { return a.time > b.time; });
+}
@@ -0,0 +1,138 @@
+/***********************************************************************
+ * Header File:
+ *    Kinetic : bullets against rocks found ahead of time instead of
+ *    looked for every tick
+ * Summary:
+ *    Between the times something is made, killed, split or sped up,
+ *    everything goes in a straight line, so the moment a bullet will
+ *    touch a rock can be worked out once, when they come near each other,
+ *    and put in a queue. Nothing is moved or checked on the ticks in
+ *    between. "Near" is a grid of cells like the spatial grid's, except
+ *    each body only moves to the next cell when the queue says it gets
+ *    there, and then only the cells it is newly next to are looked in.
+ *
+ *    So the work goes with how many things happen (cells crossed and
+ *    hits) and not with how many things there are times how many ticks.
+ *    That wins when things are spread out and each one seldom crosses a
+ *    cell. What it costs is putting everything in the first time, and
+ *    looking in all nine cells again whenever something changes speed,
+ *    so it loses when most things change speed every tick (gravity).
+ *    Run --bench-kinetic to see how it compares.
+ *
+ *    The game uses it for bullets and missiles against the rocks while
+ *    bouncing and gravity are off. The ship is not in it: it is checked
+ *    against the rocks near it every tick, since it can sit inside a
+ *    rock while it cannot die and has to be hit once that wears off.
+ *
+ *    The world wraps the way World::fold() does it, by joining the
+ *    edges, and bodies near an edge see the ones across it.
+ ************************************************************************/
+#ifndef KINETIC_H
+#define KINETIC_H
+
+#include "point.h"
+#include "velocity.h"
+
+#include <vector>
+#include <functional>
+
+//What kind of body it is. Only a rock and a shot can touch.
+constexpr int KINETIC_ROCK = 0;
+constexpr int KINETIC_SHOT = 1;
+
+//How wide the game's cells are, which has to be more than any rock's radius
+constexpr float KINETIC_CELL_SIZE = 64.0;
+
+//The game starts the clock over after this many ticks, while a float
+//still has plenty of room for the part of a tick a hit comes at
+constexpr float KINETIC_RESTART_TIME = 65536.0;
+
+//What is called when a shot touches a rock, with their ids. The time is
+//already moved up to when it happened, and bodies can be added, removed
+//or sped up from in here.
+using KineticCallback = std::function<void(int rock, int shot)>;
+
+class KineticCollisions
+{
+public:
+	KineticCollisions();
+
+	//The world is the box centered on (0, 0) with these half sizes. The
+	//cells are made a little bigger than cellSize so a whole number fit.
+	//cellSize has to be at least the biggest rock and shot radius added.
+	//This takes everything out and starts the time over at 0.
+	void setWorld(float halfWidth, float halfHeight, float cellSize);
+
+	//Put a body in at the current time, returns its id
+	int add(int kind, const Point & point, const Velocity & velocity, float radius);
+	void remove(int id);
+
+	//It was sped up, turned or moved (it is also put at point)
+	void setMotion(int id, const Point & point, const Velocity & velocity);
+
+	//Where it is at the current time
+	Point getPoint(int id) const;
+	Velocity getVelocity(int id) const;
+
+	//Go up to time to, calling onContact at each hit in the order they happen
+	void advance(float to, const KineticCallback & onContact);
+
+	float getTime() const { return now; }
+	int getEvents() const { return handled; }
+
+private:
+	struct Body
+	{
+		float x;              // where it was at since, not wrapped
+		float y;
+		float dx;
+		float dy;
+		float since;
+		float radius;
+		int kind;
+		int cell;
+		int inCell;           // where it is in its cell's list
+		unsigned int version; // goes up each time its line changes
+		bool alive;
+	};
+
+	//A hit between a and b, or a crossing into the next cell when b < 0
+	//(-1 across a side, -2 across the top or bottom).
+	//It is old if either body's version has changed since.
+	struct Event
+	{
+		float time;
+		int a;
+		int b;
+		unsigned int versionA;
+		unsigned int versionB;
+	};
+
+	Point position(const Body & body, float time) const;
+	Point fold(float x, float y) const;
+	int cellOf(const Point & point) const;
+	void neighbors(int cell, int found[9]) const;
+	void place(int id, int cell);
+	void unplace(int id);
+	void start(int id);
+	void crossing(int id, bool side);
+	void predict(int a, int b);
+	void predictCell(int id, int cell);
+	void push(const Event & event);
+
+	float halfWidth;
+	float halfHeight;
+	float cellWidth;
+	float cellHeight;
+	int columns;
+	int rows;
+	float now;
+	int handled;
+
+	std::vector<Body> bodies;
+	std::vector<int> unused;              // free ids
+	std::vector<std::vector<int> > cells; // the ids in each cell
+	std::vector<Event> events;            // a heap, soonest first
+};
+
+#endif // KINETIC_H
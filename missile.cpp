@@ -0,0 +1,68 @@
+/*********************************************************************
+ * File: missile.cpp
+ * Description: Contains the implementaiton of the missile class
+ *  methods.
+ *********************************************************************/
+#include "missile.h"
+#include "uiInteract.h"
+#include "trig.h"
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+Missile::Missile(const Point & point_, const float & angle_)
+{
+	point = point_;
+	angle = angle_;
+	currentLife = 0;
+	alive = true;
+	speed.setDx((MISSILE_SPEED / FRAMES_VARIABLES_MULTIPLIER) * cosDeg(angle));
+	speed.setDy((MISSILE_SPEED / FRAMES_VARIABLES_MULTIPLIER) * sinDeg(angle));
+}
+
+//Turn the short way round toward the target
+void Missile::steer(const Point & target)
+{
+	float wanted = (float)(atan2(target.getY() - point.getY(), target.getX() - point.getX()) * 180.0 / M_PI);
+	float turn = fmod(wanted - angle, 360.0f);
+	if (turn > 180.0f)
+		turn -= 360.0f;
+	else if (turn < -180.0f)
+		turn += 360.0f;
+
+	float most = MISSILE_TURN / FRAMES_VARIABLES_MULTIPLIER;
+	if (turn > most)
+		turn = most;
+	else if (turn < -most)
+		turn = -most;
+	angle += turn;
+
+	speed.setDx((MISSILE_SPEED / FRAMES_VARIABLES_MULTIPLIER) * cosDeg(angle));
+	speed.setDy((MISSILE_SPEED / FRAMES_VARIABLES_MULTIPLIER) * sinDeg(angle));
+}
+
+//A short orange streak pointing the way it flies
+void Missile::draw() const
+{
+	Point tail(point.getX() - 6.0 * cosDeg(angle),
+	           point.getY() - 6.0 * sinDeg(angle));
+	drawLine(tail, point, 1.0, 0.6, 0.1);
+}
+
+void Missile::advance()
+{
+	if (currentLife == (MISSILE_LIFE * FRAMES_VARIABLES_MULTIPLIER))
+		kill();
+	else
+	{
+		point.addX(speed.getDx());
+		point.addY(speed.getDy());
+		currentLife++;
+	}
+}
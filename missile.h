@@ -0,0 +1,42 @@
+/***********************************************************************
+ * Header File:
+ *    Missile : a bullet that turns toward the nearest rock
+ * Summary:
+ *    Every tick the game looks up the nearest rock to each missile in
+ *    the spatial grid and hands it to steer(). The missile can only turn
+ *    so fast, so a rock that moves quickly across it can still get away.
+ ************************************************************************/
+#ifndef MISSILE_H
+#define MISSILE_H
+
+#include "bullet.h"
+
+constexpr float MISSILE_SPEED = 5.0;
+constexpr float MISSILE_TURN = 8.0;    //most it can turn a tick (in degrees)
+constexpr int MISSILE_LIFE = 90;
+constexpr float MISSILE_SIGHT = 500.0; //how far away it can see a rock
+constexpr int MISSILE_PER_ROCK = 2;    //how many missiles can go after the same rock
+constexpr int MISSILE_VOLLEY = 6;      //how many are fired at once
+
+class Missile : public Bullet
+{
+protected:
+	//Which way it is flying (in degrees, same as the ship)
+	float angle;
+
+public:
+	Missile(const Point & point_, const float & angle_);
+	virtual ~Missile() override {  }
+
+	//Turn toward the target, but not more than MISSILE_TURN
+	void steer(const Point & target);
+
+	float getAngle() const { return angle; }
+
+	virtual void draw() const override;
+
+	//Will move the missile along the way it is facing
+	virtual void advance() override;
+};
+
+#endif // !MISSILE_H
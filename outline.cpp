@@ -0,0 +1,71 @@
+/*********************************************************************
+ * File: outline.cpp
+ * Description: Contains the implementaiton of the outline pool
+ *  methods. Along with static variable declarations.
+ *********************************************************************/
+#include "outline.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+std::vector<signed char> OutlinePool::corners;
+std::vector<std::uint32_t> OutlinePool::unused;
+unsigned int OutlinePool::seed = 2463534242u;
+unsigned int OutlinePool::version = 0;
+
+float OutlinePool::nextRandom()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed & 0xFFFFFF) / (float)0x1000000;
+}
+
+/******************************************
+ * MAKE
+ * The corners go once round the rock, each a little off from being
+ * evenly spaced and at its own distance out.
+ ******************************************/
+std::uint32_t OutlinePool::make(int size, int & bound)
+{
+	std::uint32_t offset;
+	if (!unused.empty())
+	{
+		offset = unused.back();
+		unused.pop_back();
+	}
+	else
+	{
+		offset = (std::uint32_t)corners.size();
+		corners.resize(corners.size() + 2 * OUTLINE_POINTS);
+	}
+
+	const float step = (float)(2.0 * M_PI / OUTLINE_POINTS);
+	float farthest = 0;
+	for (int i = 0; i < OUTLINE_POINTS; i++)
+	{
+		float angle = (i + 0.35f * (2.0f * nextRandom() - 1.0f)) * step;
+		float reach = size * (OUTLINE_LOW + (OUTLINE_HIGH - OUTLINE_LOW) * nextRandom());
+		int x = std::max(-127, std::min(127, (int)std::lround(reach * cos(angle) / OUTLINE_UNIT)));
+		int y = std::max(-127, std::min(127, (int)std::lround(reach * sin(angle) / OUTLINE_UNIT)));
+		corners[offset + 2 * i] = (signed char)x;
+		corners[offset + 2 * i + 1] = (signed char)y;
+		farthest = std::max(farthest, (float)std::sqrt((float)(x * x + y * y)) * OUTLINE_UNIT);
+	}
+	bound = (int)std::ceil(farthest);
+	version++;
+	return offset;
+}
+
+void OutlinePool::release(std::uint32_t offset)
+{
+	unused.push_back(offset);
+}
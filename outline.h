@@ -0,0 +1,68 @@
+/***********************************************************************
+ * Header File:
+ *    Outline Pool : the shape of every rock, all kept in one place
+ * Summary:
+ *    Each rock gets its own bumpy outline when it is made. The outlines
+ *    all have the same number of corners, stored one after the other in
+ *    one list as small whole numbers (OUTLINE_UNIT of a pixel each), so a
+ *    rock only has to keep where its outline starts. When a rock is
+ *    deleted its spot is handed to the next rock that is made, so the
+ *    list never grows past the most rocks there have been at once.
+ ************************************************************************/
+#ifndef OUTLINE_H
+#define OUTLINE_H
+
+#include <vector>
+#include <cstdint>
+
+//How many corners each outline has
+constexpr int OUTLINE_POINTS = 10;
+
+//How many pixels one step of a stored corner is
+constexpr float OUTLINE_UNIT = 0.25;
+
+//How far in and out a corner can be, as a part of the size of the rock
+constexpr float OUTLINE_LOW = 0.75;
+constexpr float OUTLINE_HIGH = 1.25;
+
+class OutlinePool
+{
+public:
+	/******************************************
+	 * MAKE
+	 * Make a new outline around a rock of the given size and say where it
+	 * starts. bound is set to the radius of a circle that holds all of it.
+	 ******************************************/
+	static std::uint32_t make(int size, int & bound);
+
+	//The rock is gone, its spot can be used again
+	static void release(std::uint32_t offset);
+
+	//The corners of an outline, x and y for each one
+	static const signed char * get(std::uint32_t offset) { return &corners[offset]; }
+
+	//Every outline at once, and a number that changes whenever any of
+	//them does, so a copy of them can tell when it is out of date
+	static const std::vector<signed char> & getAll() { return corners; }
+	static unsigned int getVersion() { return version; }
+
+	//How many outlines are in use, and how much memory the pool takes
+	static int size() { return (int)(corners.size() / (2 * OUTLINE_POINTS) - unused.size()); }
+	static long getBytes()
+	{
+		return (long)(corners.capacity() * sizeof(signed char) + unused.capacity() * sizeof(std::uint32_t));
+	}
+
+	//Start the shapes over, so the same seed makes the same rocks
+	static void setSeed(unsigned int seed_) { seed = seed_ ? seed_ : 1; }
+
+private:
+	static float nextRandom();
+
+	static std::vector<signed char> corners;     // every outline one after the other
+	static std::vector<std::uint32_t> unused;    // where the outlines of deleted rocks start
+	static unsigned int seed;
+	static unsigned int version;                 // how many outlines have been made
+};
+
+#endif // OUTLINE_H
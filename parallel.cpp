@@ -0,0 +1,140 @@
+/*********************************************************************
+ * File: parallel.cpp
+ * Description: Contains the worker pool behind parallelFor().
+ *********************************************************************/
+#include "parallel.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+/******************************************
+ * WORKER POOL
+ * threadCount() - 1 workers waiting for a loop. Everything about the
+ * loop, down to which piece is next, is behind one lock: there are only
+ * as many pieces as cores, so it is taken a handful of times a loop.
+ * Each loop has a number of its own, so a worker that wakes late never
+ * takes a piece of the next one thinking it belongs to the last.
+ ******************************************/
+class WorkerPool
+{
+public:
+	WorkerPool() : loop(0), stopping(false), call(NULL), context(NULL),
+	               count(0), chunk(0), pieces(0), next(0), done(0)
+	{
+		for (int i = 1; i < threadCount(); i++)
+			workers.emplace_back(&WorkerPool::serve, this);
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stopping = true;
+			start.notify_all();
+		}
+		for (int i = 0; i < (int)workers.size(); i++)
+			workers[i].join();
+	}
+
+	void run(int count, int chunk, int pieces, void (*call)(void *, int, int), void * context)
+	{
+		// one loop at a time (the window's thread and the game's can both
+		// have one when pipelined)
+		std::lock_guard<std::mutex> one(running);
+		unsigned int mine;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			this->call = call;
+			this->context = context;
+			this->count = count;
+			this->chunk = chunk;
+			this->pieces = pieces;
+			next = 0;
+			done = 0;
+			mine = ++loop;
+			start.notify_all();
+		}
+		work(mine);
+
+		std::unique_lock<std::mutex> guard(lock);
+		finished.wait(guard, [this, pieces] { return done == pieces; });
+	}
+
+	// the thread is doing a piece, so a loop inside it runs in place
+	static thread_local bool inside;
+
+private:
+	void serve()
+	{
+		unsigned int seen = 0;
+		for (;;)
+		{
+			unsigned int mine;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				start.wait(guard, [this, seen] { return stopping || loop != seen; });
+				if (stopping)
+					return;
+				mine = seen = loop;
+			}
+			work(mine);
+		}
+	}
+
+	// take pieces of loop mine until there are none left
+	void work(unsigned int mine)
+	{
+		inside = true;
+		for (;;)
+		{
+			int begin, end;
+			void (*pieceCall)(void *, int, int);
+			void * pieceContext;
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				if (loop != mine || next == pieces)
+					break;
+				begin = next++ * chunk;
+				end = std::min(begin + chunk, count);
+				pieceCall = call;
+				pieceContext = context;
+			}
+			pieceCall(pieceContext, begin, end);
+
+			std::lock_guard<std::mutex> guard(lock);
+			if (++done == pieces)
+				finished.notify_all();
+		}
+		inside = false;
+	}
+
+	std::vector<std::thread> workers;
+	std::mutex running;
+	std::mutex lock;
+	std::condition_variable start;
+	std::condition_variable finished;
+	unsigned int loop;
+	bool stopping;
+
+	// the loop going on now
+	void (*call)(void *, int, int);
+	void * context;
+	int count;
+	int chunk;
+	int pieces;
+	int next;
+	int done;
+};
+
+thread_local bool WorkerPool::inside = false;
+
+bool runPieces(int count, int chunk, int pieces, void (*call)(void * context, int begin, int end),
+               void * context)
+{
+	if (WorkerPool::inside)
+		return false;
+	static WorkerPool pool;
+	pool.run(count, chunk, pieces, call, context);
+	return true;
+}
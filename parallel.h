@@ -0,0 +1,60 @@
+/***********************************************************************
+ * Header File:
+ *    Parallel : split a loop across every core
+ * Summary:
+ *    parallelFor() cuts 0 .. count into one piece per core and runs
+ *    work(begin, end) on each piece at the same time. The pieces go to a
+ *    pool of worker threads made the first time they are needed and
+ *    kept until the program ends, so a loop costs a wake up and not a
+ *    thread started and joined for every piece. The calling thread does
+ *    pieces too and waits for the rest. Loops that are too small to be
+ *    worth waking the workers for just run in place, and so does a
+ *    parallelFor() inside another one's work.
+ ************************************************************************/
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <algorithm>
+
+/******************************************
+ * THREAD COUNT
+ * How many threads parallelFor will use at the most.
+ ******************************************/
+inline int threadCount()
+{
+	int threads = (int)std::thread::hardware_concurrency();
+	return threads > 0 ? threads : 1;
+}
+
+/******************************************
+ * RUN PIECES
+ * Run call(context, begin, end) for pieces pieces of chunk items out of
+ * count on the worker pool and this thread, and wait for all of them.
+ * Returns false without running anything when this thread is already
+ * one of the pool's pieces.
+ ******************************************/
+bool runPieces(int count, int chunk, int pieces, void (*call)(void * context, int begin, int end),
+               void * context);
+
+/******************************************
+ * PARALLEL FOR
+ * Each thread gets at least minChunk items.
+ ******************************************/
+template <class Work>
+void parallelFor(int count, int minChunk, Work work)
+{
+	int threads = std::min(threadCount(), (count + minChunk - 1) / std::max(minChunk, 1));
+	if (threads > 1)
+	{
+		int chunk = (count + threads - 1) / threads;
+		int pieces = (count + chunk - 1) / chunk;
+		auto call = [](void * context, int begin, int end) { (*(Work *)context)(begin, end); };
+		if (runPieces(count, chunk, pieces, call, &work))
+			return;
+	}
+	if (count > 0)
+		work(0, count);
+}
+
+#endif // PARALLEL_H
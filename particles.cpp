@@ -0,0 +1,170 @@
+/*********************************************************************
+ * File: particles.cpp
+ * Description: Contains the implementaiton of the particles class
+ *  methods.
+ *********************************************************************/
+#include "particles.h"
+#include "uiDraw.h"
+#include "trig.h"
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//What each ParticleColor looks like (red, green, blue)
+const unsigned char PARTICLE_PALETTE[PARTICLE_COLORS][3] =
+{
+	{ 204,  51, 255 },  // dust, same purple as the rocks
+	{ 255, 153,   0 },  // fire
+	{ 255,  40,   0 },  // exhaust
+	{ 120, 200, 255 }   // shock wave
+};
+
+Particles::Particles(int budget)
+	: budget(budget), dropped(0), seed(2463534242u)
+{
+}
+
+/******************************************
+ * ALLOWED
+ * How many of the count asked for can be made. Once the budget is three
+ * quarters full bursts get smaller the fuller it gets.
+ ******************************************/
+int Particles::allowed(int count)
+{
+	int room = budget - size();
+	int quarter = budget / 4;
+	int made = count;
+	if (room < quarter)
+		made = (int)((long)count * room / quarter);
+	if (made > room)
+		made = room;
+	if (made < 0)
+		made = 0;
+	dropped += count - made;
+	return made;
+}
+
+//Cheap random number from 0 to 1 (xorshift), rand() is too slow here
+float Particles::nextRandom()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed & 0xFFFFFF) / (float)0x1000000;
+}
+
+void Particles::burst(const Point & center, const Velocity & base, int count,
+                      float speed, int life, ParticleColor color)
+{
+	spray(center, base, count, 0.0f, 180.0f, speed, life, color);
+}
+
+void Particles::spray(const Point & center, const Velocity & base, int count, float angle,
+                      float spread, float speed, int life, ParticleColor color)
+{
+	count = allowed(count);
+	if (count == 0)
+		return;
+
+	int first = size();
+	int total = first + count;
+	x.resize(total, center.getX());
+	y.resize(total, center.getY());
+	dx.resize(total);
+	dy.resize(total);
+	this->life.resize(total);
+	this->color.resize(total, (unsigned char)color);
+
+	for (int i = first; i < total; i++)
+	{
+		float direction = angle + spread * (2.0f * nextRandom() - 1.0f);
+		float howFast = speed * (0.2f + 0.8f * nextRandom());
+		dx[i] = base.getDx() + howFast * cosDeg(direction);
+		dy[i] = base.getDy() + howFast * sinDeg(direction);
+		this->life[i] = life / 2 + (int)(nextRandom() * life / 2) + 1;
+	}
+}
+
+/******************************************
+ * ADVANCE
+ * First a plain pass over the arrays that the compiler can vectorize,
+ * then the ones that ran out of life are packed out.
+ ******************************************/
+void Particles::advance()
+{
+	int count = size();
+	float * px = x.data();
+	float * py = y.data();
+	const float * pdx = dx.data();
+	const float * pdy = dy.data();
+	int * plife = life.data();
+	for (int i = 0; i < count; i++)
+	{
+		px[i] += pdx[i];
+		py[i] += pdy[i];
+		plife[i]--;
+	}
+
+	int kept = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (plife[i] > 0)
+		{
+			if (kept != i)
+			{
+				x[kept] = x[i];
+				y[kept] = y[i];
+				dx[kept] = dx[i];
+				dy[kept] = dy[i];
+				life[kept] = life[i];
+				color[kept] = color[i];
+			}
+			kept++;
+		}
+	}
+	x.resize(kept);
+	y.resize(kept);
+	dx.resize(kept);
+	dy.resize(kept);
+	life.resize(kept);
+	color.resize(kept);
+}
+
+void Particles::prepareDraw()
+{
+	int count = size();
+	vertices.resize(count * 2);
+	colors.resize(count * 3);
+	for (int i = 0; i < count; i++)
+	{
+		vertices[i * 2] = x[i];
+		vertices[i * 2 + 1] = y[i];
+		colors[i * 3] = PARTICLE_PALETTE[color[i]][0];
+		colors[i * 3 + 1] = PARTICLE_PALETTE[color[i]][1];
+		colors[i * 3 + 2] = PARTICLE_PALETTE[color[i]][2];
+	}
+}
+
+void Particles::draw()
+{
+	if (x.empty())
+		return;
+	prepareDraw();
+	drawPoints(vertices.data(), colors.data(), size());
+}
+
+void Particles::clear()
+{
+	x.clear();
+	y.clear();
+	dx.clear();
+	dy.clear();
+	life.clear();
+	color.clear();
+}
@@ -0,0 +1,90 @@
+/***********************************************************************
+ * Header File:
+ *    Particles : the sparks and dust from explosions and the ship's
+ *    engine
+ * Summary:
+ *    Particles are only eye candy, they never hit anything. There can be
+ *    hundreds of thousands of them, so they are not FlyingObjects.
+ *    Instead every field is kept in its own array (x's together, y's
+ *    together...) so moving them is a few tight loops the compiler can
+ *    vectorize, and they are all drawn with a single call.
+ *
+ *    There is a budget on how many can be alive. As it fills up each
+ *    burst gets smaller, and once it is full new ones are just dropped,
+ *    so a huge explosion thins out instead of slowing the game down.
+ ************************************************************************/
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "point.h"
+#include "velocity.h"
+#include <vector>
+
+//The most particles that can be alive at once
+constexpr int PARTICLE_BUDGET = 200000;
+
+//What color a particle is
+enum ParticleColor
+{
+	PARTICLE_DUST,     // bits of rock
+	PARTICLE_FIRE,     // the ship blowing up
+	PARTICLE_EXHAUST,  // from the engine
+	PARTICLE_SHOCK,    // the shock wave
+	PARTICLE_COLORS
+};
+
+class Particles
+{
+public:
+	Particles(int budget = PARTICLE_BUDGET);
+
+	/******************************************
+	 * BURST
+	 * count particles flying out in every direction from center at up
+	 * to speed, on top of the speed of whatever made them.
+	 ******************************************/
+	void burst(const Point & center, const Velocity & base, int count,
+	           float speed, int life, ParticleColor color);
+
+	/******************************************
+	 * SPRAY
+	 * Same as burst, but only within spread degrees either side of angle.
+	 ******************************************/
+	void spray(const Point & center, const Velocity & base, int count, float angle,
+	           float spread, float speed, int life, ParticleColor color);
+
+	//Move everything along one tick and throw out the ones that are done
+	void advance();
+
+	//Build the vertex and color lists (no drawing happens here)
+	void prepareDraw();
+
+	//Draw everything in one go. Calls prepareDraw().
+	void draw();
+
+	void clear();
+	int size() const { return (int)x.size(); }
+	int getBudget() const { return budget; }
+	//How many particles were asked for but not made because of the budget
+	long getDropped() const { return dropped; }
+
+private:
+	int allowed(int count);
+	float nextRandom();
+
+	int budget;
+	long dropped;
+	unsigned int seed;
+
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> dx;
+	std::vector<float> dy;
+	std::vector<int> life;
+	std::vector<unsigned char> color;
+
+	std::vector<float> vertices;       // x, y pairs for drawing
+	std::vector<unsigned char> colors; // r, g, b for drawing
+};
+
+#endif // PARTICLES_H
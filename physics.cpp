@@ -0,0 +1,79 @@
+/*********************************************************************
+ * File: physics.cpp
+ * Description: Contains the implementaiton of the physics
+ *  functions.
+ *********************************************************************/
+#include "physics.h"
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+void bounceRocks(std::vector<Rocks *> & rocks, SpatialGrid & grid, std::vector<Rocks *> * bounced)
+{
+	grid.clear();
+	for (int i = 0; i < (int)rocks.size(); i++)
+	{
+		if (rocks[i]->isAlive())
+			grid.insert(i, rocks[i]->getCurrentPoint(), rocks[i]->getRadius());
+	}
+	grid.build();
+
+	grid.forEachPair([&rocks, bounced](const GridEntry & entry1, const GridEntry & entry2)
+	{
+		// cheap check on the grid's copy before touching the rocks
+		float xDiff = entry2.x - entry1.x;
+		float yDiff = entry2.y - entry1.y;
+		float reach = entry1.radius + entry2.radius;
+		if ((xDiff * xDiff) + (yDiff * yDiff) < reach * reach &&
+		    bounceRockPair(*rocks[entry1.id], *rocks[entry2.id]) && bounced)
+		{
+			bounced->push_back(rocks[entry1.id]);
+			bounced->push_back(rocks[entry2.id]);
+		}
+	});
+}
+
+/******************************************
+ * BOUNCE ROCK PAIR
+ * Only the part of the speed along the line between the two centers
+ * changes. Rocks that overlap but are already moving apart (like the
+ * pieces of a rock that was just split) are left alone.
+ ******************************************/
+bool bounceRockPair(Rocks & rock1, Rocks & rock2)
+{
+	Point point1 = rock1.getCurrentPoint();
+	Point point2 = rock2.getCurrentPoint();
+	float xDiff = point2.getX() - point1.getX();
+	float yDiff = point2.getY() - point1.getY();
+	float reach = (float)(rock1.getRadius() + rock2.getRadius());
+	float distSquared = (xDiff * xDiff) + (yDiff * yDiff);
+	if (distSquared >= reach * reach || distSquared == 0.0f)
+		return false;
+
+	// unit vector from rock1 to rock2
+	float dist = sqrt(distSquared);
+	float nx = xDiff / dist;
+	float ny = yDiff / dist;
+
+	Velocity speed1 = rock1.getVelocity();
+	Velocity speed2 = rock2.getVelocity();
+	float closing = ((speed1.getDx() - speed2.getDx()) * nx) +
+	                ((speed1.getDy() - speed2.getDy()) * ny);
+	if (closing <= 0.0f)
+		return false;
+
+	float mass1 = rock1.getMass();
+	float mass2 = rock2.getMass();
+	float push1 = 2.0f * mass2 / (mass1 + mass2) * closing;
+	float push2 = 2.0f * mass1 / (mass1 + mass2) * closing;
+
+	rock1.setVelocity(Velocity(speed1.getDx() - push1 * nx, speed1.getDy() - push1 * ny));
+	rock2.setVelocity(Velocity(speed2.getDx() + push2 * nx, speed2.getDy() + push2 * ny));
+	return true;
+}
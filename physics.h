@@ -0,0 +1,33 @@
+/***********************************************************************
+ * Header File:
+ *    Physics : extra rules for how objects push on each other
+ * Summary:
+ *    These are only used in the optional game modes. When bouncing is
+ *    turned on, rocks no longer pass through each other. Instead they
+ *    bounce like billiard balls, with the bigger rocks being heavier.
+ *    The spatial grid is used so only rocks that are close together
+ *    are ever checked against each other.
+ ************************************************************************/
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "rocks.h"
+#include "spatialGrid.h"
+#include <vector>
+
+/******************************************
+ * BOUNCE ROCKS
+ * Bounce every pair of live rocks that are touching and moving
+ * towards each other. The grid is rebuilt from the rocks. The rocks
+ * whose speed changed are added to bounced, if it is given.
+ ******************************************/
+void bounceRocks(std::vector<Rocks *> & rocks, SpatialGrid & grid, std::vector<Rocks *> * bounced = NULL);
+
+/******************************************
+ * BOUNCE ROCK PAIR
+ * Elastic bounce between two rocks. Returns true if they were
+ * touching and closing in, meaning their speeds were changed.
+ ******************************************/
+bool bounceRockPair(Rocks & rock1, Rocks & rock2);
+
+#endif // PHYSICS_H
@@ -0,0 +1,225 @@
+/*********************************************************************
+ * File: raster.cpp
+ * Description: Contains the implementaiton of the raster class
+ *  methods.
+ *********************************************************************/
+#include "raster.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+/******************************************
+ * FLOOR TO INT
+ * floor() for anything that can be a pixel, with no call and no branch
+ * so a loop of them can be done several at once
+ ******************************************/
+static inline int floorToInt(float value)
+{
+	int whole = (int)value;
+	return whole - (value < whole);
+}
+
+Raster::Raster(int width, int height)
+	: width(width), height(height), left(0), top(0), scaleX(1), scaleY(1),
+	  cameraX(0), cameraY(0), parallel(true)
+{
+	pixels.resize(4 * width * height);
+	setView(Point(-width / 2.0f, height / 2.0f), Point(width / 2.0f, -height / 2.0f));
+	clear();
+}
+
+void Raster::setView(const Point & topLeft, const Point & bottomRight)
+{
+	left = topLeft.getX();
+	top = topLeft.getY();
+	scaleX = width / (bottomRight.getX() - topLeft.getX());
+	scaleY = height / (topLeft.getY() - bottomRight.getY());
+}
+
+void Raster::clear()
+{
+	for (int i = 0; i < width * height; i++)
+	{
+		pixels[4 * i] = 0;
+		pixels[4 * i + 1] = 0;
+		pixels[4 * i + 2] = 0;
+		pixels[4 * i + 3] = 255;
+	}
+}
+
+/******************************************
+ * TO PIXELS
+ * Move the vertices onto the pixels, into ends. x and y are both a
+ * multiply and an add, so two vertices at a time are one multiply and
+ * one add of four floats each, with no branches and a fixed count the
+ * compiler can do all at once.
+ ******************************************/
+void Raster::toPixels(const float * vertices, int count)
+{
+	ends.resize(2 * count);
+	float offsetX = -(left + cameraX) * scaleX;
+	float offsetY = (top + cameraY) * scaleY;
+	const float scale[4] = { scaleX, -scaleY, scaleX, -scaleY };
+	const float offset[4] = { offsetX, offsetY, offsetX, offsetY };
+	float * out = ends.data();
+	int i = 0;
+	for (; i + 4 <= 2 * count; i += 4)
+	{
+		for (int lane = 0; lane < 4; lane++)
+			out[i + lane] = vertices[i + lane] * scale[lane] + offset[lane];
+	}
+	for (; i < 2 * count; i++)
+		out[i] = vertices[i] * scale[i % 2] + offset[i % 2];
+}
+
+void Raster::drawPoints(const unsigned char * color, const float * vertices, int count)
+{
+	toPixels(vertices, count);
+	for (int i = 0; i < count; i++)
+		plot(floorToInt(ends[2 * i]), floorToInt(ends[2 * i + 1]), color);
+}
+
+void Raster::drawPoints(const float * vertices, const unsigned char * colors, int count)
+{
+	toPixels(vertices, count);
+	for (int i = 0; i < count; i++)
+		plot(floorToInt(ends[2 * i]), floorToInt(ends[2 * i + 1]), colors + 3 * i);
+}
+
+/******************************************
+ * DRAW LINES
+ * Put each line in the bands it crosses (counted first, then filled
+ * in), then draw the bands.
+ ******************************************/
+void Raster::drawLines(const unsigned char * color, const float * vertices, int count)
+{
+	int lines = count / 2;
+	if (lines == 0)
+		return;
+	toPixels(vertices, 2 * lines);
+
+	int bands = (height + RASTER_BAND - 1) / RASTER_BAND;
+	auto bandsOf = [&](int line, int & first, int & last)
+	{
+		float y0 = ends[4 * line + 1];
+		float y1 = ends[4 * line + 3];
+		first = std::max(0, (int)std::floor(std::min(y0, y1)) / RASTER_BAND);
+		last = std::min(bands - 1, (int)std::floor(std::max(y0, y1)) / RASTER_BAND);
+	};
+
+	bandStart.assign(bands + 1, 0);
+	for (int line = 0; line < lines; line++)
+	{
+		int first;
+		int last;
+		bandsOf(line, first, last);
+		for (int band = first; band <= last; band++)
+			bandStart[band + 1]++;
+	}
+	for (int band = 0; band < bands; band++)
+		bandStart[band + 1] += bandStart[band];
+	bandLines.resize(bandStart[bands]);
+	std::vector<int> filled(bandStart.begin(), bandStart.end() - 1);
+	for (int line = 0; line < lines; line++)
+	{
+		int first;
+		int last;
+		bandsOf(line, first, last);
+		for (int band = first; band <= last; band++)
+			bandLines[filled[band]++] = line;
+	}
+
+	auto drawBands = [&](int begin, int end)
+	{
+		for (int band = begin; band < end; band++)
+		{
+			int bandTop = band * RASTER_BAND;
+			int bandBottom = std::min(height, bandTop + RASTER_BAND);
+			for (int i = bandStart[band]; i < bandStart[band + 1]; i++)
+				lineInBand(bandLines[i], bandTop, bandBottom, color);
+		}
+	};
+	if (parallel && lines >= RASTER_PARALLEL_LINES)
+		parallelFor(bands, 1, drawBands);
+	else
+		drawBands(0, bands);
+}
+
+/******************************************
+ * LINE IN BAND
+ * Step along the line a pixel at a time (along whichever way it is
+ * longer), only over the steps that land in rows top to bottom. The
+ * steps go RASTER_LANES at a time: where each one lands, and whether
+ * that is in the band and on the picture, is worked out for all of
+ * them at once with no branches, then the ones that are get written.
+ ******************************************/
+void Raster::lineInBand(int line, int top, int bottom, const unsigned char * color)
+{
+	float x0 = ends[4 * line];
+	float y0 = ends[4 * line + 1];
+	float dx = ends[4 * line + 2] - x0;
+	float dy = ends[4 * line + 3] - y0;
+	int steps = (int)std::ceil(std::max(std::abs(dx), std::abs(dy)));
+	if (steps == 0)
+	{
+		int row = floorToInt(y0);
+		if (row >= top && row < bottom)
+			plot(floorToInt(x0), row, color);
+		return;
+	}
+	float stepX = dx / steps;
+	float stepY = dy / steps;
+
+	int first = 0;
+	int last = steps;
+	if (stepY != 0)
+	{
+		// the steps where top <= y < bottom, a step either side to be safe
+		float a = (top - y0) / stepY;
+		float b = (bottom - y0) / stepY;
+		first = std::max(first, (int)std::floor(std::min(a, b)) - 1);
+		last = std::min(last, (int)std::ceil(std::max(a, b)) + 1);
+	}
+	const unsigned char rgba[4] = { color[0], color[1], color[2], 255 };
+	int at[RASTER_LANES];
+	for (int i = first; i <= last; i += RASTER_LANES)
+	{
+		for (int lane = 0; lane < RASTER_LANES; lane++)
+		{
+			int step = i + lane;
+			int column = floorToInt(x0 + stepX * step);
+			int row = floorToInt(y0 + stepY * step);
+			bool inside = (step <= last) & (row >= top) & (row < bottom) &
+			              (column >= 0) & (column < width);
+			at[lane] = inside ? row * width + column : -1;
+		}
+		for (int lane = 0; lane < RASTER_LANES; lane++)
+		{
+			if (at[lane] >= 0)
+				memcpy(&pixels[4 * at[lane]], rgba, 4);
+		}
+	}
+}
+
+bool Raster::writePpm(const char * fileName) const
+{
+	FILE * file = fopen(fileName, "wb");
+	if (!file)
+		return false;
+	fprintf(file, "P6\n%d %d\n255\n", width, height);
+	std::vector<unsigned char> row(3 * width);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			row[3 * x] = pixels[4 * (y * width + x)];
+			row[3 * x + 1] = pixels[4 * (y * width + x) + 1];
+			row[3 * x + 2] = pixels[4 * (y * width + x) + 2];
+		}
+		fwrite(row.data(), 1, row.size(), file);
+	}
+	return fclose(file) == 0;
+}
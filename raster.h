@@ -0,0 +1,100 @@
+/***********************************************************************
+ * Header File:
+ *    Raster : draws onto pixels in memory instead of through OpenGL
+ * Summary:
+ *    Lets the game be drawn with no window and no graphics card, for
+ *    pictures of it and for checking what it draws. See beginSoftware()
+ *    in uiDraw.h, which sends the draws here.
+ *
+ *    The world is put on the pixels the same way gluOrtho2D() does it
+ *    for the window. Lines are cut into bands of RASTER_BAND rows, each
+ *    line going in every band it crosses, and the bands are drawn at the
+ *    same time on every core. No two threads ever write the same row.
+ *    The ends of every line are moved onto the pixels in one plain pass
+ *    the compiler can vectorize before any of that, and each line is
+ *    stepped along RASTER_LANES pixels at a time.
+ *
+ *    Only points and lines are drawn. Text is left out.
+ ************************************************************************/
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "point.h"
+
+#include <vector>
+
+//How many rows of pixels each band has
+constexpr int RASTER_BAND = 32;
+
+//Fewer lines than this are not worth splitting across threads
+constexpr int RASTER_PARALLEL_LINES = 2048;
+
+//How many steps along a line are worked out at once
+constexpr int RASTER_LANES = 8;
+
+class Raster
+{
+public:
+	Raster(int width, int height);
+
+	//Which part of the world the pixels show, like gluOrtho2D()
+	void setView(const Point & topLeft, const Point & bottomRight);
+
+	//Everything drawn is moved so this point is in the middle (0 to stop)
+	void setCamera(float x, float y) { cameraX = x; cameraY = y; }
+
+	//Every pixel black
+	void clear();
+
+	//A color for each call (red, green, blue, 0 - 255), then x, y pairs.
+	//Lines take two pairs each.
+	void drawPoints(const unsigned char * color, const float * vertices, int count);
+	void drawLines(const unsigned char * color, const float * vertices, int count);
+
+	//Points that each have their own color, three bytes each
+	void drawPoints(const float * vertices, const unsigned char * colors, int count);
+
+	//Use one thread, to compare against
+	void setParallel(bool parallel_) { parallel = parallel_; }
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+
+	//Red, green, blue and alpha for each pixel, the top row first
+	const unsigned char * getPixels() const { return pixels.data(); }
+
+	//Save as a binary PPM, returns false if it could not be written
+	bool writePpm(const char * fileName) const;
+
+private:
+	void toPixels(const float * vertices, int count);
+	void lineInBand(int line, int top, int bottom, const unsigned char * color);
+	void plot(int x, int y, const unsigned char * color)
+	{
+		if (x >= 0 && x < width && y >= 0 && y < height)
+		{
+			unsigned char * pixel = &pixels[4 * (y * width + x)];
+			pixel[0] = color[0];
+			pixel[1] = color[1];
+			pixel[2] = color[2];
+			pixel[3] = 255;
+		}
+	}
+
+	int width;
+	int height;
+	float left;
+	float top;
+	float scaleX;
+	float scaleY;
+	float cameraX;
+	float cameraY;
+	bool parallel;
+
+	std::vector<unsigned char> pixels;
+	std::vector<float> ends;             // the vertices in pixels
+	std::vector<int> bandStart;          // where each band's lines start in bandLines
+	std::vector<int> bandLines;          // the lines in each band, band after band
+};
+
+#endif // RASTER_H
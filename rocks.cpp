@@ -5,6 +5,8 @@
  *********************************************************************/
 #include "rocks.h"
 #include "uiInteract.h"
+#include "trig.h"
+#include <algorithm>
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES 
@@ -22,11 +24,67 @@ constexpr float LARGE_TO_SMALL_SPEED = 2.0;
 constexpr float LARGE_TO_MEDIUM_SPEED = 1.0;
 constexpr float MEDIUM_TO_SMALL_SPEED = 3.0;
 
-void BigRock::advance()
+//Longer than a rock will ever go without wrapping
+constexpr double ROCK_NEVER_WRAPS = 1 << 28;
+
+float Rocks::halfWidth = 0;
+float Rocks::halfHeight = 0;
+
+void Rocks::setWorld(const Point & topLeft, const Point & bottomRight)
+{
+	halfWidth = bottomRight.getX();
+	halfHeight = topLeft.getY();
+}
+
+//Back between -edge and edge, as if the two were joined. In doubles,
+//a float runs out of room for where a slow rock is after a long time.
+static double wrapInside(double at, double edge)
+{
+	return at - 2.0 * edge * std::ceil((at - edge) / (2.0 * edge));
+}
+
+//Ticks from now until it is past the edge it is heading for
+static double ticksOut(double at, double speed, double edge)
+{
+	if (speed > 0)
+		return std::floor((edge - at) / speed) + 1;
+	if (speed < 0)
+		return std::ceil((edge + at) / -speed);
+	return ROCK_NEVER_WRAPS;
+}
+
+/******************************************
+ * ROCKS :: GET CURRENT POINT
+ * Straight along its line from where it was on tick since. It comes out
+ * the other side once it is all the way off the world, the same way
+ * wrapAround() does it for everything else.
+ ******************************************/
+Point Rocks::getCurrentPoint() const
 {
-	point.addX(speed.getDx());
-	point.addY(speed.getDy());
-	rotation += BIG_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER;
+	double ticks = (double)(currentTick - since);
+	double x = point.getX() + speed.getDx() * ticks;
+	double y = point.getY() + speed.getDy() * ticks;
+	if (halfWidth > 0)
+	{
+		x = wrapInside(x, halfWidth + bound);
+		y = wrapInside(y, halfHeight + bound);
+	}
+	return Point((float)x, (float)y);
+}
+
+float Rocks::getRotation() const
+{
+	return (float)std::fmod(rotation + (double)spin * (currentTick - spawned), 360.0);
+}
+
+unsigned int Rocks::getWrapTick() const
+{
+	if (halfWidth <= 0)
+		return currentTick + (unsigned int)ROCK_NEVER_WRAPS;
+	Point at = getCurrentPoint();
+	double ticks = std::min(ticksOut(at.getX(), speed.getDx(), halfWidth + bound),
+	                        ticksOut(at.getY(), speed.getDy(), halfHeight + bound));
+	return currentTick + (unsigned int)std::max(1.0, std::min(ticks, ROCK_NEVER_WRAPS));
 }
 
 std::vector<Rocks*> BigRock::killRocks()
@@ -37,9 +95,10 @@ std::vector<Rocks*> BigRock::killRocks()
 	Rocks* rock1 = NULL;
 	Rocks* rock2 = NULL;
 	Rocks* rock3 = NULL;
-	rock1 = new MediumRock(point, speed, true);
-	rock2 = new MediumRock(point, speed, false);
-	rock3 = new SmallRock(point, speed);
+	Point at = getCurrentPoint();
+	rock1 = new MediumRock(at, speed, true);
+	rock2 = new MediumRock(at, speed, false);
+	rock3 = new SmallRock(at, speed);
 	temp.push_back(rock1);
 	temp.push_back(rock2);
 	temp.push_back(rock3);
@@ -48,13 +107,14 @@ std::vector<Rocks*> BigRock::killRocks()
 }
 
 BigRock::BigRock(const Point & point_)
+	: Rocks(size, BIG_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	int angle = random(1, 361);
 	float dx;
 	float dy;
 	
-	dx = (BIG_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (BIG_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (BIG_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (BIG_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
@@ -64,13 +124,14 @@ BigRock::BigRock(const Point & point_)
 }
 
 MediumRock::MediumRock(const Point & point_)
+	: Rocks(size, MEDIUM_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	int angle = random(1, 361);
 	float dx;
 	float dy;
 
-	dx = (MEDIUM_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (MEDIUM_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (MEDIUM_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (MEDIUM_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
@@ -80,6 +141,7 @@ MediumRock::MediumRock(const Point & point_)
 }
 
 MediumRock::MediumRock(const Point & point_, const Velocity & speed_, const bool & up)
+	: Rocks(size, MEDIUM_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	float dy;
 	if (up)
@@ -94,13 +156,6 @@ MediumRock::MediumRock(const Point & point_, const Velocity & speed_, const bool
 	alive = true;
 }
 
-void MediumRock::advance()
-{
-	point.addX(speed.getDx());
-	point.addY(speed.getDy());
-	rotation += (MEDIUM_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER);
-}
-
 std::vector<Rocks*> MediumRock::killRocks()
 {
 	alive = false;
@@ -108,8 +163,9 @@ std::vector<Rocks*> MediumRock::killRocks()
 	std::vector<Rocks*> temp;
 	Rocks* rock1 = NULL;
 	Rocks* rock2 = NULL;
-	rock1 = new SmallRock(point, speed, true);
-	rock2 = new SmallRock(point, speed, false);
+	Point at = getCurrentPoint();
+	rock1 = new SmallRock(at, speed, true);
+	rock2 = new SmallRock(at, speed, false);
 	temp.push_back(rock1);
 	temp.push_back(rock2);
 
@@ -117,13 +173,14 @@ std::vector<Rocks*> MediumRock::killRocks()
 }
 
 SmallRock::SmallRock(const Point & point_)
+	: Rocks(size, SMALL_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	int angle = random(1, 361);
 	float dx;
 	float dy;
 
-	dx = (SMALL_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (SMALL_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (SMALL_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (SMALL_ROCK_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
@@ -133,6 +190,7 @@ SmallRock::SmallRock(const Point & point_)
 }
 
 SmallRock::SmallRock(const Point & point_, const Velocity & speed_)
+	: Rocks(size, SMALL_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	speed.setDx(speed_.getDx() + (LARGE_TO_SMALL_SPEED / FRAMES_VARIABLES_MULTIPLIER));
 	speed.setDy(speed_.getDy());
@@ -142,6 +200,7 @@ SmallRock::SmallRock(const Point & point_, const Velocity & speed_)
 }
 
 SmallRock::SmallRock(const Point & point_, const Velocity & speed_, const bool & left)
+	: Rocks(size, SMALL_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER)
 {
 	float dx;
 	if (left)
@@ -156,13 +215,6 @@ SmallRock::SmallRock(const Point & point_, const Velocity & speed_, const bool &
 	alive = true;
 }
 
-void SmallRock::advance()
-{
-	point.addX(speed.getDx());
-	point.addY(speed.getDy());
-	rotation += (SMALL_ROCK_SPIN / FRAMES_VARIABLES_MULTIPLIER);
-}
-
 std::vector<Rocks*> SmallRock::killRocks()
 {
 	alive = false;
@@ -13,9 +13,10 @@
 
 #include "flyingObject.h"
 #include "uiDraw.h"
+#include "outline.h"
 #include <vector>
 
-//These variables will hold each rocks radius
+//These variables will hold how big each rock is, its outline is made around this
 constexpr int BIG_ROCK_SIZE = 16;
 constexpr int MEDIUM_ROCK_SIZE = 12;
 constexpr int SMALL_ROCK_SIZE = 6;
@@ -30,23 +31,55 @@ constexpr int BIG_ROCK_VALUE = 1;
 constexpr int MEDIUM_ROCK_VALUE = 1;
 constexpr int SMALL_ROCK_VALUE = 2;
 
+//These Variables will hold how heavy each rock is when they bounce
+constexpr float BIG_ROCK_MASS = 9.0;
+constexpr float MEDIUM_ROCK_MASS = 4.0;
+constexpr float SMALL_ROCK_MASS = 1.0;
+
 class Rocks : public FlyingObject
 {
 protected:
+	//Rocks are never moved. A rock was at point on tick since and goes
+	//speed a tick from there, and it had rotation on tick spawned and
+	//turns spin a tick. Where it is comes from those (getCurrentPoint).
 	float rotation;
+	float spin;
+	unsigned int spawned;
+	//Where this rock's outline is in the pool (see outline.h)
+	std::uint32_t outline;
+	//Radius of a circle that holds the whole outline
+	int bound;
+	//Half the size of the world rocks wrap around in, 0 if they do not
+	static float halfWidth;
+	static float halfHeight;
 public:
-	Rocks() { }
+	Rocks(int size, float spin) : spin(spin), spawned(currentTick) { outline = OutlinePool::make(size, bound); }
+	//Each rock owns its spot in the pool, so rocks are never copied
+	Rocks(const Rocks &) = delete;
+	Rocks & operator = (const Rocks &) = delete;
 	//Virtual destructor so child classes can destructor properly
-	virtual ~Rocks() override { };
-	float getRotation() const { return rotation; }
-	//Purely virtual since each rock looks different.
-	virtual void draw() const = 0;
-	//Purely Virtual since each rock moves differently.
-	virtual void advance() = 0;
+	virtual ~Rocks() override { OutlinePool::release(outline); };
+	//The world is centered on (0, 0). Every rock has to be put where it
+	//is now (setPoint) before it changes size.
+	static void setWorld(const Point & topLeft, const Point & bottomRight);
+	//Where it is this tick, wrapped once it is all the way off the world
+	virtual Point getCurrentPoint() const override;
+	float getRotation() const;
+	//The next tick it goes all the way off an edge and wraps
+	unsigned int getWrapTick() const;
+	//Each rock is drawn from its own outline
+	virtual void draw() const override
+	{
+		drawAsteroid(getCurrentPoint(), getRotation(), OutlinePool::get(outline), OUTLINE_POINTS, OUTLINE_UNIT);
+	}
+	//Nothing to do, see getCurrentPoint
+	virtual void advance() override { }
 	//Purely Virtual since each rock is worth a different value.
 	virtual int getValue() const = 0;
-	//Purely Virtual since each rock has a different radius.
-	virtual int getRadius() const = 0;
+	//Each rock's radius comes from its outline
+	int getRadius() const { return bound; }
+	//Purely Virtual since each rock has a different mass.
+	virtual float getMass() const = 0;
 	//Purely Virtual since each rock will have a different death outcome.
 	virtual std::vector<Rocks*> killRocks() = 0;
 	
@@ -59,19 +92,15 @@ class BigRock : public Rocks
 {
 protected:
 	//These variables only need to be stored once for all instances of BigRock
-	const static int radius = BIG_ROCK_SIZE;
+	const static int size = BIG_ROCK_SIZE;
 	const static int value = BIG_ROCK_VALUE;
+	constexpr static float mass = BIG_ROCK_MASS;
 public:
 	//For making a new BigRock
 	BigRock(const Point & point_);
 	virtual ~BigRock() override {   }
-	virtual void draw() const override
-	{
-		drawLargeAsteroid(point, rotation);
-	}
-	virtual void advance() override;
 	virtual int getValue() const override { return value; }
-	int getRadius() const override { return radius; }
+	float getMass() const override { return mass; }
 	virtual std::vector<Rocks*> killRocks() override;
 
 	virtual int hit() override { return (5 * SMALL_ROCK_VALUE) + (2 * MEDIUM_ROCK_VALUE) + BIG_ROCK_VALUE; }
@@ -81,21 +110,17 @@ class MediumRock : public Rocks
 {
 protected:
 	//These variables only need to be stored once for all instances of MediumRock
-	const static int radius = MEDIUM_ROCK_SIZE;
+	const static int size = MEDIUM_ROCK_SIZE;
 	const static int value = MEDIUM_ROCK_VALUE;
+	constexpr static float mass = MEDIUM_ROCK_MASS;
 public:
 	virtual ~MediumRock() override {   }
 	//For making a new MediumRock
 	MediumRock(const Point & point_);
 	//For when BigRock dies
 	MediumRock(const Point & point_, const Velocity & speed_, const bool & up);
-	virtual void draw() const override
-	{
-		drawMediumAsteroid(point, rotation);
-	}
 	virtual int getValue() const override { return value; }
-	virtual void advance() override;
-	int getRadius() const override { return radius; }
+	float getMass() const override { return mass; }
 	virtual std::vector<Rocks*> killRocks() override;
 
 	virtual int hit() override { return (2 * SMALL_ROCK_VALUE) + MEDIUM_ROCK_VALUE; }
@@ -105,8 +130,9 @@ class SmallRock : public Rocks
 {
 protected:
 	//These variables only need to be stored once for all instances of SmallRock
-	const static int radius = SMALL_ROCK_SIZE;
+	const static int size = SMALL_ROCK_SIZE;
 	const static int value = SMALL_ROCK_VALUE;
+	constexpr static float mass = SMALL_ROCK_MASS;
 public:
 	virtual ~SmallRock() override {   }
 	//For making a new SmallRock
@@ -116,13 +142,8 @@ public:
 	//For when MediumRock dies
 	SmallRock(const Point & point_, const Velocity & speed_, const bool & left);
 	virtual int getValue() const override { return value; }
-	virtual void draw() const override
-	{
-		drawSmallAsteroid(point, rotation);
-	}
-	virtual void advance() override;
 
-	int getRadius() const override { return radius; }
+	float getMass() const override { return mass; }
 	virtual std::vector<Rocks*> killRocks() override; 
 	virtual int hit() override { return SMALL_ROCK_VALUE; }
 };
@@ -0,0 +1,70 @@
+/*********************************************************************
+ * File: saucer.cpp
+ * Description: Contains the implementaiton of the saucer class
+ *  methods.
+ *********************************************************************/
+#include "saucer.h"
+#include "uiInteract.h"
+#include "trig.h"
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES 
+#include "math.h"
+
+#else // __linux__
+#include <cmath>
+
+#endif  //_WIN32
+
+//Starts with a random wait so a new flock does not all shoot at once
+Saucer::Saucer(const Point & point_, const Velocity & speed_)
+{
+	point = point_;
+	speed = speed_;
+	alive = true;
+	reload = random(1, (int)(SAUCER_RELOAD * FRAMES_VARIABLES_MULTIPLIER));
+}
+
+void Saucer::shoot()
+{
+	reload = (int)(SAUCER_RELOAD * FRAMES_VARIABLES_MULTIPLIER);
+}
+
+//The old flat saucer with a dome on top
+void Saucer::draw() const
+{
+	const float body[6][2] = { { -8, 0 }, { -4, 3 }, { 4, 3 }, { 8, 0 }, { 4, -3 }, { -4, -3 } };
+	const float dome[4][2] = { { -3, 3 }, { -2, 6 }, { 2, 6 }, { 3, 3 } };
+
+	for (int i = 0; i < 6; i++)
+		drawLine(Point(point.getX() + body[i][0], point.getY() + body[i][1]),
+		         Point(point.getX() + body[(i + 1) % 6][0], point.getY() + body[(i + 1) % 6][1]),
+		         0.4, 1.0, 0.4);
+	drawLine(Point(point.getX() - 8, point.getY()), Point(point.getX() + 8, point.getY()),
+	         0.4, 1.0, 0.4);
+	for (int i = 0; i < 3; i++)
+		drawLine(Point(point.getX() + dome[i][0], point.getY() + dome[i][1]),
+		         Point(point.getX() + dome[i + 1][0], point.getY() + dome[i + 1][1]),
+		         0.4, 1.0, 0.4);
+}
+
+SaucerShot::SaucerShot(const Point & point_, const float & angle, const Velocity & saucerV)
+{
+	speed.setDx((SAUCER_SHOT_SPEED / FRAMES_VARIABLES_MULTIPLIER) * cosDeg(angle) + saucerV.getDx());
+	speed.setDy((SAUCER_SHOT_SPEED / FRAMES_VARIABLES_MULTIPLIER) * sinDeg(angle) + saucerV.getDy());
+	point = point_;
+	currentLife = 0;
+	alive = true;
+}
+
+void SaucerShot::advance()
+{
+	if (currentLife == (SAUCER_SHOT_LIFE * FRAMES_VARIABLES_MULTIPLIER))
+		kill();
+	else
+	{
+		point.addX(speed.getDx());
+		point.addY(speed.getDy());
+		currentLife++;
+	}
+}
@@ -0,0 +1,67 @@
+/***********************************************************************
+ * Header File:
+ *    Saucer : an enemy that flies in flocks and shoots at the ship
+ * Summary:
+ *    A saucer only knows how to move, draw itself and count down to its
+ *    next shot. Where it wants to go is worked out for the whole flock at
+ *    once, see flock.h.
+ ************************************************************************/
+#ifndef SAUCER_H
+#define SAUCER_H
+
+#include "flyingObject.h"
+#include "bullet.h"
+#include "uiDraw.h"
+
+constexpr int SAUCER_SIZE = 8;
+constexpr int SAUCER_VALUE = 50;
+constexpr float SAUCER_SPEED = 3.0;       //fastest it can go (at 30 frames a second)
+constexpr int SAUCER_RELOAD = 90;         //ticks between shots (at 30 frames a second)
+constexpr float SAUCER_SHOT_SPEED = 4.0;
+constexpr int SAUCER_SHOT_LIFE = 60;
+constexpr float SAUCER_SHOT_RANGE = 300.0;  //how close the ship has to be to get shot at
+
+//A new flock of this many comes in every so often, until there are too many
+constexpr int SAUCER_FLOCK = 8;
+constexpr int SAUCER_MOST = 32;
+constexpr int SAUCER_SPAWN_TICKS = 150;     //(at 30 frames a second)
+
+class Saucer : public FlyingObject
+{
+protected:
+	//Ticks until it can shoot again
+	int reload;
+
+public:
+	Saucer(const Point & point_, const Velocity & speed_);
+	virtual ~Saucer() override {   }
+
+	virtual void draw() const override;
+
+	int getRadius() const { return SAUCER_SIZE; }
+	int getValue() const { return SAUCER_VALUE; }
+
+	//Counts down to the next shot, true when it is ready to take it
+	bool reloaded()
+	{
+		if (reload > 0)
+			reload--;
+		return reload == 0;
+	}
+	void shoot();
+};
+
+//What the saucers shoot at the ship
+class SaucerShot : public Bullet
+{
+public:
+	SaucerShot(const Point & point_, const float & angle, const Velocity & saucerV);
+	virtual ~SaucerShot() override {   }
+	virtual void draw() const override
+	{
+		drawCircle(point, 2);
+	}
+	virtual void advance() override;
+};
+
+#endif // SAUCER_H
@@ -7,6 +7,7 @@
 
 //only included for frames per second multiplier
 #include "uiInteract.h"
+#include "trig.h"
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES 
@@ -45,21 +46,21 @@ void Ship::rotate(const bool & left)
 
 void Ship::thrust()
 {
-	speed.setDx(speed.getDx() + ((THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle))));
-	speed.setDy(speed.getDy() + ((THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle))));
+	speed.setDx(speed.getDx() + ((THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle))));
+	speed.setDy(speed.getDy() + ((THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle))));
 }
 
 void Ship::reverseThruster() // Similar to stabilizers
 {
-	speed.setDx(speed.getDx() + ((REVERSE_THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * (angle + 180)))));
-	speed.setDy(speed.getDy() + ((REVERSE_THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * (angle + 180)))));
+	speed.setDx(speed.getDx() + ((REVERSE_THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle + 180))));
+	speed.setDy(speed.getDy() + ((REVERSE_THRUST_AMOUNT / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle + 180))));
 }
 
 void Ship::strafe(const bool & isLeft)
 {
 	rotate(isLeft);
-	speed.setDx(speed.getDx() + ((THRUST_STRAFE / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle))));
-	speed.setDy(speed.getDy() + ((THRUST_STRAFE / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle))));
+	speed.setDx(speed.getDx() + ((THRUST_STRAFE / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle))));
+	speed.setDy(speed.getDy() + ((THRUST_STRAFE / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle))));
 }
 
 void Ship::reset()
@@ -0,0 +1,52 @@
+/*********************************************************************
+ * File: shockwave.cpp
+ * Description: Contains the implementaiton of the shock wave class
+ *  methods.
+ *********************************************************************/
+#include "shockwave.h"
+#include "uiInteract.h"
+#include "uiDraw.h"
+
+void ShockWave::start(const Point & center_, float reach_)
+{
+	on = true;
+	center = center_;
+	radius = 0;
+	reach = reach_;
+}
+
+void ShockWave::advance(const SpatialGrid & grid, std::vector<int> & hits)
+{
+	hits.clear();
+	if (!on)
+		return;
+
+	radius += SHOCKWAVE_SPEED / FRAMES_VARIABLES_MULTIPLIER;
+	if (radius - SHOCKWAVE_THICKNESS > reach)
+	{
+		on = false;
+		return;
+	}
+
+	float inner = std::max(0.0f, radius - SHOCKWAVE_THICKNESS);
+	float x = center.getX();
+	float y = center.getY();
+	grid.ring(x, y, inner, radius, [&](const GridEntry & entry)
+	{
+		float dx = entry.x - x;
+		float dy = entry.y - y;
+		float distance = std::sqrt(dx * dx + dy * dy);
+		if (distance + entry.radius >= inner && distance - entry.radius <= radius)
+			hits.push_back(entry.id);
+	});
+}
+
+void ShockWave::draw() const
+{
+	if (!on)
+		return;
+	if (radius > 2.0f)
+		drawCircle(center, (int)radius);
+	if (radius - SHOCKWAVE_THICKNESS > 2.0f)
+		drawCircle(center, (int)(radius - SHOCKWAVE_THICKNESS));
+}
@@ -0,0 +1,54 @@
+/***********************************************************************
+ * Header File:
+ *    Shock Wave : a ring that grows out from where it was set off and
+ *    breaks up the rocks it passes over
+ * Summary:
+ *    Each tick only the band at the front of the ring is looked for in
+ *    the spatial grid, so a big field is broken up a little at a time as
+ *    the ring goes over it instead of all in one frame. A rock is under
+ *    the band for a few ticks, so it is split a few times on the way.
+ ************************************************************************/
+#ifndef SHOCKWAVE_H
+#define SHOCKWAVE_H
+
+#include "point.h"
+#include "spatialGrid.h"
+
+#include <vector>
+
+//How far the ring grows each tick (at 30 frames a second)
+constexpr float SHOCKWAVE_SPEED = 24.0;
+
+//How wide the band at the front of the ring is
+constexpr float SHOCKWAVE_THICKNESS = 40.0;
+
+class ShockWave
+{
+public:
+	ShockWave() : on(false), radius(0), reach(0) {   }
+
+	//Set it off at center, it is done once it has grown out to reach
+	void start(const Point & center, float reach);
+	void stop() { on = false; }
+
+	bool isOn() const { return on; }
+	const Point & getCenter() const { return center; }
+	float getRadius() const { return radius; }
+
+	/******************************************
+	 * ADVANCE
+	 * Grow the ring one tick and put the id of everything in grid the
+	 * band at its front is over in hits.
+	 ******************************************/
+	void advance(const SpatialGrid & grid, std::vector<int> & hits);
+
+	void draw() const;
+
+private:
+	bool on;
+	Point center;
+	float radius;
+	float reach;
+};
+
+#endif // SHOCKWAVE_H
@@ -0,0 +1,97 @@
+/*********************************************************************
+ * File: spatialGrid.cpp
+ * Description: Contains the implementaiton of the spatial grid class
+ *  methods.
+ *********************************************************************/
+#include "spatialGrid.h"
+
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize)
+	: cellSize(cellSize), usedCellSize(cellSize), minX(0), minY(0),
+	  columns(1), rows(1), maxRadius(0)
+{
+	cellStart.assign(2, 0);
+}
+
+void SpatialGrid::clear()
+{
+	pending.clear();
+	entries.clear();
+	cellStart.assign(2, 0);
+	columns = 1;
+	rows = 1;
+	maxRadius = 0;
+}
+
+void SpatialGrid::insert(int id, const Point & center, float radius)
+{
+	GridEntry entry;
+	entry.x = center.getX();
+	entry.y = center.getY();
+	entry.radius = radius;
+	entry.id = id;
+	pending.push_back(entry);
+}
+
+/******************************************
+ * BUILD
+ * The grid only covers the area the objects are in. If they are
+ * spread so thin that there would be far more cells than objects, the
+ * cells are made bigger so the grid never costs more than O(n).
+ ******************************************/
+void SpatialGrid::build()
+{
+	entries.resize(pending.size());
+	if (pending.empty())
+	{
+		cellStart.assign(2, 0);
+		return;
+	}
+
+	float maxX = pending[0].x;
+	float maxY = pending[0].y;
+	minX = pending[0].x;
+	minY = pending[0].y;
+	maxRadius = 0;
+	for (int i = 0; i < (int)pending.size(); i++)
+	{
+		minX = std::min(minX, pending[i].x);
+		minY = std::min(minY, pending[i].y);
+		maxX = std::max(maxX, pending[i].x);
+		maxY = std::max(maxY, pending[i].y);
+		maxRadius = std::max(maxRadius, pending[i].radius);
+	}
+
+	usedCellSize = cellSize;
+	float maxCells = 4.0f * pending.size() + 64.0f;
+	float cells = ((maxX - minX) / usedCellSize + 1) * ((maxY - minY) / usedCellSize + 1);
+	if (cells > maxCells)
+		usedCellSize *= std::sqrt(cells / maxCells);
+
+	columns = (int)((maxX - minX) / usedCellSize) + 1;
+	rows = (int)((maxY - minY) / usedCellSize) + 1;
+
+	// count how many land in each cell, then turn the counts into offsets
+	cellStart.assign(columns * rows + 1, 0);
+	for (int i = 0; i < (int)pending.size(); i++)
+		cellStart[rowOf(pending[i].y) * columns + columnOf(pending[i].x) + 1]++;
+	for (int cell = 0; cell < columns * rows; cell++)
+		cellStart[cell + 1] += cellStart[cell];
+
+	std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+	for (int i = 0; i < (int)pending.size(); i++)
+		entries[next[rowOf(pending[i].y) * columns + columnOf(pending[i].x)]++] = pending[i];
+}
+
+int SpatialGrid::columnOf(float x) const
+{
+	int col = (int)((x - minX) / usedCellSize);
+	return std::max(0, std::min(columns - 1, col));
+}
+
+int SpatialGrid::rowOf(float y) const
+{
+	int row = (int)((y - minY) / usedCellSize);
+	return std::max(0, std::min(rows - 1, row));
+}
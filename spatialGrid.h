@@ -0,0 +1,361 @@
+/***********************************************************************
+ * Header File:
+ *    Spatial Grid : a uniform grid used to find objects that are near
+ *    each other without checking every pair
+ * Summary:
+ *    Objects are inserted by their center, then build() sorts them into
+ *    cells (a counting sort, so it is O(n)). Queries only look at the
+ *    cells that could hold a circle touching the requested area, so the
+ *    caller still has to do its own exact test on what it is handed.
+ *    The grid is meant to be cleared and rebuilt every frame.
+ ************************************************************************/
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "point.h"
+
+//Default size of each cell. Should be at least the diameter of a big rock.
+constexpr float GRID_CELL_SIZE = 32.0;
+
+//What the grid hands back. id is whatever the caller used to insert it.
+struct GridEntry
+{
+	float x;
+	float y;
+	float radius;
+	int id;
+};
+
+class SpatialGrid
+{
+public:
+	SpatialGrid(float cellSize = GRID_CELL_SIZE);
+
+	//Throw away everything in the grid (keeps the memory)
+	void clear();
+
+	//Add an object. Nothing can be queried until build() is called.
+	void insert(int id, const Point & center, float radius);
+
+	//Sort everything that was inserted into its cell.
+	void build();
+
+	int size() const { return (int)entries.size(); }
+	float getCellSize() const { return cellSize; }
+	float getUsedCellSize() const { return usedCellSize; }
+	float getMaxRadius() const { return maxRadius; }
+
+	/******************************************
+	 * QUERY
+	 * Visit every entry whose circle could touch the given box.
+	 ******************************************/
+	template <class Visitor>
+	void query(float left, float bottom, float right, float top, Visitor visit) const
+	{
+		if (entries.empty())
+			return;
+		int colMin = columnOf(left - maxRadius);
+		int colMax = columnOf(right + maxRadius);
+		int rowMin = rowOf(bottom - maxRadius);
+		int rowMax = rowOf(top + maxRadius);
+		for (int row = rowMin; row <= rowMax; row++)
+			for (int col = colMin; col <= colMax; col++)
+			{
+				int cell = row * columns + col;
+				for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+					visit(entries[i]);
+			}
+	}
+
+	/******************************************
+	 * RING
+	 * Visit every entry whose circle could touch the ring around (x, y)
+	 * from inner out to outer. Each row only looks at the cells under the
+	 * two ends of the ring, not the ones inside it, so the cost goes with
+	 * how long the ring is and not how much it covers.
+	 ******************************************/
+	template <class Visitor>
+	void ring(float x, float y, float inner, float outer, Visitor visit) const
+	{
+		if (entries.empty())
+			return;
+		float outerReach = outer + maxRadius;
+		float innerReach = inner - maxRadius;
+		int rowMin = rowOf(y - outerReach);
+		int rowMax = rowOf(y + outerReach);
+		for (int row = rowMin; row <= rowMax; row++)
+		{
+			// the nearest and farthest the row gets from the center up and down
+			float bottom = minY + row * usedCellSize;
+			float top = bottom + usedCellSize;
+			float nearY = (y < bottom) ? bottom - y : ((y > top) ? y - top : 0.0f);
+			float farY = std::max(std::abs(bottom - y), std::abs(top - y));
+			if (nearY > outerReach)
+				continue;
+			float halfOuter = std::sqrt(outerReach * outerReach - nearY * nearY);
+			int colMin = columnOf(x - halfOuter);
+			int colMax = columnOf(x + halfOuter);
+
+			// the cells in the middle of the row that are all inside the ring
+			int skipMin = colMax + 1;
+			int skipMax = colMax;
+			if (innerReach > farY)
+			{
+				float halfInner = std::sqrt(innerReach * innerReach - farY * farY);
+				skipMin = (int)std::ceil((x - halfInner - minX) / usedCellSize);
+				skipMax = (int)std::floor((x + halfInner - minX) / usedCellSize) - 1;
+			}
+
+			for (int col = colMin; col <= colMax; col++)
+			{
+				if (col >= skipMin && col <= skipMax)
+				{
+					col = skipMax;
+					continue;
+				}
+				int cell = row * columns + col;
+				for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+					visit(entries[i]);
+			}
+		}
+	}
+
+	/******************************************
+	 * FOR EACH PAIR
+	 * Visit every pair of entries that are close enough that their
+	 * circles could be touching. Each pair is only visited once.
+	 ******************************************/
+	template <class Visitor>
+	void forEachPair(Visitor visit) const
+	{
+		if (entries.empty())
+			return;
+		//how many cells over can a touching neighbor be?
+		int reach = (int)std::ceil((2.0f * maxRadius) / usedCellSize);
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < columns; col++)
+			{
+				int cell = row * columns + col;
+				int begin = cellStart[cell];
+				int end = cellStart[cell + 1];
+				if (begin == end)
+					continue;
+
+				//pairs inside this cell
+				for (int i = begin; i < end; i++)
+					for (int j = i + 1; j < end; j++)
+						visit(entries[i], entries[j]);
+
+				//pairs with the neighbors "after" this one so nothing is seen twice
+				for (int dRow = 0; dRow <= reach; dRow++)
+					for (int dCol = -reach; dCol <= reach; dCol++)
+					{
+						if (dRow == 0 && dCol <= 0)
+							continue;
+						int nRow = row + dRow;
+						int nCol = col + dCol;
+						if (nRow >= rows || nCol < 0 || nCol >= columns)
+							continue;
+						int other = nRow * columns + nCol;
+						for (int i = begin; i < end; i++)
+							for (int j = cellStart[other]; j < cellStart[other + 1]; j++)
+								visit(entries[i], entries[j]);
+					}
+			}
+	}
+
+	/******************************************
+	 * TRACE
+	 * Walk the cells under a ray from (x, y) going (dirX, dirY) (which
+	 * must be one unit long) for length, one cell at a time, and visit
+	 * every entry whose circle could touch it. The entries come in
+	 * roughly the order the ray reaches them. visit(entry, along) is also
+	 * handed how far along the ray the walk is, and returns false to
+	 * stop the walk. Each entry is visited at most once.
+	 ******************************************/
+	template <class Visitor>
+	void trace(float x, float y, float dirX, float dirY, float length, Visitor visit) const
+	{
+		if (entries.empty())
+			return;
+
+		// an entry can be this many cells over from the cell the ray is in
+		int reach = (int)std::ceil(maxRadius / usedCellSize);
+		float gridX = (x - minX) / usedCellSize;
+		float gridY = (y - minY) / usedCellSize;
+		int col = (int)std::floor(gridX);
+		int row = (int)std::floor(gridY);
+		int stepCol = (dirX > 0) ? 1 : -1;
+		int stepRow = (dirY > 0) ? 1 : -1;
+
+		// how far along the ray the next column and row start, and how far apart they are
+		const float never = length + 1.0f;
+		float nextX = never;
+		float nextY = never;
+		float gapX = never;
+		float gapY = never;
+		if (dirX != 0)
+		{
+			gapX = usedCellSize / std::abs(dirX);
+			nextX = ((dirX > 0) ? (col + 1 - gridX) : (gridX - col)) * gapX;
+		}
+		if (dirY != 0)
+		{
+			gapY = usedCellSize / std::abs(dirY);
+			nextY = ((dirY > 0) ? (row + 1 - gridY) : (gridY - row)) * gapY;
+		}
+
+		auto visitCells = [&](int colMin, int colMax, int rowMin, int rowMax, float along) -> bool
+		{
+			colMin = std::max(colMin, 0);
+			colMax = std::min(colMax, columns - 1);
+			rowMin = std::max(rowMin, 0);
+			rowMax = std::min(rowMax, rows - 1);
+			for (int r = rowMin; r <= rowMax; r++)
+				for (int c = colMin; c <= colMax; c++)
+				{
+					int cell = r * columns + c;
+					for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+						if (!visit(entries[i], along))
+							return false;
+				}
+			return true;
+		};
+
+		// the block of cells around the start, then only the new row or
+		// column of the block each time the ray steps into the next cell
+		if (!visitCells(col - reach, col + reach, row - reach, row + reach, 0.0f))
+			return;
+		while (true)
+		{
+			bool more;
+			if (nextX < nextY)
+			{
+				if (nextX > length)
+					return;
+				col += stepCol;
+				int edge = col + stepCol * reach;
+				more = visitCells(edge, edge, row - reach, row + reach, nextX);
+				nextX += gapX;
+			}
+			else
+			{
+				if (nextY > length)
+					return;
+				row += stepRow;
+				int edge = row + stepRow * reach;
+				more = visitCells(col - reach, col + reach, edge, edge, nextY);
+				nextY += gapY;
+			}
+			if (!more)
+				return;
+		}
+	}
+
+	/******************************************
+	 * NEAREST
+	 * Find up to k entries that accept(entry) says yes to, closest
+	 * (center to center) to (x, y) first, and no further than
+	 * maxDistance. Looks at the rings of cells around the point one at a
+	 * time and stops once nothing in the next ring could be closer than
+	 * what it already has.
+	 ******************************************/
+	template <class Filter>
+	void nearest(float x, float y, int k, float maxDistance, Filter accept,
+	             std::vector<GridEntry> & found) const
+	{
+		found.clear();
+		if (entries.empty() || k <= 0)
+			return;
+
+		auto distanceSq = [x, y](const GridEntry & entry) -> float
+		{
+			float dx = entry.x - x;
+			float dy = entry.y - y;
+			return dx * dx + dy * dy;
+		};
+		const float maxSq = maxDistance * maxDistance;
+
+		// keep found sorted nearest first, dropping whatever falls off the end
+		auto consider = [&](const GridEntry & entry)
+		{
+			float dSq = distanceSq(entry);
+			if (dSq > maxSq)
+				return;
+			if ((int)found.size() == k && dSq >= distanceSq(found.back()))
+				return;
+			if (!accept(entry))
+				return;
+			if ((int)found.size() == k)
+				found.pop_back();
+			int at = (int)found.size();
+			found.push_back(entry);
+			while (at > 0 && distanceSq(found[at - 1]) > dSq)
+			{
+				found[at] = found[at - 1];
+				at--;
+			}
+			found[at] = entry;
+		};
+
+		auto visitCells = [&](int colMin, int colMax, int rowMin, int rowMax)
+		{
+			colMin = std::max(colMin, 0);
+			colMax = std::min(colMax, columns - 1);
+			rowMin = std::max(rowMin, 0);
+			rowMax = std::min(rowMax, rows - 1);
+			for (int r = rowMin; r <= rowMax; r++)
+				for (int c = colMin; c <= colMax; c++)
+				{
+					int cell = r * columns + c;
+					for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+						consider(entries[i]);
+				}
+		};
+
+		// not clamped, so the point can be off the grid and the rings still work
+		int col = (int)std::floor((x - minX) / usedCellSize);
+		int row = (int)std::floor((y - minY) / usedCellSize);
+		int lastRing = std::max(std::max(col, columns - 1 - col), std::max(row, rows - 1 - row));
+		for (int ring = 0; ring <= lastRing; ring++)
+		{
+			if (ring == 0)
+				visitCells(col, col, row, row);
+			else
+			{
+				visitCells(col - ring, col + ring, row - ring, row - ring);
+				visitCells(col - ring, col + ring, row + ring, row + ring);
+				visitCells(col - ring, col - ring, row - ring + 1, row + ring - 1);
+				visitCells(col + ring, col + ring, row - ring + 1, row + ring - 1);
+			}
+
+			// everything past this ring is at least this far away
+			float reached = ring * usedCellSize;
+			if (reached > maxDistance)
+				return;
+			if ((int)found.size() == k && distanceSq(found.back()) <= reached * reached)
+				return;
+		}
+	}
+
+private:
+	int columnOf(float x) const;
+	int rowOf(float y) const;
+
+	float cellSize;      // the size asked for
+	float usedCellSize;  // may be bigger when objects are spread very thin
+	float minX;          // bottom left corner of the grid
+	float minY;
+	int columns;
+	int rows;
+	float maxRadius;     // biggest radius inserted, queries grow by this much
+
+	std::vector<GridEntry> pending;  // what was inserted since the last clear
+	std::vector<GridEntry> entries;  // same thing sorted by cell
+	std::vector<int> cellStart;      // where each cell starts in entries
+};
+
+#endif // SPATIAL_GRID_H
@@ -5,6 +5,7 @@
  *********************************************************************/
 #include "stars.h"
 #include "uiInteract.h"
+#include "trig.h"
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES 
@@ -25,8 +26,8 @@ RedStar::RedStar(const Point & point_)
 	float dx;
 	float dy;
 
-	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
@@ -55,8 +56,8 @@ BlueStar::BlueStar(const Point & point_)
 	float dx;
 	float dy;
 
-	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
@@ -72,8 +73,8 @@ WhiteStar::WhiteStar(const Point & point_)
 	float dx;
 	float dy;
 
-	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cos(M_PI / 180.0 * angle));
-	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sin(M_PI / 180.0 * angle));
+	dx = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (cosDeg(angle));
+	dy = (STAR_SPEED / FRAMES_VARIABLES_MULTIPLIER) * (sinDeg(angle));
 
 	speed.setDx(dx);
 	speed.setDy(dy);
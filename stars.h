@@ -33,6 +33,13 @@ public:
 	//Virtual destructor for child classes
 	virtual ~Stars() override { };
 	float getRotation() const { return rotation; }
+	//Stars far from the ship are left behind (see Game::move), this is
+	//where they would have been if they had been moved every tick
+	virtual Point getCurrentPoint() const override
+	{
+		float ticks = (float)getLag();
+		return Point(point.getX() + speed.getDx() * ticks, point.getY() + speed.getDy() * ticks);
+	}
 	//Purely Virtual since all stars are different color
 	virtual void draw() const = 0;
 	void advance() override;
@@ -0,0 +1,170 @@
+/*********************************************************************
+ * File: stress.cpp
+ * Description: Contains the implementaiton of the stress test.
+ *********************************************************************/
+#include "stress.h"
+#include "raster.h"
+#include "frameCapture.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <cstdlib>
+#include <iomanip>
+
+StressTest::StressTest(Game & game, const StressTargets & targets, bool windowed)
+	: game(game), targets(targets), windowed(windowed), done(false),
+	  step(0), tick(0), tickTotal(0), drawTotal(0), entityTotal(0)
+{
+	// the same field every run
+	srand(1);
+}
+
+bool StressTest::frame(const Interface & ui)
+{
+	if (done)
+		return false;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	game.advance();
+	game.handleInput(ui);
+	auto middle = std::chrono::high_resolution_clock::now();
+	if (windowed)
+		game.draw(ui);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	// each step is double the one before, the last one is the targets
+	double fraction = 1.0 / (1 << (STRESS_STEPS - 1 - step));
+	game.stress((int)(targets.rocks * fraction), (int)(targets.bullets * fraction),
+	            (int)(targets.stars * fraction));
+
+	if (tick >= STRESS_SETTLE_TICKS)
+	{
+		tickTotal += std::chrono::duration<double, std::milli>(middle - start).count();
+		drawTotal += std::chrono::duration<double, std::milli>(end - middle).count();
+		entityTotal += game.getEntityCount();
+	}
+
+	if (++tick == STRESS_SETTLE_TICKS + STRESS_MEASURE_TICKS)
+	{
+		StressResult result;
+		result.entities = (int)(entityTotal / STRESS_MEASURE_TICKS);
+		result.tickTime = tickTotal / STRESS_MEASURE_TICKS;
+		result.drawTime = drawTotal / STRESS_MEASURE_TICKS;
+		results.push_back(result);
+
+		step++;
+		tick = 0;
+		tickTotal = 0;
+		drawTotal = 0;
+		entityTotal = 0;
+		if (step == STRESS_STEPS || result.tickTime + result.drawTime > STRESS_GIVE_UP)
+			done = true;
+	}
+	return !done;
+}
+
+void StressTest::report(std::ostream & out) const
+{
+	out << "Stress: milliseconds per tick, averaged over " << STRESS_MEASURE_TICKS << " ticks"
+	    << (windowed ? "" : " (no window, so no drawing)") << "\n";
+	out << std::setw(10) << "entities" << std::setw(14) << "tick" << std::setw(14) << "draw"
+	    << std::setw(14) << "total" << "\n";
+
+	int broken = -1;
+	for (int i = 0; i < (int)results.size(); i++)
+	{
+		double total = results[i].tickTime + results[i].drawTime;
+		out << std::setw(10) << results[i].entities << std::fixed << std::setprecision(3)
+		    << std::setw(14) << results[i].tickTime;
+		if (windowed)
+			out << std::setw(14) << results[i].drawTime;
+		else
+			out << std::setw(14) << "-";
+		out << std::setw(14) << total << "\n";
+		if (broken < 0 && total > STRESS_FRAME_BUDGET)
+			broken = i;
+	}
+
+	out << std::setprecision(2);
+	if (broken < 0)
+		out << "The " << STRESS_FRAME_BUDGET << " ms frame budget held all the way\n";
+	else if (broken == 0)
+		out << "The " << STRESS_FRAME_BUDGET << " ms frame budget was already broken at "
+		    << results[0].entities << " entities\n";
+	else
+		out << "The " << STRESS_FRAME_BUDGET << " ms frame budget broke between "
+		    << results[broken - 1].entities << " and " << results[broken].entities << " entities\n";
+	if (results.size() < STRESS_STEPS)
+		out << "Stopped early, a tick took over " << STRESS_GIVE_UP << " ms\n";
+}
+
+void runStress(std::ostream & out, const StressTargets & targets, Point topLeft, Point bottomRight)
+{
+	Interface::setHeadless();
+	Interface ui;
+	ui.setStress(true);
+
+	Game game(topLeft, bottomRight);
+	StressTest test(game, targets, false);
+	while (test.frame(ui))
+		;
+	test.report(out);
+}
+
+bool runSnapshot(const char * fileName, int ticks, int rocks, Point topLeft, Point bottomRight)
+{
+	Interface::setHeadless();
+	Interface ui;
+	ui.setStress(true);
+
+	srand(1);
+	Game game(topLeft, bottomRight);
+	Raster raster((int)(bottomRight.getX() - topLeft.getX()), (int)(topLeft.getY() - bottomRight.getY()));
+	raster.setView(topLeft, bottomRight);
+
+	// every tick is recorded, and the writer is waited for when it falls
+	// behind, since nothing here has to keep up with a screen
+	int length = (int)strlen(fileName);
+	if (strchr(fileName, '%') || (length > 4 && strcmp(fileName + length - 4, ".y4m") == 0))
+	{
+		FrameCapture capture(fileName, raster.getWidth(), raster.getHeight(), 1, (int)(ui.frameRate() + 0.5));
+		if (!capture.isOpen())
+			return false;
+		for (int tick = 0; tick < ticks; tick++)
+		{
+			game.stress(rocks, 0, 0);
+			game.advance();
+			game.handleInput(ui);
+			raster.clear();
+			beginSoftware(raster);
+			game.draw(ui);
+			endSoftware();
+			while (!capture.add(raster.getPixels(), false))
+				std::this_thread::yield();
+		}
+		capture.finish();
+		return capture.getWritten() == ticks;
+	}
+
+	for (int tick = 0; tick < ticks; tick++)
+	{
+		game.stress(rocks, 0, 0);
+		game.advance();
+		game.handleInput(ui);
+	}
+	beginSoftware(raster);
+	game.draw(ui);
+	endSoftware();
+	return raster.writePpm(fileName);
+}
+
+void stressCallBack(const Interface * pUI, void * p)
+{
+	StressTest * pTest = (StressTest *)p;
+	if (!pTest->frame(*pUI))
+	{
+		pTest->report(std::cout);
+		Interface::leave(0);
+	}
+}
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * Header File:
+ *    Stress Test : plays the game by itself with more and more rocks,
+ *    bullets and stars, timing every tick
+ * Summary:
+ *    The field is grown in steps, doubling each time, until it reaches
+ *    the targets. Each step is given a few ticks to settle and then the
+ *    time to advance the game (and draw it, when there is a window) is
+ *    averaged. The report shows the curve and how many objects it took
+ *    to go over the time there is for one frame at 60 fps.
+ *
+ *    It can run in a window (to count the drawing too) or without one
+ *    (to run anywhere). Either way it always starts from the same seed
+ *    so runs can be compared with each other.
+ ************************************************************************/
+#ifndef STRESS_H
+#define STRESS_H
+
+#include "game.h"
+#include "uiInteract.h"
+
+#include <iostream>
+#include <vector>
+
+//Default targets, a million objects in all
+constexpr int STRESS_ROCKS = 800000;
+constexpr int STRESS_BULLETS = 150000;
+constexpr int STRESS_STARS = 50000;
+
+//How many times the field doubles on its way to the targets
+constexpr int STRESS_STEPS = 11;
+
+//Ticks to let each step settle, then ticks to average over
+constexpr int STRESS_SETTLE_TICKS = 10;
+constexpr int STRESS_MEASURE_TICKS = 30;
+
+//Time there is for one frame at 60 fps (milliseconds)
+constexpr double STRESS_FRAME_BUDGET = 1000.0 / 60.0;
+
+//Ticks the game plays for, and rocks in it, before a snapshot is taken
+constexpr int SNAPSHOT_TICKS = 60;
+constexpr int SNAPSHOT_ROCKS = 200;
+
+//Once a tick takes this long (milliseconds) there is no point going further
+constexpr double STRESS_GIVE_UP = 1000.0;
+
+struct StressTargets
+{
+	int rocks;
+	int bullets;
+	int stars;
+};
+
+//One row of the report
+struct StressResult
+{
+	int entities;
+	double tickTime;   // milliseconds
+	double drawTime;   // milliseconds, 0 without a window
+};
+
+class StressTest
+{
+public:
+	StressTest(Game & game, const StressTargets & targets, bool windowed);
+
+	//Run one frame of the test. Returns false once the test is over.
+	bool frame(const Interface & ui);
+
+	bool isDone() const { return done; }
+
+	//Print the curve and where the frame budget was broken
+	void report(std::ostream & out) const;
+
+private:
+	Game & game;
+	StressTargets targets;
+	bool windowed;
+	bool done;
+
+	int step;
+	int tick;
+	double tickTotal;
+	double drawTotal;
+	double entityTotal;
+	std::vector<StressResult> results;
+};
+
+/******************************************
+ * RUN STRESS
+ * Run the whole test without a window on a screen of the given size
+ * and print the report.
+ ******************************************/
+void runStress(std::ostream & out, const StressTargets & targets, Point topLeft, Point bottomRight);
+
+/******************************************
+ * RUN SNAPSHOT
+ * Play the game by itself without a window for ticks with the given
+ * number of rocks, draw it in software (see raster.h) and save it as a
+ * PPM in fileName. A fileName ending in .y4m, or with a % in it, records
+ * every tick instead (see frameCapture.h). Returns false if it could not
+ * be saved.
+ ******************************************/
+bool runSnapshot(const char * fileName, int ticks, int rocks, Point topLeft, Point bottomRight);
+
+/******************************************
+ * STRESS CALL BACK
+ * Used in place of the normal call back when the test runs in a window.
+ * p is the StressTest. Prints the report and quits when it is done.
+ ******************************************/
+void stressCallBack(const Interface * pUI, void * p);
+
+#endif // STRESS_H
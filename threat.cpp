@@ -0,0 +1,530 @@
+/*********************************************************************
+ * File: threat.cpp
+ * Description: Contains the implementaiton of the threat tracker class
+ *  methods.
+ *********************************************************************/
+#include "threat.h"
+
+#include <algorithm>
+#include <cmath>
+
+//Longer than anything will ever go without wrapping
+constexpr int THREAT_NEVER = 1 << 28;
+
+ThreatTracker::ThreatTracker()
+	: halfWidth(0), halfHeight(0), now(0), rescans(0), rechecks(0)
+{
+}
+
+void ThreatTracker::setWorld(const Point & topLeft, const Point & bottomRight)
+{
+	halfWidth = bottomRight.getX();
+	halfHeight = topLeft.getY();
+	clear();
+}
+
+int ThreatTracker::watch(float reach, int ticks)
+{
+	Watcher watcher;
+	watcher.reach = reach;
+	watcher.ticks = ticks;
+	watcher.horizon = now;
+	watcher.drift = 0;
+	watchers.push_back(watcher);
+	return (int)watchers.size() - 1;
+}
+
+/******************************************
+ * FOLLOW
+ * Only lay the watcher's path again if it is not where its line said
+ * it would be, or will not be by the end of the ticks it looks ahead
+ * because its speed changed. Then only the rocks in the corridor the
+ * path swept are checked again. The whole list is worked out again
+ * when it does not see far enough ahead any more; it looks twice as
+ * far ahead as asked so this is not every tick.
+ ******************************************/
+void ThreatTracker::follow(int which, const Point & point, const Velocity & velocity, int radius)
+{
+	Watcher & watcher = watchers[which];
+	if (watcher.path.empty() || now + watcher.ticks > watcher.horizon)
+	{
+		rescan(watcher, point, velocity, radius);
+		return;
+	}
+
+	while (watcher.path.size() > 1 && watcher.path[0].until <= now)
+		watcher.path.erase(watcher.path.begin());
+	const Line & line = watcher.path[0];
+	float dx = line.x + line.dx * (now - line.since) - point.getX();
+	float dy = line.y + line.dy * (now - line.since) - point.getY();
+	float turnX = line.dx - velocity.getDx();
+	float turnY = line.dy - velocity.getDy();
+	float shift = std::sqrt(dx * dx + dy * dy);
+	float turn = std::sqrt(turnX * turnX + turnY * turnY);
+	if (shift + turn * watcher.ticks <= THREAT_SLACK)
+		return;
+
+	// the new path goes out to the same horizon, so the clearances still
+	// cover it. If it wraps where the old one did not, the two can be a
+	// world apart for a while, so everything is looked at again.
+	layPath(nextPath, point, velocity, radius, watcher.horizon);
+	if (!sameWraps(watcher.path, nextPath))
+	{
+		rescan(watcher, point, velocity, radius);
+		return;
+	}
+	watcher.path.swap(nextPath);
+	watcher.drift += shift + turn * (watcher.horizon - now);
+
+	// every rock whose clearance the path could have crossed. They are
+	// all taken off first, since the ones still in reach go back on under
+	// the drift.
+	auto smaller = [](const Margin & a, const Margin & b) { return a.key > b.key; };
+	rechecking.clear();
+	while (!watcher.margins.empty() && watcher.margins.front().key < watcher.drift)
+	{
+		std::pop_heap(watcher.margins.begin(), watcher.margins.end(), smaller);
+		Margin margin = watcher.margins.back();
+		watcher.margins.pop_back();
+		if (watcher.keys[margin.slot] != margin.key)
+			continue;
+		watcher.keys[margin.slot] = NAN;
+		if (tracked[margin.slot].rock && !tracked[margin.slot].pending)
+			rechecking.push_back(margin.slot);
+	}
+	for (int i = 0; i < (int)rechecking.size(); i++)
+	{
+		forget(watcher, tracked[rechecking[i]].rock);
+		check(watcher, rechecking[i]);
+	}
+	rechecks += (int)rechecking.size();
+}
+
+/******************************************
+ * RESCAN
+ * Lay the path out to twice the ticks asked for and check every rock
+ * against it
+ ******************************************/
+void ThreatTracker::rescan(Watcher & watcher, const Point & point, const Velocity & velocity, int radius)
+{
+	rescans++;
+	watcher.horizon = now + 2 * watcher.ticks;
+	layPath(watcher.path, point, velocity, radius, watcher.horizon);
+
+	watcher.threats.clear();
+	watcher.drift = 0;
+	watcher.keys.assign(tracked.size(), NAN);
+	watcher.margins.clear();
+	for (int slot = 0; slot < (int)tracked.size(); slot++)
+	{
+		if (tracked[slot].rock && !tracked[slot].pending)
+			check(watcher, slot);
+	}
+}
+
+void ThreatTracker::add(Rocks * rock)
+{
+	if (slots.count(rock))
+	{
+		update(rock);
+		return;
+	}
+
+	int slot;
+	if (unused.empty())
+	{
+		slot = (int)tracked.size();
+		tracked.push_back(Tracked());
+	}
+	else
+	{
+		slot = unused.back();
+		unused.pop_back();
+	}
+	tracked[slot].rock = rock;
+	tracked[slot].event = THREAT_NEVER;
+	tracked[slot].pending = true;
+	slots[rock] = slot;
+	waiting.push_back(slot);
+}
+
+void ThreatTracker::update(Rocks * rock)
+{
+	auto found = slots.find(rock);
+	if (found == slots.end())
+	{
+		add(rock);
+		return;
+	}
+	// a bounce or a pull that came to nothing leaves the line as it is
+	Tracked & rockTracked = tracked[found->second];
+	if (!rockTracked.pending && rock->getVelocity().getDx() == rockTracked.line.dx &&
+	    rock->getVelocity().getDy() == rockTracked.line.dy)
+		return;
+	if (!rockTracked.pending)
+	{
+		rockTracked.pending = true;
+		waiting.push_back(found->second);
+	}
+}
+
+void ThreatTracker::remove(Rocks * rock)
+{
+	auto found = slots.find(rock);
+	if (found == slots.end())
+		return;
+	for (int i = 0; i < (int)watchers.size(); i++)
+	{
+		forget(watchers[i], rock);
+		if (found->second < (int)watchers[i].keys.size())
+			watchers[i].keys[found->second] = NAN;
+	}
+	tracked[found->second].rock = NULL;
+	tracked[found->second].pending = false;
+	unused.push_back(found->second);
+	slots.erase(found);
+}
+
+void ThreatTracker::clear()
+{
+	tracked.clear();
+	unused.clear();
+	slots.clear();
+	waiting.clear();
+	events.clear();
+	for (int i = 0; i < (int)watchers.size(); i++)
+	{
+		watchers[i].path.clear();
+		watchers[i].threats.clear();
+		watchers[i].drift = 0;
+		watchers[i].keys.clear();
+		watchers[i].margins.clear();
+	}
+}
+
+/******************************************
+ * TICK
+ * Read the rocks that were added or changed, and put the ones that
+ * wrapped this tick on the line they come out on. check() already
+ * followed them across, so they are not checked again.
+ ******************************************/
+void ThreatTracker::tick()
+{
+	now++;
+	for (int i = 0; i < (int)waiting.size(); i++)
+	{
+		if (tracked[waiting[i]].rock && tracked[waiting[i]].pending)
+			anchor(waiting[i]);
+	}
+	waiting.clear();
+
+	auto later = [](const Event & a, const Event & b) { return a.when > b.when; };
+	while (!events.empty() && events.front().when <= now)
+	{
+		std::pop_heap(events.begin(), events.end(), later);
+		Event event = events.back();
+		events.pop_back();
+		Tracked & rockTracked = tracked[event.slot];
+		if (!rockTracked.rock || rockTracked.pending || rockTracked.event != event.when)
+			continue;
+		while (rockTracked.line.until <= now)
+			nextLine(rockTracked.line);
+		rockTracked.event = rockTracked.line.until;
+		pushEvent(event.slot);
+	}
+
+	// rocks that change speed every tick leave a lot of old events behind
+	if (events.size() > 2 * slots.size() + 64)
+	{
+		events.clear();
+		for (int slot = 0; slot < (int)tracked.size(); slot++)
+		{
+			if (tracked[slot].rock && !tracked[slot].pending)
+				pushEvent(slot);
+		}
+	}
+
+	for (int i = 0; i < (int)watchers.size(); i++)
+	{
+		// and so do rocks that are checked again and again
+		Watcher & watcher = watchers[i];
+		if (watcher.margins.size() > 2 * slots.size() + 64)
+		{
+			watcher.margins.clear();
+			for (int slot = 0; slot < (int)watcher.keys.size(); slot++)
+			{
+				if (!std::isnan(watcher.keys[slot]))
+					watcher.margins.push_back({ watcher.keys[slot], slot });
+			}
+			std::make_heap(watcher.margins.begin(), watcher.margins.end(),
+			               [](const Margin & a, const Margin & b) { return a.key > b.key; });
+		}
+
+		std::vector<Threat> & threats = watchers[i].threats;
+		threats.erase(std::remove_if(threats.begin(), threats.end(),
+		              [this](const Threat & threat) { return threat.leave < now; }), threats.end());
+	}
+}
+
+void ThreatTracker::getThreats(int which, int ticks, std::vector<Threat> & found) const
+{
+	found.clear();
+	const std::vector<Threat> & threats = watchers[which].threats;
+	for (int i = 0; i < (int)threats.size() && threats[i].enter <= now + ticks; i++)
+	{
+		if (threats[i].leave < now)
+			continue;
+		Threat threat = threats[i];
+		threat.enter = std::max(0.0f, threat.enter - now);
+		threat.closest = std::max(0.0f, threat.closest - now);
+		threat.leave -= now;
+		found.push_back(threat);
+	}
+}
+
+/******************************************
+ * ANCHOR
+ * Put the rock on a new line from where it really is now, and check it
+ * against every watcher again
+ ******************************************/
+void ThreatTracker::anchor(int slot)
+{
+	Tracked & rockTracked = tracked[slot];
+	Rocks * rock = rockTracked.rock;
+	Point point = rock->getCurrentPoint();
+	Velocity speed = rock->getVelocity();
+	Line line = { point.getX(), point.getY(), speed.getDx(), speed.getDy(), now, now,
+	              (float)rock->getRadius() };
+	setUntil(line);
+
+	rockTracked.line = line;
+	rockTracked.pending = false;
+	rockTracked.event = line.until;
+	pushEvent(slot);
+	for (int i = 0; i < (int)watchers.size(); i++)
+	{
+		forget(watchers[i], rock);
+		if (!watchers[i].path.empty())
+			check(watchers[i], slot);
+	}
+}
+
+/******************************************
+ * SET UNTIL
+ * The first tick the line is off the world by more than its radius,
+ * which is when it comes out on the other side.
+ ******************************************/
+void ThreatTracker::setUntil(Line & line) const
+{
+	// in floats, a rock going almost straight up would overflow an int
+	auto ticksOut = [](float at, float speed, float edge) -> float
+	{
+		if (speed > 0)
+			return std::floor((edge - at) / speed) + 1;
+		if (speed < 0)
+			return std::floor((edge + at) / -speed) + 1;
+		return (float)THREAT_NEVER;
+	};
+	float ticks = std::min(ticksOut(line.x, line.dx, halfWidth + line.radius),
+	                       ticksOut(line.y, line.dy, halfHeight + line.radius));
+	line.until = line.since + (int)std::max(1.0f, std::min(ticks, (float)THREAT_NEVER));
+}
+
+/******************************************
+ * NEXT LINE
+ * Where a rock's line comes out after it wraps, the same way
+ * Rocks::getCurrentPoint() does it: only across the edge it went off.
+ ******************************************/
+void ThreatTracker::nextLine(Line & line) const
+{
+	float ticks = (float)(line.until - line.since);
+	float x = line.x + line.dx * ticks;
+	float y = line.y + line.dy * ticks;
+	float edgeX = halfWidth + line.radius;
+	float edgeY = halfHeight + line.radius;
+	if (std::abs(x) > edgeX)
+		x -= std::copysign(2 * edgeX, x);
+	if (std::abs(y) > edgeY)
+		y -= std::copysign(2 * edgeY, y);
+	line.x = x;
+	line.y = y;
+	line.since = line.until;
+	setUntil(line);
+}
+
+/******************************************
+ * FLIP LINE
+ * Where a watcher's line comes out after it wraps, the same way
+ * flipSide() does it.
+ ******************************************/
+void ThreatTracker::flipLine(Line & line) const
+{
+	float ticks = (float)(line.until - line.since);
+	float x = line.x + line.dx * ticks;
+	float y = line.y + line.dy * ticks;
+	if (std::abs(x) >= halfWidth)
+		x = -x;
+	if (std::abs(y) >= halfHeight)
+		y = -y;
+	line.x = x;
+	line.y = y;
+	line.since = line.until;
+	setUntil(line);
+}
+
+/******************************************
+ * LAY PATH
+ * The lines something on point going velocity is on from now until
+ * horizon
+ ******************************************/
+void ThreatTracker::layPath(std::vector<Line> & path, const Point & point, const Velocity & velocity,
+                            int radius, int horizon) const
+{
+	path.clear();
+	Line line = { point.getX(), point.getY(), velocity.getDx(), velocity.getDy(), now, 0, (float)radius };
+	setUntil(line);
+	path.push_back(line);
+	while (line.until < horizon)
+	{
+		flipLine(line);
+		path.push_back(line);
+	}
+}
+
+/******************************************
+ * SAME WRAPS
+ * Both paths wrap on the same ticks and come out on the same sides, so
+ * they are only as far apart as they would be without wrapping
+ ******************************************/
+bool ThreatTracker::sameWraps(const std::vector<Line> & path1, const std::vector<Line> & path2) const
+{
+	if (path1.size() != path2.size())
+		return false;
+	for (int i = 0; i < (int)path1.size(); i++)
+	{
+		if (i + 1 < (int)path1.size() && path1[i].until != path2[i].until)
+			return false;
+		if (i > 0 && ((path1[i].x < 0) != (path2[i].x < 0) || (path1[i].y < 0) != (path2[i].y < 0)))
+			return false;
+	}
+	return true;
+}
+
+/******************************************
+ * CHECK
+ * Walk the rock's path and the watcher's path together, a piece where
+ * neither wraps at a time, and find the first time the rock is within
+ * reach. Within a piece that is where a quadratic is below zero.
+ ******************************************/
+void ThreatTracker::check(Watcher & watcher, int slot)
+{
+	Line rock = tracked[slot].line;
+	int from = now;
+	while (rock.until <= from)
+		nextLine(rock);
+	int at = 0;
+	while (at < (int)watcher.path.size() - 1 && watcher.path[at].until <= from)
+		at++;
+
+	float reach = watcher.reach + rock.radius + THREAT_SLACK;
+	float nearest = INFINITY;
+	while (from < watcher.horizon && at < (int)watcher.path.size())
+	{
+		const Line & me = watcher.path[at];
+		int to = std::min(std::min(rock.until, me.until), watcher.horizon);
+
+		// where the rock is from the watcher at from, and how that changes
+		float px = rock.x + rock.dx * (from - rock.since) - (me.x + me.dx * (from - me.since));
+		float py = rock.y + rock.dy * (from - rock.since) - (me.y + me.dy * (from - me.since));
+		float vx = rock.dx - me.dx;
+		float vy = rock.dy - me.dy;
+		float a = vx * vx + vy * vy;
+		float b = px * vx + py * vy;
+		float c = px * px + py * py - reach * reach;
+		float span = (float)(to - from);
+
+		bool hit = false;
+		float enter = 0;
+		float leave = span;
+		float closest = 0;
+		if (a < 1e-9f)
+			hit = (c <= 0);
+		else
+		{
+			float discriminant = b * b - a * c;
+			if (discriminant >= 0)
+			{
+				float root = std::sqrt(discriminant);
+				enter = (-b - root) / a;
+				leave = (-b + root) / a;
+				hit = (leave >= 0 && enter <= span);
+				enter = std::max(enter, 0.0f);
+				leave = std::min(leave, span);
+				closest = std::max(enter, std::min(leave, -b / a));
+			}
+		}
+
+		if (hit)
+		{
+			float cx = px + vx * closest;
+			float cy = py + vy * closest;
+			Threat threat = { tracked[slot].rock, from + enter, from + closest, from + leave,
+			                  std::sqrt(cx * cx + cy * cy) };
+			auto place = std::upper_bound(watcher.threats.begin(), watcher.threats.end(), threat,
+			                              [](const Threat & a, const Threat & b) { return a.enter < b.enter; });
+			watcher.threats.insert(place, threat);
+			keep(watcher, slot, threat.distance - reach);
+			return;
+		}
+
+		// how close it gets in this piece
+		float when = (a < 1e-9f) ? 0.0f : std::max(0.0f, std::min(span, -b / a));
+		float nearX = px + vx * when;
+		float nearY = py + vy * when;
+		nearest = std::min(nearest, std::sqrt(nearX * nearX + nearY * nearY));
+
+		from = to;
+		if (rock.until <= from)
+			nextLine(rock);
+		if (me.until <= from)
+			at++;
+	}
+	keep(watcher, slot, nearest - reach);
+}
+
+/******************************************
+ * KEEP
+ * Remember how far outside reach the rock stays. It only has to be
+ * checked again once the watcher's path has drifted that far.
+ ******************************************/
+void ThreatTracker::keep(Watcher & watcher, int slot, float clearance)
+{
+	if ((int)watcher.keys.size() <= slot)
+		watcher.keys.resize(tracked.size(), NAN);
+	float key = clearance + watcher.drift;
+	watcher.keys[slot] = key;
+	if (std::isinf(key))
+		return;
+	watcher.margins.push_back({ key, slot });
+	std::push_heap(watcher.margins.begin(), watcher.margins.end(),
+	               [](const Margin & a, const Margin & b) { return a.key > b.key; });
+}
+
+void ThreatTracker::forget(Watcher & watcher, const Rocks * rock)
+{
+	for (int i = 0; i < (int)watcher.threats.size(); i++)
+	{
+		if (watcher.threats[i].rock == rock)
+		{
+			watcher.threats.erase(watcher.threats.begin() + i);
+			return;
+		}
+	}
+}
+
+void ThreatTracker::pushEvent(int slot)
+{
+	events.push_back({ tracked[slot].event, slot });
+	std::push_heap(events.begin(), events.end(),
+	               [](const Event & a, const Event & b) { return a.when > b.when; });
+}
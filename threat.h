@@ -0,0 +1,170 @@
+/***********************************************************************
+ * Header File:
+ *    Threat : which rocks are going to come close to something, and when
+ * Summary:
+ *    A rock goes in a straight line at the same speed until it wraps,
+ *    and where it comes out after wrapping is known too, so where it
+ *    will be any number of ticks from now can be worked out without
+ *    moving it there. The tracker keeps the line each rock is on and,
+ *    for each watcher (the ship, or anything else that wants one), a
+ *    list of the rocks that will come within reach of it, soonest first.
+ *
+ *    Nothing is worked out again every tick. A rock that is made, split
+ *    or changes speed is checked against the watchers once. Checking a
+ *    rock also keeps how far outside reach it stays (its clearance).
+ *    When a watcher is going to stray off its path by more than
+ *    THREAT_SLACK (it sped up or slowed down), the path is laid again,
+ *    and the most the new one is ever off the old one is added to the
+ *    watcher's drift. Only the rocks inside the corridor that sweeps,
+ *    the ones whose clearance is now under the drift, are checked
+ *    again. The whole list is only worked out again when it is about to
+ *    run out of ticks it can see, or when the new path wraps at other
+ *    times than the old one.
+ ************************************************************************/
+#ifndef THREAT_H
+#define THREAT_H
+
+#include "point.h"
+#include "velocity.h"
+#include "rocks.h"
+
+#include <vector>
+#include <unordered_map>
+
+//How close (center to center, plus the rock's size) counts as a threat
+constexpr float THREAT_DISTANCE = 60.0;
+
+//How many ticks ahead to look (at 30 frames a second)
+constexpr int THREAT_TICKS = 90;
+
+//How far a watcher can stray from its line before its list is worked out again
+constexpr float THREAT_SLACK = 8.0;
+
+//How many threats are pointed out around the ship
+constexpr int THREAT_SHOWN = 5;
+
+//A rock that is going to come within reach. The times are ticks from now.
+struct Threat
+{
+	Rocks * rock;
+	float enter;     // when it comes within reach (0 if it already is)
+	float closest;   // when it is closest
+	float leave;     // when it is out of reach again
+	float distance;  // how close it gets, center to center
+};
+
+class ThreatTracker
+{
+public:
+	ThreatTracker();
+
+	//The corners of the world things wrap at. It is centered on (0, 0).
+	//This forgets every rock, they have to be added again.
+	void setWorld(const Point & topLeft, const Point & bottomRight);
+
+	//Start a new watcher that wants the rocks within reach of it over the
+	//next ticks. Returns what to call it by.
+	int watch(float reach, int ticks);
+
+	//Tell a watcher where it is now, once a tick after tick()
+	void follow(int watcher, const Point & point, const Velocity & velocity, int radius);
+
+	//A rock was made, changed speed, or is gone (before it is deleted).
+	//Where a rock is is only read on the next tick().
+	void add(Rocks * rock);
+	void update(Rocks * rock);
+	void remove(Rocks * rock);
+
+	//Forget every rock (the watchers stay)
+	void clear();
+
+	//The end of a tick, everything has moved
+	void tick();
+
+	//The watcher's threats that come within reach in the next ticks, soonest first
+	void getThreats(int watcher, int ticks, std::vector<Threat> & found) const;
+
+	int size() const { return (int)slots.size(); }
+	int getRescans() const { return rescans; }
+	int getRechecks() const { return rechecks; }
+
+private:
+	//A straight piece of a path, from tick since until the tick it wraps
+	struct Line
+	{
+		float x;
+		float y;
+		float dx;
+		float dy;
+		int since;
+		int until;
+		float radius;
+	};
+
+	struct Tracked
+	{
+		Rocks * rock;        // NULL when the slot is free
+		Line line;
+		int event;           // when to look at the rock again (when it wraps)
+		bool pending;        // has to be read on the next tick
+	};
+
+	//Events whose time is not the slot's event any more are thrown away
+	//when they come up
+	struct Event
+	{
+		int when;
+		int slot;
+	};
+
+	//A rock's clearance from a watcher's path, plus the watcher's drift
+	//when it was worked out. The ones no longer in the watcher's keys are
+	//thrown away when they come up.
+	struct Margin
+	{
+		float key;
+		int slot;
+	};
+
+	struct Watcher
+	{
+		float reach;
+		int ticks;
+		int horizon;                 // the last tick the list looks out to
+		std::vector<Line> path;      // where it will be from now to horizon
+		std::vector<Threat> threats; // sorted by when they come within reach, times are ticks
+		float drift;                 // how far the path has moved since the last rescan
+		std::vector<float> keys;     // each slot's margin key (NaN if it has none)
+		std::vector<Margin> margins; // a heap, smallest key first
+	};
+
+	void anchor(int slot);
+	void setUntil(Line & line) const;
+	void nextLine(Line & line) const;
+	void flipLine(Line & line) const;
+	void layPath(std::vector<Line> & path, const Point & point, const Velocity & velocity,
+	             int radius, int horizon) const;
+	bool sameWraps(const std::vector<Line> & path1, const std::vector<Line> & path2) const;
+	void rescan(Watcher & watcher, const Point & point, const Velocity & velocity, int radius);
+	void check(Watcher & watcher, int slot);
+	void keep(Watcher & watcher, int slot, float clearance);
+	void forget(Watcher & watcher, const Rocks * rock);
+	void pushEvent(int slot);
+
+	float halfWidth;
+	float halfHeight;
+	int now;
+	int rescans;
+	int rechecks;
+
+	std::vector<Tracked> tracked;
+	std::vector<int> unused;                         // free slots in tracked
+	std::unordered_map<const Rocks *, int> slots;    // where each rock is in tracked
+	std::vector<int> waiting;                        // slots to read on the next tick
+	std::vector<Event> events;                       // a heap, soonest first
+	std::vector<Watcher> watchers;
+	std::vector<Line> nextPath;                      // kept so it is not allocated every time
+	std::vector<int> rechecking;
+};
+
+#endif // THREAT_H
@@ -0,0 +1,60 @@
+/*********************************************************************
+ * File: trig.cpp
+ * Description: Fills in the sine table when the game is compiled, and
+ *  keeps the circle rings.
+ *********************************************************************/
+#include "trig.h"
+
+#include <vector>
+
+/******************************************
+ * TAYLOR SINE
+ * The sine of an angle in radians between -pi and pi, in a way the
+ * compiler can work out. Thirty terms is far more than a float needs.
+ ******************************************/
+constexpr double taylorSine(double radians)
+{
+	double term = radians;
+	double sum = radians;
+	for (int n = 1; n < 30; n++)
+	{
+		term *= -radians * radians / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+constexpr TrigTable makeTrigTable()
+{
+	const double pi = 3.14159265358979323846;
+	TrigTable table = {};
+	for (int i = 0; i <= TRIG_STEPS; i++)
+	{
+		// keep the angle between -pi and pi so the series stays accurate
+		int step = i % TRIG_STEPS;
+		if (step > TRIG_STEPS / 2)
+			step -= TRIG_STEPS;
+		table.sines[i] = (float)taylorSine(2.0 * pi * step / TRIG_STEPS);
+	}
+	return table;
+}
+
+extern constexpr TrigTable TRIG_TABLE = makeTrigTable();
+
+const float * trigRing(int segments)
+{
+	static thread_local std::vector<std::vector<float> > rings;
+	if (segments >= (int)rings.size())
+		rings.resize(segments + 1);
+	std::vector<float> & ring = rings[segments];
+	if (ring.empty())
+	{
+		ring.resize(2 * segments);
+		for (int i = 0; i < segments; i++)
+		{
+			ring[2 * i] = cosDeg(360.0f * i / segments);
+			ring[2 * i + 1] = sinDeg(360.0f * i / segments);
+		}
+	}
+	return ring.data();
+}
@@ -0,0 +1,64 @@
+/***********************************************************************
+ * Header File:
+ *    Trig : sine and cosine of angles in degrees, read from a table
+ * Summary:
+ *    Everything in the game turns in degrees, and every shot, rock and
+ *    corner that was drawn used to work out cos(M_PI / 180.0 * angle)
+ *    itself. The table holds the sine of TRIG_STEPS angles around a
+ *    circle and is filled in by the compiler, so nothing is worked out
+ *    when the game starts. An angle between two steps is read off the
+ *    line between them, which is within TRIG_ERROR of the real value
+ *    (--bench-trig checks it against the library).
+ *
+ *    trigRing() hands back the corners of a circle one across, cut into
+ *    so many pieces, for drawing circles and polygons.
+ ************************************************************************/
+#ifndef TRIG_H
+#define TRIG_H
+
+#include <cmath>
+
+//How many steps the table cuts a circle into (has to be a power of two)
+constexpr int TRIG_STEPS = 4096;
+
+//How far from the library's answer sinDeg() and cosDeg() can be
+constexpr float TRIG_ERROR = 1e-6f;
+
+//The sine of each step, and one more so the last step has an end
+struct TrigTable
+{
+	float sines[TRIG_STEPS + 1];
+};
+extern const TrigTable TRIG_TABLE;
+
+/******************************************
+ * SIN DEG / COS DEG
+ * The sine and cosine of an angle in degrees, any size or sign
+ ******************************************/
+inline float trigRead(double steps)
+{
+	// in doubles, a float loses too much of the part between steps
+	double whole = std::floor(steps);
+	int at = (int)whole & (TRIG_STEPS - 1);
+	float low = TRIG_TABLE.sines[at];
+	return low + (TRIG_TABLE.sines[at + 1] - low) * (float)(steps - whole);
+}
+inline float sinDeg(float degrees)
+{
+	return trigRead(degrees * (TRIG_STEPS / 360.0));
+}
+inline float cosDeg(float degrees)
+{
+	return trigRead(degrees * (TRIG_STEPS / 360.0) + TRIG_STEPS / 4);
+}
+
+/******************************************
+ * TRIG RING
+ * x, y for each of segments corners of a circle with a radius of one,
+ * starting at (1, 0) and going counter clockwise. Each ring is made the
+ * first time a thread asks for it and kept for that thread, so the
+ * pointer is only good on the thread that asked.
+ ******************************************/
+const float * trigRing(int segments);
+
+#endif // TRIG_H
@@ -0,0 +1,59 @@
+/***********************************************************************
+ * Header File:
+ *    Triple Buffer : hands the newest of something from one thread to
+ *    another without either waiting
+ * Summary:
+ *    There are three of them. The writer always has one to fill and the
+ *    reader always has one to read, and the third is the newest one
+ *    done. Publishing swaps the writer's for the third, and taking the
+ *    latest swaps the reader's for it if it is new. Neither side ever
+ *    waits on a lock, the writer never waits for the reader to finish,
+ *    and the reader skips straight to the newest if it fell behind.
+ *
+ *    Only one thread can write and one read.
+ ************************************************************************/
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+template <class T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : writing(0), reading(1), middle(2) {}
+
+	//The one the writer fills. Only the writer can touch it.
+	T & back() { return slots[writing]; }
+
+	//The back one is done, it is the newest now
+	void publish()
+	{
+		writing = middle.exchange(writing | TRIPLE_FRESH) & TRIPLE_INDEX;
+	}
+
+	//Move to the newest one if there is a new one, returns whether there was
+	bool update()
+	{
+		if (!(middle.load() & TRIPLE_FRESH))
+			return false;
+		reading = middle.exchange(reading) & TRIPLE_INDEX;
+		return true;
+	}
+
+	//The one the reader has. Only the reader can touch it.
+	const T & front() const { return slots[reading]; }
+
+private:
+	//middle is which one is in the middle, with this bit set when the
+	//writer put it there and the reader has not taken it yet
+	static constexpr int TRIPLE_FRESH = 4;
+	static constexpr int TRIPLE_INDEX = 3;
+
+	T slots[3];
+	int writing;
+	int reading;
+	std::atomic<int> middle;
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -11,9 +11,11 @@
  ************************************************************************/
 
 #include <string>     // need you ask?
-#include <sstream>    // convert an integer into text
 #include <cassert>    // I feel the need... the need for asserts
 #include <time.h>     // for clock
+#include <map>        // the text that has been drawn before
+#include <vector>     // the numbers that have been drawn before
+#include <algorithm>  // for std::min and std::max
 
 
 #ifdef __APPLE__
@@ -22,6 +24,7 @@
 #endif // __APPLE__
 
 #ifdef __linux__
+#define GL_GLEXT_PROTOTYPES // for the buffers of OpenGL 1.5
 #include <GL/gl.h>        // Main OpenGL library
 #include <GL/glut.h>      // Second OpenGL library
 #endif // __linux__
@@ -37,9 +40,75 @@
 #include "point.h"
 #include "uiDraw.h"
 #include "uiInteract.h"
+#include "drawBuffer.h"
+#include "trig.h"
+#include "raster.h"
+#include "drawFrame.h"
+#include "parallel.h"
 
 
-#define deg2rad(value) ((M_PI / 180) * (value))
+// where draws go instead of the screen between beginBatch() and endBatch(),
+// each thread has its own for drawParallel()
+static thread_local DrawBuffer * batch = NULL;
+
+// the thread is filling a buffer for drawParallel() and cannot touch OpenGL
+static thread_local bool helping = false;
+
+// where everything goes between beginSoftware() and endSoftware(), or
+// between beginFrame() and endFrame(), and what is drawn outside of a
+// batch until it is sent there
+static Raster * software = NULL;
+static DrawFrame * framing = NULL;
+static DrawBuffer unbatched;
+
+// the color set last, which text is drawn in
+static thread_local float currentColor[3] = { 1.0, 1.0, 1.0 };
+
+// the rock outlines on the graphics card, between beginOutlines() and
+// endOutlines()
+static const signed char * outlines = NULL;
+static int outlinesCount = 0;
+
+/************************************************************************
+ * RECORDING
+ * Where a draw should go instead of OpenGL, or NULL to draw it now
+ *************************************************************************/
+static DrawBuffer * recording()
+{
+   if (batch)
+      return batch;
+   return (software || framing) ? &unbatched : NULL;
+}
+
+/************************************************************************
+ * SET COLOR
+ * The color text and the draws that use the current color come out in.
+ * It is only sent to OpenGL when drawing straight to the window.
+ *************************************************************************/
+static void setColor(float red, float green, float blue)
+{
+   currentColor[0] = red;
+   currentColor[1] = green;
+   currentColor[2] = blue;
+   if (!software && !framing && !helping)
+      glColor3f(red, green, blue);
+}
+
+/************************************************************************
+ * CLOSE LOOP
+ * vertices has room for a line from each corner to the next, with the
+ * first end of each already filled in. Fill in the other ends so the
+ * last corner goes back to the first.
+ *************************************************************************/
+static void closeLoop(float * vertices, int corners)
+{
+   for (int i = 0; i < corners; i++)
+   {
+      int next = (i + 1) % corners;
+      vertices[4 * i + 2] = vertices[4 * next];
+      vertices[4 * i + 3] = vertices[4 * next + 1];
+   }
+}
 
 /*********************************************
  * NUMBER OUTLINES
@@ -102,45 +171,140 @@ void drawDigit(const Point & topLeft, char digit)
    }
 }
 
+/*************************************************************************
+ * NUMBER LINES
+ * The lines of a number laid out from (0, 0), x, y for each end. They
+ * are only laid out the first time the number is drawn. Only so many
+ * are kept so a number that keeps changing cannot fill memory.
+ *************************************************************************/
+static const std::vector<float> & numberLines(int number)
+{
+   static std::map<int, std::vector<float> > laidOut;
+   auto found = laidOut.find(number);
+   if (found != laidOut.end())
+      return found->second;
+   if (laidOut.size() >= 1024)
+      laidOut.clear();
+
+   std::vector<float> & lines = laidOut[number];
+   float x = 0;
+
+   // handle the negative
+   if (number < 0)
+   {
+      lines.insert(lines.end(), { x + 1, -5, x + 5, -5 });
+      x += 11;
+   }
+
+   // the digits, most significant first
+   char digits[12];
+   int count = 0;
+   long left = std::abs((long)number);
+   do
+   {
+      digits[count++] = (char)(left % 10);
+      left /= 10;
+   } while (left > 0);
+
+   while (count > 0)
+   {
+      const char * outline = NUMBER_OUTLINES[(int)digits[--count]];
+      for (int c = 0; c < 20 && outline[c] != -1; c += 4)
+         lines.insert(lines.end(), { x + outline[c],     (float)-outline[c + 1],
+                                     x + outline[c + 2], (float)-outline[c + 3] });
+      x += 11;
+   }
+   return lines;
+}
+
 /*************************************************************************
  * DRAW NUMBER
- * Display an integer on the screen using the 7-segment method
+ * Display an integer on the screen using the 7-segment method, all of
+ * its lines at once
  *   INPUT  topLeft   The top left corner of the character
  *          digit     The digit we are rendering: '0' .. '9'
  *************************************************************************/
 void drawNumber(const Point & topLeft, int number)
 {
-   // our cursor, if you will. It will advance as we output digits
-   Point point = topLeft;
-   
-   // is this negative
-   bool isNegative = (number < 0);
-   number *= (isNegative ? -1 : 1);
-   
-   // render the number as text
-   std::ostringstream sout;
-   sout << number;
-   string text = sout.str();
+   const std::vector<float> & lines = numberLines(number);
+   int count = (int)lines.size() / 2;
 
-   // handle the negative
-   if (isNegative)
+   if (DrawBuffer * buffer = recording())
    {
-      glBegin(GL_LINES);
-      glVertex2f(point.getX() + 1, point.getY() - 5);
-      glVertex2f(point.getX() + 5, point.getY() - 5);
-      glEnd();
-      point.addX(11);
+      float * vertices = buffer->add(DRAW_LINES, currentColor[0], currentColor[1],
+                                     currentColor[2], count);
+      for (int i = 0; i < count; i++)
+      {
+         vertices[2 * i] = topLeft.getX() + lines[2 * i];
+         vertices[2 * i + 1] = topLeft.getY() + lines[2 * i + 1];
+      }
+      return;
    }
-   
-   // walk through the text one digit at a time
-   for (const char *p = text.c_str(); *p; p++)
+
+   glPushMatrix();
+   glTranslatef(topLeft.getX(), topLeft.getY(), 0);
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glVertexPointer(2, GL_FLOAT, 0, lines.data());
+   glDrawArrays(GL_LINES, 0, count);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   glPopMatrix();
+}
+
+
+/*************************************************************************
+ * TEXT LIST
+ * The bitmaps of each string are put in a display list the first time
+ * it is drawn, so after that it is one call. Like the numbers, only so
+ * many are kept.
+ *************************************************************************/
+static GLuint textList(void * font, const std::string & text)
+{
+   static std::map<std::pair<void *, std::string>, GLuint> lists;
+   auto found = lists.find(std::make_pair(font, text));
+   if (found == lists.end())
    {
-      assert(isdigit(*p));
-      drawDigit(point, *p);
-      point.addX(11);
+      if (lists.size() >= 256)
+      {
+         for (auto & list : lists)
+            glDeleteLists(list.second, 1);
+         lists.clear();
+      }
+      GLuint list = glGenLists(1);
+      glNewList(list, GL_COMPILE);
+      for (int i = 0; i < (int)text.size(); i++)
+         glutBitmapCharacter(font, text[i]);
+      glEndList();
+      found = lists.insert(std::make_pair(std::make_pair(font, text), list)).first;
    }
+   return found->second;
 }
 
+static void flushUnbatched();
+
+/*************************************************************************
+ * DRAW STRING
+ * Draw text in a GLUT bitmap font starting at (x, y), in the color that
+ * is set
+ *************************************************************************/
+static void drawString(void * font, float x, float y, const std::string & text)
+{
+   // there are no fonts without a window
+   if (software)
+      return;
+
+   if (framing)
+   {
+      unsigned char color[3];
+      for (int i = 0; i < 3; i++)
+         color[i] = (unsigned char)(std::max(0.0f, std::min(1.0f, currentColor[i])) * 255.0f + 0.5f);
+      flushUnbatched();
+      framing->addText(font, x, y, color, text);
+      return;
+   }
+
+   glRasterPos2f(x, y);
+   glCallList(textList(font, text));
+}
 
 /*************************************************************************
  * DRAW TEXT
@@ -151,13 +315,7 @@ void drawNumber(const Point & topLeft, int number)
 void drawText(const Point & topLeft, const char * text)
 {
    void *pFont = GLUT_BITMAP_HELVETICA_12;  // also try _18
-
-   // prepare to draw the text from the top-left corner
-   glRasterPos2f(topLeft.getX(), topLeft.getY());
-
-   // loop through the text
-   for (const char *p = text; *p; p++)
-      glutBitmapCharacter(pFont, *p);
+   drawString(pFont, topLeft.getX(), topLeft.getY(), text);
 }
 
 /************************************************************************
@@ -172,19 +330,31 @@ void drawText(const Point & topLeft, const char * text)
  *************************************************************************/
 void drawPolygon(const Point & center, int radius, int points, int rotation)
 {
+   // the corners come from the ring, turned once for all of them
+   const float * ring = trigRing(points);
+   float cosA = cosDeg(rotation) * radius;
+   float sinA = sinDeg(rotation) * radius;
+
+   if (DrawBuffer * buffer = recording())
+   {
+      float * vertices = buffer->add(DRAW_LINES, 1.0, 1.0, 1.0, 2 * points);
+      for (int i = 0; i < points; i++)
+      {
+         vertices[4 * i] = center.getX() + ring[2 * i] * cosA - ring[2 * i + 1] * sinA;
+         vertices[4 * i + 1] = center.getY() + ring[2 * i] * sinA + ring[2 * i + 1] * cosA;
+      }
+      closeLoop(vertices, points);
+      return;
+   }
+
    // begin drawing
    glBegin(GL_LINE_LOOP);
 
    //loop around a circle the given number of times drawing a line from
    //one point to the next
-   for (double i = 0; i < 2 * M_PI; i += (2 * M_PI) / points)
-   {
-      Point temp(false /*check*/);
-      temp.setX(center.getX() + (radius * cos(i)));
-      temp.setY(center.getY() + (radius * sin(i)));
-      rotate(temp, center, rotation);
-      glVertex2f(temp.getX(), temp.getY());
-   }
+   for (int i = 0; i < points; i++)
+      glVertex2f(center.getX() + ring[2 * i] * cosA - ring[2 * i + 1] * sinA,
+                 center.getY() + ring[2 * i] * sinA + ring[2 * i + 1] * cosA);
 
    // complete drawing
    glEnd();
@@ -204,8 +374,8 @@ void drawPolygon(const Point & center, int radius, int points, int rotation)
 void rotate(Point & point, const Point & origin, int rotation)
 {
    // because sine and cosine are expensive, we want to call them only once
-   double cosA = cos(deg2rad(rotation));
-   double sinA = sin(deg2rad(rotation));
+   double cosA = cosDeg(rotation);
+   double sinA = sinDeg(rotation);
 
    // remember our original point
    Point tmp(false /*check*/);
@@ -230,25 +400,70 @@ void rotate(Point & point, const Point & origin, int rotation)
 void drawLine(const Point & begin, const Point & end,
               float red, float green, float blue)
 {
+   if (DrawBuffer * buffer = recording())
+   {
+      float * vertices = buffer->add(DRAW_LINES, red, green, blue, 2);
+      vertices[0] = begin.getX();
+      vertices[1] = begin.getY();
+      vertices[2] = end.getX();
+      vertices[3] = end.getY();
+      return;
+   }
+
    // Get ready...
    glBegin(GL_LINES);
-   glColor3f(red, green, blue);
+   setColor(red, green, blue);
 
    // Draw the actual line
    glVertex2f(begin.getX(), begin.getY());
    glVertex2f(  end.getX(),   end.getY());
 
    // Complete drawing
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
    glEnd();
 }
 
+/************************************************************************
+ * DRAW HISTOGRAM
+ * Draw a bar for each of the values, side by side to the right of
+ * bottomLeft, the biggest one height pixels high
+ *   INPUT  bottomLeft  The bottom left corner of the first bar
+ *          values      How tall each bar is, against the others
+ *          count       How many bars
+ *          height      How tall the biggest bar is
+ *************************************************************************/
+void drawHistogram(const Point & bottomLeft, const int * values, int count, int height)
+{
+   int biggest = 0;
+   for (int i = 0; i < count; i++)
+      biggest = std::max(biggest, values[i]);
+   if (biggest == 0)
+      return;
+
+   for (int i = 0; i < count; i++)
+   {
+      if (values[i] == 0)
+         continue;
+      // anything at all gets a pixel
+      float top = bottomLeft.getY() + std::max(1, height * values[i] / biggest);
+      for (int x = 0; x < 3; x++)
+      {
+         float across = bottomLeft.getX() + 4 * i + x;
+         drawLine(Point(across, bottomLeft.getY()), Point(across, top));
+      }
+   }
+}
+
 /***********************************************************************
  * DRAW Lander
  * Draw a moon-lander spaceship on the screen at a given point
  ***********************************************************************/
 void drawLander(const Point & point)
 {
+   // not drawn in software or kept in a frame
+   if (software || framing)
+      return;
+
    // ultra simple point
    struct PT
    {
@@ -288,6 +503,10 @@ void drawLanderFlames(const Point & point,
                       bool left,
                       bool right)
 {
+   // not drawn in software or kept in a frame
+   if (software || framing)
+      return;
+
    // simple point
    struct PT
    {
@@ -299,7 +518,7 @@ void drawLanderFlames(const Point & point,
    
    // draw it
    glBegin(GL_LINE_LOOP);
-   glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+   setColor(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
    
    // bottom thrust
    if (bottom)
@@ -352,7 +571,7 @@ void drawLanderFlames(const Point & point,
       glVertex2f(point.getX() - 6, point.getY() + 10);
    }
 
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
    glEnd();
 }
 
@@ -430,6 +649,18 @@ void drawRect(const Point & center, int width, int height, int rotation)
    rotate(br, center, rotation);
 
    //Finally draw the rectangle
+   if (DrawBuffer * buffer = recording())
+   {
+      const Point * corners[4] = { &tl, &tr, &br, &bl };
+      float * vertices = buffer->add(DRAW_LINES, 1.0, 1.0, 1.0, 8);
+      for (int i = 0; i < 4; i++)
+      {
+         vertices[4 * i] = corners[i]->getX();
+         vertices[4 * i + 1] = corners[i]->getY();
+      }
+      closeLoop(vertices, 4);
+      return;
+   }
    glBegin(GL_LINE_STRIP);
    glVertex2f(tl.getX(), tl.getY());
    glVertex2f(tr.getX(), tr.getY());
@@ -448,20 +679,53 @@ void drawRect(const Point & center, int width, int height, int rotation)
 void drawCircle(const Point & center, int radius)
 {
    assert(radius > 1.0);
-   const double increment = 1.0 / (double)radius;
+
+   // a corner about every pixel around
+   int corners = (int)ceil(M_PI * 2.0 * radius);
+   const float * ring = trigRing(corners);
+
+   // in a batch the loop is drawn as lines, each corner twice
+   if (DrawBuffer * buffer = recording())
+   {
+      float * vertices = buffer->add(DRAW_LINES, 1.0, 1.0, 1.0, 2 * corners);
+      for (int i = 0; i < corners; i++)
+      {
+         vertices[4 * i] = center.getX() + radius * ring[2 * i];
+         vertices[4 * i + 1] = center.getY() + radius * ring[2 * i + 1];
+      }
+      closeLoop(vertices, corners);
+      return;
+   }
 
    // begin drawing
    glBegin(GL_LINE_LOOP);
 
    // go around the circle
-   for (double radians = 0; radians < M_PI * 2.0; radians += increment)
-      glVertex2f(center.getX() + (radius * cos(radians)),
-                 center.getY() + (radius * sin(radians)));
+   for (int i = 0; i < corners; i++)
+      glVertex2f(center.getX() + radius * ring[2 * i],
+                 center.getY() + radius * ring[2 * i + 1]);
    
    // complete drawing
    glEnd();   
 }
 
+/************************************************************************
+ * ADD DOT
+ * Put the four points of a dot in the batch
+ *************************************************************************/
+static void addDot(DrawBuffer * buffer, const Point & point, float red, float green, float blue)
+{
+   float * vertices = buffer->add(DRAW_POINTS, red, green, blue, 4);
+   vertices[0] = point.getX();
+   vertices[1] = point.getY();
+   vertices[2] = point.getX() + 1;
+   vertices[3] = point.getY();
+   vertices[4] = point.getX() + 1;
+   vertices[5] = point.getY() + 1;
+   vertices[6] = point.getX();
+   vertices[7] = point.getY() + 1;
+}
+
 /************************************************************************
  * DRAW DOT
  * Draw a single point on the screen, 2 pixels by 2 pixels
@@ -469,7 +733,13 @@ void drawCircle(const Point & center, int radius)
  *************************************************************************/
 void drawDot(const Point & point)
 {
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 0.8 /* blue % */);
+   if (DrawBuffer * buffer = recording())
+   {
+      addDot(buffer, point, 1.0, 1.0, 0.8);
+      return;
+   }
+
+   setColor(1.0 /* red % */, 1.0 /* green % */, 0.8 /* blue % */);
    glBegin(GL_POINTS);
 
    // Go...
@@ -480,12 +750,18 @@ void drawDot(const Point & point)
 
    // Done!  OK, that was a bit too dramatic
    glEnd();
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
 }
 
 void drawRedDot(const Point & point)
 {
-	glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+	if (DrawBuffer * buffer = recording())
+	{
+		addDot(buffer, point, 1.0, 0.0, 0.0);
+		return;
+	}
+
+	setColor(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
 	// Get ready, get set...
 	glBegin(GL_POINTS);
 
@@ -497,8 +773,297 @@ void drawRedDot(const Point & point)
 
 	// Done!  OK, that was a bit too dramatic
 	glEnd();
-	glColor3f(1.0, 1.0, 1.0);
+	setColor(1.0, 1.0, 1.0);
 }
+/************************************************************************
+ * SUBMIT SOFTWARE
+ * Draw one bucket of a batch onto the raster
+ *************************************************************************/
+static void submitSoftware(int primitive, const unsigned char * color,
+                           const float * vertices, int count)
+{
+   if (primitive == DRAW_POINTS)
+      software->drawPoints(color, vertices, count);
+   else
+      software->drawLines(color, vertices, count);
+}
+
+/************************************************************************
+ * SUBMIT FRAME
+ * Keep one bucket of a batch in the frame being made
+ *************************************************************************/
+static void submitFrame(int primitive, const unsigned char * color,
+                        const float * vertices, int count)
+{
+   framing->addCall(primitive, color, vertices, count);
+}
+
+/************************************************************************
+ * FLUSH UNBATCHED
+ * Put what has been drawn outside of a batch onto the raster or in the
+ * frame
+ *************************************************************************/
+static void flushUnbatched()
+{
+   if (software)
+      unbatched.flush(submitSoftware);
+   else if (framing)
+      unbatched.flush(submitFrame);
+}
+
+/************************************************************************
+ * BEGIN SOFTWARE
+ * Draw everything after this onto raster instead of the window
+ *************************************************************************/
+void beginSoftware(Raster & raster)
+{
+   software = &raster;
+   software->setCamera(0, 0);
+}
+
+/************************************************************************
+ * END SOFTWARE
+ * Finish drawing onto the raster and go back to the window
+ *************************************************************************/
+void endSoftware()
+{
+   flushUnbatched();
+   software = NULL;
+}
+
+/************************************************************************
+ * BEGIN CAMERA
+ * Move everything drawn after this so center is in the middle of the
+ * screen. Has to be matched with END CAMERA.
+ *   INPUT  center   the point in the world to look at
+ *************************************************************************/
+void beginCamera(const Point & center)
+{
+   if (software)
+   {
+      flushUnbatched();
+      software->setCamera(center.getX(), center.getY());
+      return;
+   }
+   if (framing)
+   {
+      flushUnbatched();
+      framing->addCamera(center.getX(), center.getY());
+      return;
+   }
+   glPushMatrix();
+   glTranslatef(-center.getX(), -center.getY(), 0);
+}
+
+/************************************************************************
+ * END CAMERA
+ * Go back to drawing straight onto the screen
+ *************************************************************************/
+void endCamera()
+{
+   if (software)
+   {
+      flushUnbatched();
+      software->setCamera(0, 0);
+      return;
+   }
+   if (framing)
+   {
+      flushUnbatched();
+      framing->addEndCamera();
+      return;
+   }
+   glPopMatrix();
+}
+
+/************************************************************************
+ * BEGIN BATCH
+ * Put the dots, lines, circles and rocks drawn after this in buffer
+ *************************************************************************/
+void beginBatch(DrawBuffer & buffer)
+{
+   flushUnbatched();
+   batch = &buffer;
+}
+
+/************************************************************************
+ * END BATCH
+ * Go back to drawing straight onto the screen
+ *************************************************************************/
+void endBatch()
+{
+   batch = NULL;
+}
+
+/************************************************************************
+ * DRAW PARALLEL
+ * Cut 0 .. count into a piece for each thread, and have each thread
+ * draw its piece into a buffer of its own. Then the pieces are put in
+ * the batch one after the other, so it goes out just as if it had been
+ * drawn on one thread. The buffers are kept for their memory.
+ *************************************************************************/
+void drawParallel(int count, const std::function<void(int begin, int end)> & draw)
+{
+   assert(batch != NULL);
+   int threads = std::min(threadCount(), count / DRAW_PARALLEL_MIN);
+   if (threads <= 1)
+   {
+      draw(0, count);
+      return;
+   }
+
+   static std::vector<DrawBuffer> pieces;
+   if ((int)pieces.size() < threads)
+      pieces.resize(threads);
+   DrawBuffer * into = batch;
+   for (int piece = 0; piece < threads; piece++)
+      pieces[piece].setLayer(into->getLayer());
+
+   parallelFor(threads, 1, [&](int first, int last)
+   {
+      // this thread may be the one with the window, so put it back after
+      DrawBuffer * was = batch;
+      bool wasHelping = helping;
+      helping = true;
+      for (int piece = first; piece < last; piece++)
+      {
+         batch = &pieces[piece];
+         draw((int)((long long)count * piece / threads), (int)((long long)count * (piece + 1) / threads));
+      }
+      batch = was;
+      helping = wasHelping;
+   });
+
+   for (int piece = 0; piece < threads; piece++)
+      into->append(pieces[piece]);
+}
+
+/************************************************************************
+ * SUBMIT BATCH
+ * Draw one bucket of a batch with a single call
+ *************************************************************************/
+static void submitBatch(int primitive, const unsigned char * color,
+                        const float * vertices, int count)
+{
+   glColor3ub(color[0], color[1], color[2]);
+   glVertexPointer(2, GL_FLOAT, 0, vertices);
+   glDrawArrays(primitive == DRAW_POINTS ? GL_POINTS : GL_LINES, 0, count);
+}
+
+/************************************************************************
+ * DRAW BATCH
+ * Draw everything in buffer, one call for each layer and color
+ *************************************************************************/
+void drawBatch(DrawBuffer & buffer)
+{
+   flushUnbatched();
+   if (software)
+      buffer.flush(submitSoftware);
+   else if (framing)
+      buffer.flush(submitFrame);
+   else
+   {
+      glEnableClientState(GL_VERTEX_ARRAY);
+      buffer.flush(submitBatch);
+      glDisableClientState(GL_VERTEX_ARRAY);
+   }
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+}
+
+/************************************************************************
+ * DRAW POINTS
+ * Draw a lot of single pixel points with one call
+ *  INPUT vertices  x, y pairs
+ *        colors    red, green, blue for each point (0 - 255)
+ *        count     how many points there are
+ *************************************************************************/
+void drawPoints(const float * vertices, const unsigned char * colors, int count)
+{
+   if (software)
+   {
+      flushUnbatched();
+      software->drawPoints(vertices, colors, count);
+      return;
+   }
+   if (framing)
+   {
+      flushUnbatched();
+      framing->addPoints(vertices, colors, count);
+      return;
+   }
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, 0, vertices);
+   glColorPointer(3, GL_UNSIGNED_BYTE, 0, colors);
+
+   glDrawArrays(GL_POINTS, 0, count);
+
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+}
+
+/************************************************************************
+ * BEGIN FRAME
+ * Keep everything drawn after this in frame instead of drawing it. The
+ * frame is emptied first.
+ *************************************************************************/
+void beginFrame(DrawFrame & frame)
+{
+   framing = &frame;
+   framing->clear();
+   setColor(1.0, 1.0, 1.0);
+}
+
+/************************************************************************
+ * END FRAME
+ * Finish the frame and go back to drawing to the window
+ *************************************************************************/
+void endFrame()
+{
+   flushUnbatched();
+   framing = NULL;
+}
+
+/************************************************************************
+ * DRAW FRAME
+ * Draw everything kept in frame, in the order it was drawn. This is the
+ * only part that needs OpenGL.
+ *************************************************************************/
+void drawFrame(const DrawFrame & frame)
+{
+   assert(!software && !framing);
+   const std::vector<DrawFrame::Step> & steps = frame.getSteps();
+   for (int i = 0; i < (int)steps.size(); i++)
+   {
+      const DrawFrame::Step & step = steps[i];
+      switch (step.kind)
+      {
+      case FRAME_CALL:
+         glEnableClientState(GL_VERTEX_ARRAY);
+         submitBatch(step.primitive, step.color, frame.getVertices(step), step.count);
+         glDisableClientState(GL_VERTEX_ARRAY);
+         break;
+      case FRAME_POINTS:
+         drawPoints(frame.getVertices(step), frame.getColors(step), step.count);
+         break;
+      case FRAME_TEXT:
+         glColor3ub(step.color[0], step.color[1], step.color[2]);
+         glRasterPos2f(step.x, step.y);
+         glCallList(textList(step.font, frame.getText(step)));
+         break;
+      case FRAME_CAMERA:
+         beginCamera(Point(step.x, step.y));
+         break;
+      case FRAME_END_CAMERA:
+         endCamera();
+         break;
+      }
+   }
+   setColor(1.0, 1.0, 1.0);
+}
+
 /************************************************************************
  * DRAW Tough Bird
  * Draw a tough bird on the screen
@@ -509,30 +1074,31 @@ void drawRedDot(const Point & point)
 void drawToughBird(const Point & center, float radius, int hits)
 {
    assert(radius > 1.0);
-   const double increment = M_PI / 6.0;
+   const float * ring = trigRing(12);
+
+   // only points and lines can be recorded, so just its outline
+   if (DrawBuffer * buffer = recording())
+   {
+      float * vertices = buffer->add(DRAW_LINES, 1.0, 1.0, 1.0, 24);
+      for (int i = 0; i < 12; i++)
+      {
+         vertices[4 * i] = center.getX() + radius * ring[2 * i];
+         vertices[4 * i + 1] = center.getY() + radius * ring[2 * i + 1];
+      }
+      closeLoop(vertices, 12);
+      return;
+   }
    
    // begin drawing
    glBegin(GL_TRIANGLES);   
 
-   // three points: center, pt1, pt2
-   Point pt1(false /*check*/);
-   pt1.setX(center.getX() + (radius * cos(0.0)));
-   pt1.setY(center.getY() + (radius * sin(0.0)));   
-   Point pt2(pt1);
-
-   // go around the circle
-   for (double radians = increment;
-        radians <= M_PI * 2.0 + .5;
-        radians += increment)
+   // go around the circle, a triangle from the center to each side
+   for (int i = 0; i < 12; i++)
    {
-      pt2.setX(center.getX() + (radius * cos(radians)));
-      pt2.setY(center.getY() + (radius * sin(radians)));
-
+      int next = (i + 1) % 12;
       glVertex2f(center.getX(), center.getY());
-      glVertex2f(pt1.getX(),    pt1.getY()   );
-      glVertex2f(pt2.getX(),    pt2.getY()   );
-      
-      pt1 = pt2;
+      glVertex2f(center.getX() + radius * ring[2 * i],    center.getY() + radius * ring[2 * i + 1]);
+      glVertex2f(center.getX() + radius * ring[2 * next], center.getY() + radius * ring[2 * next + 1]);
    }
       
    // complete drawing
@@ -541,13 +1107,161 @@ void drawToughBird(const Point & center, float radius, int hits)
    // draw the score in the center
    if (hits > 0 && hits < 10)
    {
-      glColor3f(0.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+      setColor(0.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
       glRasterPos2f(center.getX() - 4, center.getY() - 3);
       glutBitmapCharacter(GLUT_BITMAP_8_BY_13, (char)(hits + '0'));
-      glColor3f(1.0, 1.0, 1.0); // reset to white
+      setColor(1.0, 1.0, 1.0); // reset to white
    }
 }
 
+/************************************************************************
+ * SHAPES
+ * The outlines that never change. The ship and its flames are put in
+ * display lists the first time one is drawn, so drawing one is a move, a
+ * turn and a call instead of working out every corner here. The stars
+ * are only ever drawn in a batch, so they have no list.
+ *************************************************************************/
+enum Shape { SHAPE_SHIP, SHAPE_FLAME, SHAPE_STAR = SHAPE_FLAME + 3 };
+
+// ultra simple point
+struct PT
+{
+   int x;
+   int y;
+};
+
+// the ship and its three flames, pointed up
+const PT POINTS_SHIP[] =
+{ // top   r.wing   r.engine l.engine  l.wing    top
+   {0, 6}, {6, -6}, {2, -3}, {-2, -3}, {-6, -6}, {0, 6}
+};
+const PT POINTS_FLAME[3][5] =
+{
+   { {-2, -3}, {-2, -13}, { 0, -6}, { 2, -13}, {2, -3} },
+   { {-2, -3}, {-4,  -9}, {-1, -7}, { 1, -14}, {2, -3} },
+   { {-2, -3}, {-1, -14}, { 1, -7}, { 4,  -9}, {2, -3} }
+};
+
+/************************************************************************
+ * SHAPE LIST
+ * The display list for a shape, made the first time it is asked for
+ * (there has to be a window by then).
+ *************************************************************************/
+static GLuint shapeList(Shape shape)
+{
+   assert(shape < SHAPE_STAR);
+   static GLuint first = 0;
+   if (first == 0)
+   {
+      first = glGenLists(SHAPE_STAR);
+
+      glNewList(first + SHAPE_SHIP, GL_COMPILE);
+      glBegin(GL_LINE_STRIP);
+      for (int i = 0; i < (int)(sizeof(POINTS_SHIP) / sizeof(PT)); i++)
+         glVertex2f(POINTS_SHIP[i].x, POINTS_SHIP[i].y);
+      glEnd();
+      glEndList();
+
+      for (int flame = 0; flame < 3; flame++)
+      {
+         glNewList(first + SHAPE_FLAME + flame, GL_COMPILE);
+         glBegin(GL_LINE_STRIP);
+         for (int i = 0; i < 5; i++)
+            glVertex2f(POINTS_FLAME[flame][i].x, POINTS_FLAME[flame][i].y);
+         glEnd();
+         glEndList();
+      }
+   }
+   return first + shape;
+}
+
+/************************************************************************
+ * ADD SHAPE
+ * Put the lines of a shape in buffer, worked out here since there is no
+ * display list to call
+ *************************************************************************/
+static void addShape(DrawBuffer * buffer, Shape shape, const Point & center, float rotation,
+                     float scale, float red, float green, float blue)
+{
+   // the corners, and whether the last goes back to the first. A star
+   // is one pixel across, every other corner of a pentagon.
+   float corners[12];
+   int count;
+   bool loop = (shape == SHAPE_STAR);
+   if (shape == SHAPE_STAR)
+   {
+      const float * ring = trigRing(5);
+      count = 5;
+      for (int i = 0; i < 5; i++)
+      {
+         corners[2 * i] = ring[2 * (2 * i % 5)];
+         corners[2 * i + 1] = ring[2 * (2 * i % 5) + 1];
+      }
+   }
+   else
+   {
+      const PT * points = (shape == SHAPE_SHIP) ? POINTS_SHIP : POINTS_FLAME[shape - SHAPE_FLAME];
+      count = (shape == SHAPE_SHIP) ? sizeof(POINTS_SHIP) / sizeof(PT) : 5;
+      for (int i = 0; i < count; i++)
+      {
+         corners[2 * i] = points[i].x;
+         corners[2 * i + 1] = points[i].y;
+      }
+   }
+
+   float cosA = cosDeg(rotation) * scale;
+   float sinA = sinDeg(rotation) * scale;
+   int lines = loop ? count : count - 1;
+   float * vertices = buffer->add(DRAW_LINES, red, green, blue, 2 * lines);
+   for (int i = 0; i < lines; i++)
+   {
+      for (int end = 0; end < 2; end++)
+      {
+         int corner = (i + end) % count;
+         float x = corners[2 * corner];
+         float y = corners[2 * corner + 1];
+         vertices[4 * i + 2 * end] = center.getX() + x * cosA - y * sinA;
+         vertices[4 * i + 2 * end + 1] = center.getY() + x * sinA + y * cosA;
+      }
+   }
+}
+
+/************************************************************************
+ * DRAW SHAPE
+ * Draw a shape at center in the given color, turned by rotation degrees
+ * and scale times as big
+ *************************************************************************/
+static void drawShape(Shape shape, const Point & center, float rotation, float scale,
+                      float red, float green, float blue)
+{
+   if (shape == SHAPE_STAR && !recording())
+   {
+      // a star outside of a batch is a batch of one
+      static DrawBuffer single;
+      beginBatch(single);
+      addShape(&single, shape, center, rotation, scale, red, green, blue);
+      endBatch();
+      drawBatch(single);
+      return;
+   }
+
+   if (DrawBuffer * buffer = recording())
+   {
+      addShape(buffer, shape, center, rotation, scale, red, green, blue);
+      return;
+   }
+
+   setColor(red, green, blue);
+   GLuint list = shapeList(shape);
+   glPushMatrix();
+   glTranslatef(center.getX(), center.getY(), 0);
+   glRotatef(rotation, 0, 0, 1);
+   if (scale != 1.0)
+      glScalef(scale, scale, 1);
+   glCallList(list);
+   glPopMatrix();
+}
+
 /************************************************************************
  * DRAW Sacred Bird
  * Draw a sacred bird on the screen
@@ -556,160 +1270,129 @@ void drawToughBird(const Point & center, float radius, int hits)
  *************************************************************************/
 void drawSacredBird(const Point & center, float radius, float rotation)
 {
-   // begin drawing
-   glBegin(GL_LINE_LOOP);
-   glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
-
-   
-   //loop around a circle the given number of times drawing a line from
-   //one point to the next
-   for (int i = 0; i < 5; i++)
-   {
-      Point temp(false /*check*/);
-      float radian = (float)i * (M_PI * 2.0) * 0.4;
-      temp.setX(center.getX() + (radius * cos(radian)));
-      temp.setY(center.getY() + (radius * sin(radian)));
-      rotate(temp, center, rotation);
-      glVertex2f(temp.getX(), temp.getY());
-   }
-   
-   // complete drawing
-   glColor3f(1.0, 1.0, 1.0); // reset to white
-   glEnd();   
+   drawShape(SHAPE_STAR, center, rotation, radius, 1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+   setColor(1.0, 1.0, 1.0); // reset to white
 }
 
 //same as sacred bird just blue
 void drawBlueStar(const Point & center, float radius, float rotation)
 {
-	// begin drawing
-	glBegin(GL_LINE_LOOP);
-	glColor3f(0.0 /* red % */, 0.0 /* green % */, 1.0 /* blue % */);
-
-
-	//loop around a circle the given number of times drawing a line from
-	//one point to the next
-	for (int i = 0; i < 5; i++)
-	{
-		Point temp(false /*check*/);
-		float radian = (float)i * (M_PI * 2.0) * 0.4;
-		temp.setX(center.getX() + (radius * cos(radian)));
-		temp.setY(center.getY() + (radius * sin(radian)));
-		rotate(temp, center, rotation);
-		glVertex2f(temp.getX(), temp.getY());
-	}
-
-	// complete drawing
-	glColor3f(1.0, 1.0, 1.0); // reset to white
-	glEnd();
+	drawShape(SHAPE_STAR, center, rotation, radius, 0.0 /* red % */, 0.0 /* green % */, 1.0 /* blue % */);
+	setColor(1.0, 1.0, 1.0); // reset to white
 }
 
 //same as sacred bird just white
 void drawWhiteStar(const Point & center, float radius, float rotation)
 {
-	// begin drawing
-	glBegin(GL_LINE_LOOP);
-
-	//loop around a circle the given number of times drawing a line from
-	//one point to the next
-	for (int i = 0; i < 5; i++)
-	{
-		Point temp(false /*check*/);
-		float radian = (float)i * (M_PI * 2.0) * 0.4;
-		temp.setX(center.getX() + (radius * cos(radian)));
-		temp.setY(center.getY() + (radius * sin(radian)));
-		rotate(temp, center, rotation);
-		glVertex2f(temp.getX(), temp.getY());
-	}
-
-	// complete drawing
-	glEnd();
+	drawShape(SHAPE_STAR, center, rotation, radius, 1.0, 1.0, 1.0);
 }
 
 /**********************************************************************
- * DRAW SMALL ASTEROID
+ * DRAW ASTEROID
+ * Draw a rock from its outline: points corners, x and y for each, in
+ * steps of unit pixels, turned by rotation degrees.
  **********************************************************************/
-void drawSmallAsteroid( const Point & center, int rotation)
+void drawAsteroid(const Point & center, int rotation, const signed char * corners,
+                  int points, float unit)
 {
-   // ultra simple point
-   struct PT
+   // the card has the outline, so it only needs to be told where
+   if (outlines && !recording() &&
+       corners >= outlines && corners + 2 * points <= outlines + outlinesCount)
    {
-      int x;
-      int y;
-   } points[] = 
+      glPushMatrix();
+      glTranslatef(center.getX(), center.getY(), 0);
+      glRotatef(rotation, 0, 0, 1);
+      glScalef(unit, unit, 1);
+      glDrawArrays(GL_LINE_LOOP, (GLint)((corners - outlines) / 2), points);
+      glPopMatrix();
+      return;
+   }
+
+   // work the turn out once for every corner
+   float cosA = cosDeg(rotation) * unit;
+   float sinA = sinDeg(rotation) * unit;
+
+   // in a batch the loop is drawn as lines, each corner twice
+   if (DrawBuffer * buffer = recording())
    {
-      {-5, 9},  {4, 8},   {8, 4},   
-      {8, -5},  {-2, -8}, {-2, -3}, 
-      {-8, -4}, {-8, 4},  {-5, 10}
-   };
-   glColor3f(0.8 /* red % */, 0.2 /* green % */, 1.0 /* blue % */);
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
+      float * vertices = buffer->add(DRAW_LINES, 0.8, 0.2, 1.0, 2 * points);
+      for (int i = 0; i < points; i++)
+      {
+         float x = corners[2 * i];
+         float y = corners[2 * i + 1];
+         vertices[4 * i] = center.getX() + x * cosA - y * sinA;
+         vertices[4 * i + 1] = center.getY() + x * sinA + y * cosA;
+      }
+      closeLoop(vertices, points);
+      return;
+   }
+
+   setColor(0.8 /* red % */, 0.2 /* green % */, 1.0 /* blue % */);
+   glBegin(GL_LINE_LOOP);
+   for (int i = 0; i < points; i++)
    {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
+      float x = corners[2 * i];
+      float y = corners[2 * i + 1];
+      glVertex2f(center.getX() + x * cosA - y * sinA,
+                 center.getY() + x * sinA + y * cosA);
    }
    glEnd();
 }
 
 /**********************************************************************
- * DRAW MEDIUM ASTEROID
+ * BEGIN OUTLINES
+ * The card cannot take corners as bytes, so they are sent as shorts.
+ * Windows only has OpenGL 1.1 and no buffers on the card, so there the
+ * shorts are kept here and pointed to instead.
  **********************************************************************/
-void drawMediumAsteroid( const Point & center, int rotation)
+bool beginOutlines(const signed char * corners, int count, unsigned int version)
 {
-   // ultra simple point
-   struct PT
+   if (recording())
+      return false;
+
+   static std::vector<GLshort> shorts;
+   static bool loaded = false;
+   static unsigned int loadedVersion = 0;
+#ifndef _WIN32
+   static GLuint buffer = 0;
+   if (buffer == 0)
+      glGenBuffers(1, &buffer);
+   glBindBuffer(GL_ARRAY_BUFFER, buffer);
+#endif // !_WIN32
+   if (!loaded || version != loadedVersion)
    {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {2, 8},    {8, 15},    {12, 8}, 
-      {6, 2},    {12, -6},   {2, -15},
-      {-6, -15}, {-14, -10}, {-15, 0},
-      {-4, 15},  {2, 8}
-   };
-   glColor3f(0.8 /* red % */, 0.2 /* green % */, 1.0 /* blue % */);
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
+      shorts.assign(corners, corners + count);
+#ifndef _WIN32
+      glBufferData(GL_ARRAY_BUFFER, shorts.size() * sizeof(GLshort), shorts.data(), GL_STATIC_DRAW);
+#endif // !_WIN32
+      loaded = true;
+      loadedVersion = version;
    }
-   glEnd();
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+#ifdef _WIN32
+   glVertexPointer(2, GL_SHORT, 0, shorts.data());
+#else
+   glVertexPointer(2, GL_SHORT, 0, NULL);
+#endif // _WIN32
+   outlines = corners;
+   outlinesCount = count;
+   setColor(0.8 /* red % */, 0.2 /* green % */, 1.0 /* blue % */);
+   return true;
 }
 
 /**********************************************************************
- * DRAW LARGE ASTEROID
+ * END OUTLINES
+ * Go back to drawing rocks by their corners
  **********************************************************************/
-void drawLargeAsteroid( const Point & center, int rotation)
+void endOutlines()
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {0, 12},    {8, 20}, {16, 14},
-      {10, 12},   {20, 0}, {0, -20},
-      {-18, -10}, {-20, -2}, {-20, 14},
-      {-10, 20},  {0, 12}
-   };
-   glColor3f(0.8 /* red % */, 0.2 /* green % */, 1.0 /* blue % */);
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
+   glDisableClientState(GL_VERTEX_ARRAY);
+#ifndef _WIN32
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif // !_WIN32
+   outlines = NULL;
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
 }
 
 
@@ -721,53 +1404,14 @@ void drawLargeAsteroid( const Point & center, int rotation)
  *************************************************************************/
 void drawShip(const Point & center, int rotation, bool thrust)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   };
-   glColor3f(0.0 /* red % */, 0.9 /* green % */, 1.0 /* blue % */);
-   // draw the ship                                                 
-   const PT pointsShip[] = 
-   { // top   r.wing   r.engine l.engine  l.wing    top
-      {0, 6}, {6, -6}, {2, -3}, {-2, -3}, {-6, -6}, {0, 6}  
-   };
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(pointsShip)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + pointsShip[i].x, 
-               center.getY() + pointsShip[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
+   // draw the ship
+   drawShape(SHAPE_SHIP, center, rotation, 1.0, 0.0 /* red % */, 0.9 /* green % */, 1.0 /* blue % */);
 
    // draw the flame if necessary
    if (thrust)
-   {
-      const PT pointsFlame[3][5] =
-      {
-         { {-2, -3}, {-2, -13}, { 0, -6}, { 2, -13}, {2, -3} },
-         { {-2, -3}, {-4,  -9}, {-1, -7}, { 1, -14}, {2, -3} },
-         { {-2, -3}, {-1, -14}, { 1, -7}, { 4,  -9}, {2, -3} }
-      };
-      
-      glBegin(GL_LINE_STRIP);
-      glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
-      int iFlame = random(0, 3);
-      for (int i = 0; i < 5; i++)
-      {
-         Point pt(center.getX() + pointsFlame[iFlame][i].x, 
-                  center.getY() + pointsFlame[iFlame][i].y);
-         rotate(pt, center, rotation);
-         glVertex2f(pt.getX(), pt.getY());
-      }
-      glColor3f(1.0, 1.0, 1.0); // reset to white                                  
-      glEnd();
-   }
+      drawShape((Shape)(SHAPE_FLAME + random(0, 3)), center, rotation, 1.0,
+                1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+   setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
 }
 
 /*******************************************************************************************
@@ -776,35 +1420,22 @@ void drawShip(const Point & center, int rotation, bool thrust)
 *********************************************************************************************/
 void drawMenu(const Point & topLeft)
 {
-	glColor3f(0.2 /* red % */, 0.2 /* green % */, 1.0 /* blue % */); //Should be Blue
+	setColor(0.2 /* red % */, 0.2 /* green % */, 1.0 /* blue % */); //Should be Blue
 	void *pFont = GLUT_BITMAP_TIMES_ROMAN_24;
-	// prepare to draw the text from the top-left corner
-	glRasterPos2f(topLeft.getX() - 30, topLeft.getY());
-	char title[] = { "The Last Stand: Asteroids V" };
-	// loop through the text
-	for (const char *p = title; *p; p++)
-		glutBitmapCharacter(pFont, *p);
+	// draw the title from the top-left corner
+	drawString(pFont, topLeft.getX() - 30, topLeft.getY(), "The Last Stand: Asteroids V");
 
 	pFont = GLUT_BITMAP_HELVETICA_18;
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
-	// prepare to draw the text below title
-	glRasterPos2f(topLeft.getX() - 100, topLeft.getY() - 40);
-	char modes[] = { "P = Practice   S = Start New Game   H = How to play" };
-	// draw text
-	for (const char *p = modes; *p; p++)
-		glutBitmapCharacter(pFont, *p);
-
-	glRasterPos2f(topLeft.getX() - 75, topLeft.getY() - 62);
-	char additionalOptions[] = { "M = Main Menu   Q = Quit   X = Display FPS" };
-	for (const char *p = additionalOptions; *p; p++)
-		glutBitmapCharacter(pFont, *p);
-
-	glRasterPos2f(topLeft.getX() - 30, topLeft.getY() - 100);
-	char passwordOptions[] = { "Z = Enter Password   C = Continue" };
-	for (const char *p = passwordOptions; *p; p++)
-		glutBitmapCharacter(pFont, *p);
-
-	glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */); //Back to white
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
+	// draw the text below title
+	drawString(pFont, topLeft.getX() - 100, topLeft.getY() - 40,
+	           "P = Practice   S = Start New Game   H = How to play");
+	drawString(pFont, topLeft.getX() - 75, topLeft.getY() - 62,
+	           "M = Main Menu   Q = Quit   X = Display FPS");
+	drawString(pFont, topLeft.getX() - 30, topLeft.getY() - 100,
+	           "Z = Enter Password   C = Continue");
+
+	setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */); //Back to white
 }
 
 /**********************************************************************************
@@ -813,20 +1444,27 @@ void drawMenu(const Point & topLeft)
 ***********************************************************************************/
 void drawHowTo(const Point & topLeft)
 {
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_TIMES_ROMAN_24;
 
 	/* I know Magic number! Wanted to do this with a string but couldn't figure out how to get it
 	to work*/
-	char howToPlay[17][55] =
+	char howToPlay[24][55] =
 	{
 		"Use the space key to fire shots,",
 		"Use your Left and Right arrow key to rotate ship.",
 		"The W A S D keys also work for arrow keys",
 		"The Q and E key will increase speed while turning",
 		"The F key will release a shock wave(must be found)",
+		"Hold the V key to fire a beam through 3 rocks",
+		"The R key will fire homing missiles",
 		"The X key will display your frame rate",
 		"The P key will pause while in game.",
+		"The B key will make the rocks bounce off each other",
+		"The G key will turn on the black holes",
+		"The L key will make the world 8 screens across",
+		"The U key will send in flocks of enemy saucers",
+		"The T key will point out rocks about to hit you",
 		"Avoid hitting all the rocks!",
 		"Use the Up arrow key to increase velocity in the",
 		"direction the ship is facing",
@@ -840,14 +1478,9 @@ void drawHowTo(const Point & topLeft)
 	};
 	int yMove = 24;
 	// loop through the text
-	for (int loop = 0; loop < 17; loop++)
-	{
-		// prepare to draw the text from the top-left corner
-		glRasterPos2f(topLeft.getX(), topLeft.getY() - (loop * yMove));
-		for (int i = 0; howToPlay[loop][i]; i++)
-			glutBitmapCharacter(pFont, howToPlay[loop][i]);
-	}
-	glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */); //Back to white
+	for (int loop = 0; loop < 24; loop++)
+		drawString(pFont, topLeft.getX(), topLeft.getY() - (loop * yMove), howToPlay[loop]);
+	setColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */); //Back to white
 }
 
 /********************************************************************************
@@ -856,15 +1489,11 @@ void drawHowTo(const Point & topLeft)
 ********************************************************************************/
 void drawHighScore(const Point & topLeft, const int & highScore)
 {
-	glColor3f(1.0, 0.0, 0.0); //RED
-	glRasterPos2f(topLeft.getX(), topLeft.getY());
-
+	setColor(1.0, 0.0, 0.0); //RED
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char highScoreText[] = { "High Score:" };
-	for (int i = 0; highScoreText[i]; i++)
-		glutBitmapCharacter(pFont, highScoreText[i]);
+	drawString(pFont, topLeft.getX(), topLeft.getY(), "High Score:");
 	drawNumber(Point(topLeft.getX() + 20, topLeft.getY() - 10), highScore);
-	glColor3f(1.0, 1.0, 1.0); //White
+	setColor(1.0, 1.0, 1.0); //White
 }
 
 /******************************************************************************
@@ -873,7 +1502,7 @@ void drawHighScore(const Point & topLeft, const int & highScore)
 ******************************************************************************/
 void drawGameOver(const Point & topLeft, const int & highScore, const bool & scoreNew)
 {
-	glColor3f(1.0, 0.0, 0.0); //RED
+	setColor(1.0, 0.0, 0.0); //RED
 
 	void *pFont = GLUT_BITMAP_TIMES_ROMAN_24;
 
@@ -883,26 +1512,17 @@ void drawGameOver(const Point & topLeft, const int & highScore, const bool & sco
 	{ "Game Over!", "M = Return Main Menu" };
 	for (int loop = 0; loop < 2; loop++)
 	{
-		glRasterPos2f(topLeft.getX() - (loop * 55), topLeft.getY() - (loop * 64));
-		for (int i = 0; gameOver[loop][i]; i++)
-		{
-			glutBitmapCharacter(pFont, gameOver[loop][i]);
-			glColor3f(1.0, 0.6, 0.0);  //Yellow
-		}
+		drawString(pFont, topLeft.getX() - (loop * 55), topLeft.getY() - (loop * 64), gameOver[loop]);
+		setColor(1.0, 0.6, 0.0);  //Yellow
 	}
 
 	if (scoreNew)
 	{
-		glColor3f(1.0, 0.0, 0.0); //RED
-		glRasterPos2f(topLeft.getX() - 20, topLeft.getY() - 110);
-		char score[] = { "New High Score:" };
-		for (int i = 0; score[i]; i++)
-		{
-			glutBitmapCharacter(pFont, score[i]);
-		}
+		setColor(1.0, 0.0, 0.0); //RED
+		drawString(pFont, topLeft.getX() - 20, topLeft.getY() - 110, "New High Score:");
 		drawNumber(Point(topLeft.getX() + 45, topLeft.getY() - 125), highScore);
 	}
-	glColor3f(1.0, 1.0, 1.0);
+	setColor(1.0, 1.0, 1.0);
 }
 
 /*************************************************************************************
@@ -911,24 +1531,16 @@ void drawGameOver(const Point & topLeft, const int & highScore, const bool & sco
 *************************************************************************************/
 void drawScore(const Point & topLeft, const int & score)
 {
-	glRasterPos2f(topLeft.getX(), topLeft.getY());
-
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char scoreText[] = { "Score:" };
-	for (int i = 0; scoreText[i]; i++)
-		glutBitmapCharacter(pFont, scoreText[i]);
+	drawString(pFont, topLeft.getX(), topLeft.getY(), "Score:");
 	drawNumber(Point(topLeft.getX() + 10, topLeft.getY() - 10), score);
 }
 
 //displays lives
 void drawLives(const Point & bottomLeft, const int & lives)
 {
-	glRasterPos2f(bottomLeft.getX(), bottomLeft.getY());
-
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char livesText[] = { "Lives:" };
-	for (int i = 0; livesText[i]; i++)
-		glutBitmapCharacter(pFont, livesText[i]);
+	drawString(pFont, bottomLeft.getX(), bottomLeft.getY(), "Lives:");
 	drawNumber(Point(bottomLeft.getX() + 10, bottomLeft.getY() - 10), lives);
 }
 
@@ -936,129 +1548,75 @@ void drawLives(const Point & bottomLeft, const int & lives)
 //displays levels
 void drawLevel(const Point & bottomRight, const int & level)
 {
-	glRasterPos2f(bottomRight.getX(), bottomRight.getY());
-
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char levelText[] = { "Level:" };
-	for (int i = 0; levelText[i]; i++)
-		glutBitmapCharacter(pFont, levelText[i]);
+	drawString(pFont, bottomRight.getX(), bottomRight.getY(), "Level:");
 	drawNumber(Point(bottomRight.getX() + 10, bottomRight.getY() - 10), level);
 }
 
 //displays paused for text in center
 void drawPause(const Point & center)
 {
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
-	glRasterPos2f(center.getX(), center.getY());
-
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char pauseText[] = { "PAUSED!" };
-	for (int i = 0; pauseText[i]; i++)
-		glutBitmapCharacter(pFont, pauseText[i]);
+	drawString(pFont, center.getX(), center.getY(), "PAUSED!");
 }
 
 //displays currently typed password
 void drawPassword(const Point & center, const std::string & password)
 {
 	static int frame = 0;
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
-	glRasterPos2f(center.getX() - 35, center.getY() + 20);
-
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	for (int i = 0; i < password.size(); i++)
-		glutBitmapCharacter(pFont, password[i]);
-
 	if (frame < 7 * FRAMES_VARIABLES_MULTIPLIER)
-		glutBitmapCharacter(pFont, '_');
-	else if (frame >= 14 * FRAMES_VARIABLES_MULTIPLIER)
+		drawString(pFont, center.getX() - 35, center.getY() + 20, password + "_");
+	else
+		drawString(pFont, center.getX() - 35, center.getY() + 20, password);
+	if (frame >= 14 * FRAMES_VARIABLES_MULTIPLIER)
 		frame = 0;
 	frame++;
 
-	glRasterPos2f(center.getX() - 150, center.getY() - 60);
-	char complete[] = { "Press Space or Enter when finished" };
-	for (int i = 0; complete[i]; i++)
-	{
-		glutBitmapCharacter(pFont, complete[i]);
-	}
-	glColor3f(1.0, 1.0, 1.0);
+	drawString(pFont, center.getX() - 150, center.getY() - 60, "Press Space or Enter when finished");
+	setColor(1.0, 1.0, 1.0);
 }
 
 //displays if valid password
 void drawPasswordResult(const Point & center, const bool & legal)
 {
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
 	char anyKey[] = { "Any other key to continue" };
 	if (legal)
 	{
 		char success[][35] = { "Success!", "M = Return Main Menu   R = Retry" };
 		for (int loop = 0; loop < 2; loop++)
-		{
-			glRasterPos2f(center.getX() - 35 - (loop * 100), center.getY() + 64 - (loop * 64));
-
-			for (int i = 0; success[loop][i]; i++)
-			{
-				glutBitmapCharacter(pFont, success[loop][i]);
-			}
-		}
-		glRasterPos2f(center.getX() - 97, center.getY() - 64);
-		for (int i = 0; anyKey[i]; i++)
-		{
-			glutBitmapCharacter(pFont, anyKey[i]);
-		}
+			drawString(pFont, center.getX() - 35 - (loop * 100), center.getY() + 64 - (loop * 64), success[loop]);
+		drawString(pFont, center.getX() - 97, center.getY() - 64, anyKey);
 	}
 	else
 	{
 		char failure[][35] = { "Invalid Password!", "M = Return Main Menu   R = Retry" };
 		for (int loop = 0; loop < 2; loop++)
-		{
-			glRasterPos2f(center.getX() - 65 - (loop * 70), center.getY() + 64 - (loop * 64));
-
-			for (int i = 0; failure[loop][i]; i++)
-			{
-				glutBitmapCharacter(pFont, failure[loop][i]);
-			}
-		}
-		glRasterPos2f(center.getX() - 97, center.getY() - 64);
-		for (int i = 0; anyKey[i]; i++)
-		{
-			glutBitmapCharacter(pFont, anyKey[i]);
-		}
+			drawString(pFont, center.getX() - 65 - (loop * 70), center.getY() + 64 - (loop * 64), failure[loop]);
+		drawString(pFont, center.getX() - 97, center.getY() - 64, anyKey);
 	}
-	glColor3f(1.0, 1.0, 1.0);
+	setColor(1.0, 1.0, 1.0);
 }
 
 //displays password for current level
 void displayPassword(const Point & center, const std::string & password)
 {
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
-	glRasterPos2f(center.getX() - 170, center.getY() + 50);
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_HELVETICA_18;
-	char temp[] = { "Password to continue from current spot!" };
-	char temp2[] = { "Press C to continue" };
-	for (int i = 0; temp[i]; i++)
-	{
-		glutBitmapCharacter(pFont, temp[i]);
-	}
-	glRasterPos2f(center.getX() - 30, center.getY());
-	for (int i = 0; i < password.size(); i++)
-		glutBitmapCharacter(pFont, password[i]);
-	glRasterPos2f(center.getX() - 80, center.getY() - 50);
-	for (int i = 0; temp2[i]; i++)
-	{
-		glutBitmapCharacter(pFont, temp2[i]);
-	}
-	glColor3f(1.0, 1.0, 1.0);
+	drawString(pFont, center.getX() - 170, center.getY() + 50, "Password to continue from current spot!");
+	drawString(pFont, center.getX() - 30, center.getY(), password);
+	drawString(pFont, center.getX() - 80, center.getY() - 50, "Press C to continue");
+	setColor(1.0, 1.0, 1.0);
 }
 
 //displays if weapon is available
 void drawWeaponAvailable(const Point & bottomCenter)
 {
-	glColor3f(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
-	glRasterPos2f(bottomCenter.getX(), bottomCenter.getY());
-
+	setColor(1.0 /* red % */, 0.6 /* green % */, 0.0 /* blue % */); //Should be orange
 	void *pFont = GLUT_BITMAP_HELVETICA_12;
-	char weaponText[] = { "Special Weapon Available! Use F to fire" };
-	for (int i = 0; weaponText[i]; i++)
-		glutBitmapCharacter(pFont, weaponText[i]);
+	drawString(pFont, bottomCenter.getX(), bottomCenter.getY(), "Special Weapon Available! Use F to fire");
 }
@@ -23,10 +23,15 @@
 #define UI_DRAW_H
 
 #include <string>     // To display text on the screen
+#include <functional> // What drawParallel() calls on each thread
 #include <cmath>      // for M_PI, sin() and cos()
 #include "point.h"    // Where things are drawn
 using std::string;
 
+class DrawBuffer;
+class Raster;
+class DrawFrame;
+
 /************************************************************************
  * DRAW DIGIT
  * Draw a single digit in the old school line drawing style.  The
@@ -84,6 +89,13 @@ void drawLine(const Point & begin, const Point & end,
              float red = 1.0, float green = 1.0, float blue = 1.0);
 
 
+/************************************************************************
+ * DRAW HISTOGRAM
+ * Draw a bar for each of count values, side by side from bottomLeft,
+ * the biggest one height pixels high
+ *************************************************************************/
+void drawHistogram(const Point & bottomLeft, const int * values, int count, int height);
+
 /***********************************************************************
  * DRAW Lander
  * Draw a moon-lander spaceship on the screen at a given point
@@ -107,6 +119,61 @@ void drawDot(const Point & point);
 
 void drawRedDot(const Point & point);
 
+/************************************************************************
+ * BEGIN CAMERA / END CAMERA
+ * Everything drawn between these is moved so center ends up in the
+ * middle of the screen
+ *************************************************************************/
+void beginCamera(const Point & center);
+void endCamera();
+
+/************************************************************************
+ * BEGIN BATCH / END BATCH / DRAW BATCH
+ * Dots, lines, circles and rocks drawn between BEGIN BATCH and END BATCH
+ * are put in buffer instead of being drawn. DRAW BATCH draws everything
+ * in it with as few calls as it can and empties it.
+ *************************************************************************/
+void beginBatch(DrawBuffer & buffer);
+void endBatch();
+void drawBatch(DrawBuffer & buffer);
+
+/************************************************************************
+ * DRAW PARALLEL
+ * Between BEGIN BATCH and END BATCH, call draw(begin, end) on pieces of
+ * 0 .. count on every core at once and put what they draw in the batch.
+ * Only draws that can go in a batch can be done in draw, and it cannot
+ * change anything. With fewer than DRAW_PARALLEL_MIN for each thread it
+ * is all done on this one.
+ *************************************************************************/
+constexpr int DRAW_PARALLEL_MIN = 2048;
+void drawParallel(int count, const std::function<void(int begin, int end)> & draw);
+
+/************************************************************************
+ * BEGIN SOFTWARE / END SOFTWARE
+ * Everything drawn between these goes onto raster instead of the window,
+ * and no OpenGL is needed. Text is left out.
+ *************************************************************************/
+void beginSoftware(Raster & raster);
+void endSoftware();
+
+/************************************************************************
+ * BEGIN FRAME / END FRAME / DRAW FRAME
+ * Everything drawn between BEGIN FRAME and END FRAME is kept in frame,
+ * in order, instead of being drawn. No OpenGL is needed for that, so it
+ * can be done on any thread. DRAW FRAME draws it on the window's thread,
+ * and can draw the same frame more than once.
+ *************************************************************************/
+void beginFrame(DrawFrame & frame);
+void endFrame();
+void drawFrame(const DrawFrame & frame);
+
+/************************************************************************
+ * DRAW POINTS
+ * Draw a lot of single pixel points with one call
+ *   vertices is x, y pairs and colors is red, green, blue (0 - 255)
+ *************************************************************************/
+void drawPoints(const float * vertices, const unsigned char * colors, int count);
+
 /************************************************************************
  * DRAW Sacred Bird
  * Draw the bird on the screen
@@ -130,11 +197,23 @@ void drawToughBird(const Point & center, float radius, int hits);
 void drawShip(const Point & point, int rotation, bool thrust = false);
 
 /**********************************************************************
- * DRAW * ASTEROID
+ * DRAW ASTEROID
+ * Draw a rock from its outline: points corners, x and y for each, in
+ * steps of unit pixels, turned by rotation degrees.
+ **********************************************************************/
+void drawAsteroid(const Point & center, int rotation, const signed char * corners,
+                  int points, float unit);
+
+/**********************************************************************
+ * BEGIN OUTLINES / END OUTLINES
+ * Put count corners (x and y each), the outlines of every rock, on the
+ * graphics card if version says they changed since the last time. Until
+ * END OUTLINES, DRAW ASTEROID draws an outline from in there by where it
+ * starts. False, and nothing to end, when the drawing is recorded
+ * instead of going to the window; the rocks go in a batch then.
  **********************************************************************/
-void drawSmallAsteroid( const Point & point, int rotation);
-void drawMediumAsteroid(const Point & point, int rotation);
-void drawLargeAsteroid( const Point & point, int rotation);
+bool beginOutlines(const signed char * corners, int count, unsigned int version);
+void endOutlines();
 
 /******************************************************************
  * RANDOM
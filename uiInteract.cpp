@@ -17,6 +17,11 @@
 #include <cstdlib>    // for rand()
 #include <chrono>     // used for sleep
 #include <thread>     // "      "
+#include <mutex>      // for the keys waiting for the simulation thread
+#include <vector>     // "      "
+#include <atomic>     // for the frame rate the window's thread counted
+#include <condition_variable> // to wake the simulation thread when idle
+#include <cstdio>     // for the idle report
 
 
 #ifdef __APPLE__
@@ -48,6 +53,235 @@ constexpr float FRAMES_CLOCK_MULTIPLIER = 1.03;
 
 #include "uiInteract.h"
 #include "point.h"
+#include "uiDraw.h"
+#include "drawFrame.h"
+#include "tripleBuffer.h"
+#include "frameCapture.h"
+
+// When pipelined, the frames the simulation thread made, newest first
+static TripleBuffer<DrawFrame> frames;
+
+// When pipelined, the keys pressed on the window's thread that the
+// simulation thread has not seen yet, and what the frame rate was
+enum KeyKind { KEY_SPECIAL, KEY_DOWN, KEY_UP };
+struct KeyPress
+{
+   KeyKind kind;
+   int key;
+   bool down;
+};
+static std::mutex keysLock;
+static std::vector<KeyPress> keys;
+static std::atomic<int> framesCounted(0);
+
+// When pipelined, what the client's callback left with on the simulation
+// thread, and what the window's thread exits with once that thread has
+// stopped (-1 until then)
+static int leaving = -1;
+static std::atomic<int> exitStatus(-1);
+
+// Whether the window can be seen and has the mouse in it (GLUT cannot
+// tell if it has the keyboard, the mouse being in it is as close as it
+// gets), and a wake up for the simulation thread when either changes
+static std::atomic<bool> windowVisible(true);
+static std::atomic<bool> windowFocused(true);
+static std::condition_variable wakeUp;
+static bool woken = false;
+
+// How often the window has to be drawn
+enum Pace { PACE_FULL, PACE_SLOW, PACE_STILL };
+static std::atomic<int> pace(PACE_FULL);
+
+// On the window's thread: the slow pace's timer is waiting to go off (so
+// there is only ever one), and when pipelined, something woke the
+// simulation thread and the frame it makes for it has not been drawn yet
+static bool timerPending = false;
+static bool awaitingFrame = false;
+
+// What the idle report is worked out from: the wall and CPU time spent
+// at each pace
+static double paceWall[3] = { 0, 0, 0 };
+static double paceCpu[3] = { 0, 0, 0 };
+
+// What the frames are being recorded with, made on the first frame drawn.
+// It is finished on the way out, on the window's thread, and never deleted.
+static FrameCapture * capture = NULL;
+
+// drawCallback() is running, so the window's OpenGL context is current.
+// The game only exits from in there, but closing the window exits
+// after the window has gone.
+static bool drawing = false;
+
+/************************************************************************
+ * FIND PACE
+ * While the game is playing every frame is drawn. When it is idle
+ * (paused, on the menu or the game over screen), paused or hidden means
+ * nothing on the screen moves, so nothing is drawn until a key comes in.
+ * Otherwise it is drawn IDLE_FRAMES_PER_SECOND times a second while the
+ * mouse is out of the window.
+ *************************************************************************/
+static Pace findPace(const Interface & ui)
+{
+   if (!ui.isIdle())
+      return PACE_FULL;
+   if (ui.isPause() || !windowVisible)
+      return PACE_STILL;
+   return windowFocused ? PACE_FULL : PACE_SLOW;
+}
+
+/************************************************************************
+ * WAKE
+ * Something came in (a key, or the window changed), so draw at the full
+ * rate again until the next frame works out the pace
+ *************************************************************************/
+static void wake()
+{
+   glutIdleFunc(drawCallback);
+   awaitingFrame = true;
+   std::lock_guard<std::mutex> lock(keysLock);
+   woken = true;
+   wakeUp.notify_one();
+}
+
+static void wakeCallback(int value)
+{
+   timerPending = false;
+   glutIdleFunc(drawCallback);
+}
+
+/************************************************************************
+ * COUNT PACE
+ * Add the time since the last call to the pace it was at. The CPU time
+ * is the whole process, so the simulation thread is in it too.
+ *************************************************************************/
+static void countPace(int atPace)
+{
+   static PointInTime lastWall = std::chrono::high_resolution_clock::now();
+   static clock_t lastCpu = clock();
+   PointInTime wall = std::chrono::high_resolution_clock::now();
+   clock_t cpu = clock();
+   paceWall[atPace] += std::chrono::duration<double>(wall - lastWall).count();
+   paceCpu[atPace] += (double)(cpu - lastCpu) / CLOCKS_PER_SEC;
+   lastWall = wall;
+   lastCpu = cpu;
+}
+
+/************************************************************************
+ * REPORT IDLE
+ * On the way out, how much CPU the idle screens took against what they
+ * would have if they had been drawn every frame like the game is
+ *************************************************************************/
+static void reportIdle()
+{
+   double idleWall = paceWall[PACE_SLOW] + paceWall[PACE_STILL];
+   if (idleWall <= 0 || paceWall[PACE_FULL] <= 0)
+      return;
+   double idleCpu = paceCpu[PACE_SLOW] + paceCpu[PACE_STILL];
+   double wouldBe = idleWall * paceCpu[PACE_FULL] / paceWall[PACE_FULL];
+   printf("Idle: %.1f s drawn slowly or not at all, %.2f s of CPU instead of %.2f s (%.2f s saved)\n",
+          idleWall, idleCpu, wouldBe, wouldBe - idleCpu);
+}
+
+/************************************************************************
+ * FINISH CAPTURE
+ * On the way out, write the frames still waiting and say how it went
+ *************************************************************************/
+static void finishCapture()
+{
+   if (capture == NULL)
+      return;
+   capture->finish(drawing);
+   capture->report();
+}
+
+/************************************************************************
+ * QUEUE KEY
+ * Keep a key for the simulation thread. Returns false when not
+ * pipelined, so the key should be handled now.
+ *************************************************************************/
+static bool queueKey(KeyKind kind, int key, bool down)
+{
+   wake();
+   Interface ui;
+   if (!ui.isPipelined())
+      return false;
+   std::lock_guard<std::mutex> lock(keysLock);
+   keys.push_back({ kind, key, down });
+   wakeUp.notify_one();
+   return true;
+}
+
+/************************************************************************
+ * APPLY KEYS
+ * Hand the keys that came in since last time to the Interface, on the
+ * simulation thread
+ *************************************************************************/
+static void applyKeys(Interface & ui)
+{
+   static std::vector<KeyPress> taken;
+   {
+      std::lock_guard<std::mutex> lock(keysLock);
+      taken.swap(keys);
+   }
+   for (int i = 0; i < (int)taken.size(); i++)
+   {
+      if (taken[i].kind == KEY_SPECIAL)
+         ui.keyEvent(taken[i].key, taken[i].down);
+      else if (taken[i].kind == KEY_DOWN)
+         ui.keyEventKeyboard(taken[i].key, taken[i].down);
+      else
+         ui.KeyEventUpKeyboard(taken[i].key, taken[i].down);
+   }
+   taken.clear();
+}
+
+/************************************************************************
+ * SIMULATE
+ * When pipelined, the game is moved and drawn into a frame here, on its
+ * own thread, while the window's thread draws the frame before it. So a
+ * frame takes as long as the slower of the two instead of both added.
+ * Only this thread touches the game and the Interface's keys.
+ *************************************************************************/
+static void simulate()
+{
+   Interface ui;
+   for (;;)
+   {
+      applyKeys(ui);
+      ui.setFrameCount(framesCounted);
+
+      beginFrame(frames.back());
+      ui.callBack(&ui, ui.p);
+      endFrame();
+      frames.publish();
+      ui.keyEvent();
+
+      // the last thing this thread does, so nothing is running here when
+      // the window's thread exits
+      if (leaving >= 0)
+      {
+         exitStatus = leaving;
+         return;
+      }
+
+      // the same rate as the window. When idle, a key or the window
+      // changing ends the wait early, and the pacer starts over after.
+      Pace now = findPace(ui);
+      pace = now;
+      if (now == PACE_FULL)
+         ui.waitForFrame();
+      else
+      {
+         std::unique_lock<std::mutex> lock(keysLock);
+         auto ready = [] { return woken || !keys.empty(); };
+         if (now == PACE_STILL)
+            wakeUp.wait(lock, ready);
+         else
+            wakeUp.wait_for(lock, std::chrono::seconds(1) / IDLE_FRAMES_PER_SECOND, ready);
+         woken = false;
+      }
+   }
+}
 
 
 /************************************************************************
@@ -64,37 +298,128 @@ void drawCallback()
 {
    // even though this is a local variable, all the members are static
    Interface ui;
+   drawing = true;
+
+   // the simulation thread is done, so exit here, where the static
+   // buffers and the capture are used
+   int status = exitStatus;
+   if (status >= 0)
+      exit(status);
+   countPace(pace);
+
+   // when pipelined and idle, only draw when there is a new frame
+   bool fresh = true;
+   if (ui.isPipelined())
+   {
+      fresh = frames.update();
+      if (fresh)
+         awaitingFrame = false;
+      fresh = fresh || pace == PACE_FULL;
+   }
+
    // Prepare the background buffer for drawing
-   glClear(GL_COLOR_BUFFER_BIT); //clear the screen
-   glColor3f(1,1,1);
+   if (fresh)
+   {
+      glClear(GL_COLOR_BUFFER_BIT); //clear the screen
+      glColor3f(1,1,1);
+   }
    
-   //calls the client's display function
-   assert(ui.callBack != NULL);
-   ui.callBack(&ui, ui.p);
+   //calls the client's display function, or draws the newest frame
+   //the simulation thread made
+   if (ui.isPipelined())
+   {
+      if (fresh)
+         drawFrame(frames.front());
+   }
+   else
+   {
+      assert(ui.callBack != NULL);
+      ui.callBack(&ui, ui.p);
+   }
+
+   // read the frame back to be recorded, while it is still in the back
+   // buffer, so the graphics card copies it out during the wait below
+   if (fresh && ui.getCaptureName() != NULL)
+   {
+      if (capture == NULL)
+      {
+         capture = new FrameCapture(ui.getCaptureName(),
+                                    glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT),
+                                    ui.getCaptureScale(), (int)(ui.frameRate() + 0.5));
+         if (!capture->isOpen())
+            printf("Capture: could not record to %s\n", ui.getCaptureName());
+      }
+      capture->readWindow();
+   }
    
+   // frames in each second of the wall clock (clock() is CPU time,
+   // which is not the same, least of all with more than one thread)
    static int fps = 0;
-   static unsigned int nextSecond = clock() + CLOCKS_PER_SEC;
-   if (nextSecond <= clock())
+   static PointInTime nextSecond = std::chrono::high_resolution_clock::now() + std::chrono::seconds(1);
+   PointInTime currentTime = std::chrono::high_resolution_clock::now();
+   if (nextSecond <= currentTime)
    {
-	   ui.setFrameCount(fps);
+	   if (ui.isPipelined())
+		   framesCounted = fps;
+	   else
+		   ui.setFrameCount(fps);
 	   fps = 0;
-	   nextSecond = clock() + CLOCKS_PER_SEC;
+	   nextSecond = currentTime + std::chrono::seconds(1);
    }
-   fps++;
+   if (fresh)
+      fps++;
 
-   PointInTime currentTime = std::chrono::high_resolution_clock::now();
-   std::chrono::duration< double > timeRemaining = ui.nextDrawTime() - currentTime;
-   if (timeRemaining > std::chrono::duration< double >::zero())
-	   std::this_thread::sleep_for(timeRemaining);
-
-   // from this point, set the next draw time
-   ui.setNextDrawTime(currentTime);
+   // wait until the frame is due. When pipelined the game's pacer is the
+   // simulation thread's, so the window has one of its own.
+   if (ui.isPipelined())
+   {
+      static FramePacer windowPacer;
+      windowPacer.wait(1.0 / ui.frameRate());
+   }
+   else
+      ui.waitForFrame();
 
    // bring forth the background buffer
-   glutSwapBuffers();
+   if (fresh)
+      glutSwapBuffers();
+
+   // clear the space at the end (the simulation thread does it when pipelined)
+   if (!ui.isPipelined())
+   {
+      ui.keyEvent();
+      pace = findPace(ui);
+   }
+
+   // stop being called until a key comes in, or until the timer. When
+   // pipelined the simulation thread works out the pace, and the window
+   // keeps going until it has drawn the frame for the last wake up.
+   if (pace != PACE_FULL && !(ui.isPipelined() && awaitingFrame))
+   {
+      glutIdleFunc(NULL);
+      if (pace == PACE_SLOW && !timerPending)
+      {
+         timerPending = true;
+         glutTimerFunc(1000 / IDLE_FRAMES_PER_SECOND, wakeCallback, 0);
+      }
+   }
+   drawing = false;
+}
 
-   // clear the space at the end
-   ui.keyEvent();
+/************************************************************************
+ * ENTRY CALLBACK / VISIBILITY CALLBACK
+ * The mouse went in or out of the window, or the window was hidden or
+ * shown, which changes how often it is drawn when idle
+ *************************************************************************/
+void entryCallback(int state)
+{
+   windowFocused = (state == GLUT_ENTERED);
+   wake();
+}
+
+void visibilityCallback(int state)
+{
+   windowVisible = (state == GLUT_VISIBLE);
+   wake();
 }
 
 /************************************************************************
@@ -108,6 +433,8 @@ void keyDownCallback(int key, int x, int y)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
+   if (queueKey(KEY_SPECIAL, key, true))
+      return;
    Interface ui;
    ui.keyEvent(key, true /*fDown*/);
 }
@@ -122,6 +449,8 @@ void keyUpCallback(int key, int x, int y)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
+   if (queueKey(KEY_SPECIAL, key, false))
+      return;
    Interface ui;
    ui.keyEvent(key, false /*fDown*/);
 }
@@ -135,6 +464,8 @@ void keyboardCallback(unsigned char key, int x, int y)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
+   if (queueKey(KEY_DOWN, key, true))
+      return;
    Interface ui;
    ui.keyEventKeyboard(key, true /*fDown*/);
 }
@@ -144,6 +475,8 @@ void keyboardCallback(unsigned char key, int x, int y)
 *******/
 void keyboardUpCallback(unsigned char key, int x, int y)
 {
+	if (queueKey(KEY_UP, key, false))
+		return;
 	Interface ui;
 	ui.KeyEventUpKeyboard(key, false);
 }
@@ -180,6 +513,10 @@ void Interface::KeyEventUpKeyboard(int key, bool fDown)
 	case 'f':
 		isShockWave = fDown;
 		break;
+	case 'V':
+	case 'v':
+		isBeamPress = fDown;
+		break;
 	}
 }
 
@@ -228,10 +565,18 @@ void Interface::keyEventKeyboard(int key, bool fDown)
 			case ' ':
 				isSpacePress = fDown;
 				break;
+			case 'R':
+			case 'r':
+				isMissilePress = fDown;
+				break;
 			case 'F':
 			case 'f':
 				isShockWave = fDown;
 				break;
+			case 'V':
+			case 'v':
+				isBeamPress = fDown;
+				break;
 			case 'M':
 			case 'm':
 			case '\x1B':
@@ -244,6 +589,26 @@ void Interface::keyEventKeyboard(int key, bool fDown)
 			case 'x':
 				wantsFramesPerSecond = !wantsFramesPerSecond;
 				break;
+			case 'B':
+			case 'b':
+				wantsBounce = !wantsBounce;
+				break;
+			case 'G':
+			case 'g':
+				wantsGravity = !wantsGravity;
+				break;
+			case 'L':
+			case 'l':
+				wantsBigWorld = !wantsBigWorld;
+				break;
+			case 'U':
+			case 'u':
+				wantsSaucers = !wantsSaucers;
+				break;
+			case 'T':
+			case 't':
+				wantsThreats = !wantsThreats;
+				break;
 			case 'P':
 			case 'p':
 				isPausePress = !isPausePress;
@@ -323,6 +688,26 @@ void Interface::keyEventKeyboard(int key, bool fDown)
 		case 'x':
 			wantsFramesPerSecond = !wantsFramesPerSecond;
 			break;
+		case 'B':
+		case 'b':
+			wantsBounce = !wantsBounce;
+			break;
+		case 'G':
+		case 'g':
+			wantsGravity = !wantsGravity;
+			break;
+		case 'L':
+		case 'l':
+			wantsBigWorld = !wantsBigWorld;
+			break;
+		case 'U':
+		case 'u':
+			wantsSaucers = !wantsSaucers;
+			break;
+		case 'T':
+		case 't':
+			wantsThreats = !wantsThreats;
+			break;
 		case 'C':
 		case 'c':
 			isLevelsMode = fDown;
@@ -365,20 +750,11 @@ void Interface::keyEvent(int key, bool fDown)
 void Interface::keyEvent()
 {
    isSpacePress = false;
+   isMissilePress = false;
    clearMenuAnimation = false;
    isStartNew = false;
 }
 
-/************************************************************************
- * INTERFACE : SET NEXT DRAW TIME
- * What time should we draw the buffer again?  This is a function of
- * the current time and the frames per second.
- *************************************************************************/
-void Interface::setNextDrawTime(PointInTime currentTime)
-{
-	nextTime = currentTime + timePeriod;
-}
-
 /************************************************************************
  * INTERFACE : SET FRAMES PER SECOND
  * The frames per second dictates the speed of the game.  The more frames
@@ -398,24 +774,36 @@ void Interface::setFramesPerSecond(double value)
  **************************************************/
 int          Interface::isStrafeLPress = false;
 int          Interface::isStrafeRPress = false;
+bool         Interface::isBeamPress = false;
 int          Interface::isDownPress  = 0;
 int          Interface::isUpPress    = 0;
 int          Interface::isLeftPress  = 0;
 int          Interface::isRightPress = 0;
 bool         Interface::isSpacePress = false;
+bool         Interface::isMissilePress = false;
 bool         Interface::initialized  = false;
 TimeDuration Interface::timePeriod = std::chrono::seconds(1) / (30 * FRAMES_CLOCK_MULTIPLIER); // default to 30 frames/second
-PointInTime  Interface::nextTime = std::chrono::high_resolution_clock::now();        // redraw now please
+FramePacer   Interface::pacer;
 void *       Interface::p            = NULL;
 void (*Interface::callBack)(const Interface *, void *) = NULL;
 bool         Interface::isPracticeMode = false;
 bool         Interface::isLevelsMode = false;
+bool         Interface::isStressMode = false;
+bool         Interface::pipelined = false;
+bool         Interface::idle = false;
+const char * Interface::captureName = NULL;
+int          Interface::captureScale = 1;
 bool         Interface::isMenuPress = true;   // Game starts in menu
 bool         Interface::isQuitPress = false;
 bool         Interface::wantsControls = false;
 bool         Interface::enteringPassword = false;
 bool         Interface::clearMenuAnimation = false;
 bool         Interface::wantsFramesPerSecond = false;
+bool         Interface::wantsBounce = false;
+bool         Interface::wantsGravity = false;
+bool         Interface::wantsBigWorld = false;
+bool         Interface::wantsSaucers = false;
+bool         Interface::wantsThreats = false;
 int          Interface::framesPerSecond = 0;
 bool         Interface::isStartNew = false;
 bool         Interface::isPausePress = false;
@@ -475,6 +863,8 @@ void Interface::initialize(int argc, char ** argv, const char * title, Point top
    glutKeyboardUpFunc(keyboardUpCallback);
    glutSpecialFunc(   keyDownCallback );
    glutSpecialUpFunc( keyUpCallback   );
+   glutEntryFunc(     entryCallback   );
+   glutVisibilityFunc(visibilityCallback);
    initialized = true;
    
    // done
@@ -498,8 +888,29 @@ void Interface::run(void (*callBack)(const Interface *, void *), void *p)
    this->p = p;
    this->callBack = callBack;
 
+   // the game runs on its own thread, which is never joined
+   if (pipelined)
+      std::thread(simulate).detach();
+
+   atexit(reportIdle);
+   atexit(finishCapture);
+
    glutMainLoop();
 
    return;
 }
 
+/************************************************************************
+ * INTERFACE : LEAVE
+ *            Exit with status. When pipelined this is called on the
+ *            simulation thread, which only notes it: the thread stops
+ *            after the frame and drawCallback() exits on the window's
+ *            thread, so nothing is destroyed while it is drawing.
+ *************************************************************************/
+void Interface::leave(int status)
+{
+   if (!pipelined)
+      exit(status);
+   leaving = status;
+}
+
@@ -23,6 +23,7 @@
 #define UI_INTERFACE_H
 
 #include "point.h"
+#include "framePacer.h"
 
 #include <chrono>
 #include <string>
@@ -32,6 +33,10 @@
 //with all advance features.
 constexpr float FRAMES_VARIABLES_MULTIPLIER = 2.0;
 
+//How many frames a second the menu and game over screen are drawn at
+//while the mouse is out of the window
+constexpr int IDLE_FRAMES_PER_SECOND = 4;
+
 /*****************
 * BROTHER DUDLEY provided this code for use in project
 ****************/
@@ -63,11 +68,11 @@ public:
    // This will set the game in motion
    void run(void (*callBack)(const Interface *, void *), void *p);
 
-   // Set the next draw time based on current time and time period
-   void setNextDrawTime( PointInTime timePoint );
+   // Wait until the next tick of the game is due
+   void waitForFrame() { pacer.wait(1.0 / frameRate()); };
 
-   // Retrieve the next tick time... the time of the next draw.
-   PointInTime nextDrawTime() { return nextTime; };
+   // What waits for each tick to be due, and how late they have been
+   const FramePacer & getPacer() const { return pacer; };
 
    // How many frames per second are we configured for?
    void setFramesPerSecond(double value);
@@ -91,12 +96,21 @@ public:
    bool isHowToPlay() const { return wantsControls; };
    bool isEnterPassword() const { return enteringPassword; };
    bool isFramesPerSecond() const { return wantsFramesPerSecond; };
+   bool isBounce() const { return wantsBounce; };
+   bool isGravity() const { return wantsGravity; };
+   bool isBigWorld() const { return wantsBigWorld; };
+   bool isSaucers()  const { return wantsSaucers; };
+   bool isThreats()  const { return wantsThreats; };
+   bool isBeam()     const { return isBeamPress; };
    int isStrafeL()    const { return isStrafeLPress; };
    int isStrafeR()    const { return isStrafeRPress; };
    int getFramesPerSecond() const { return framesPerSecond; };
 
    bool isPractice()      const { return isPracticeMode; };
    bool isLevels()      const { return isLevelsMode; };
+   bool isStress()      const { return isStressMode; };
+   bool isPipelined()   const { return pipelined; };
+   bool isIdle()        const { return idle; };
    bool isMenu()      const { return isMenuPress; };
    bool isQuit()      const { return isQuitPress; };
 
@@ -105,6 +119,7 @@ public:
    int  isLeft()      const { return isLeftPress;  };
    int  isRight()     const { return isRightPress; };
    bool isSpace()     const { return isSpacePress; };
+   bool isMissile()   const { return isMissilePress; };
    bool isNewStart()   const { return isStartNew; }
    bool isPause()     const { return isPausePress; }
    bool passwordEntered() const { return passwordEnter; }
@@ -124,29 +139,77 @@ public:
    }
    void setTenthLevel(const bool & displayPass) { isTenthLevel = displayPass; }
 
+   // Used by the stress test, which plays by itself instead of from the menu
+   void setStress(const bool & stress)
+   {
+      isStressMode = stress;
+      isMenuPress = !stress;
+      isPracticeMode = false;
+      isLevelsMode = false;
+   }
+
+   // Start with the big world on (from the command line)
+   static void setBigWorld(const bool & big) { wantsBigWorld = big; }
+
+   // Call before making any other Interface to run the game without a window
+   static void setHeadless() { initialized = true; }
+   // Move and draw the game on its own thread while the window's thread
+   // draws the frame before it (from the command line, before run())
+   static void setPipelined(const bool & on) { pipelined = on; }
+   // The game has nothing going on that needs every frame drawn (paused,
+   // on the menu or game over), so the window can be drawn less often
+   static void setIdle(const bool & idle_) { idle = idle_; }
+   // Record every frame drawn in the window to a file, scale times
+   // smaller (from the command line, see frameCapture.h for the names)
+   static void setCapture(const char * fileName, int scale)
+   {
+      captureName = fileName;
+      captureScale = scale;
+   }
+
+   static const char * getCaptureName() { return captureName; }
+   static int getCaptureScale() { return captureScale; }
+
+   // Exit the program, from the client's callback. When pipelined it is
+   // the window's thread that exits, on its next frame, once the
+   // simulation thread has stopped.
+   static void leave(int status);
+
 private:
    void initialize(int argc, char ** argv, const char * title, Point topLeft, Point bottomRight);
 
    static bool         initialized;  // only run the constructor once!
    static TimeDuration timePeriod;   // interval between frame draws
-   static PointInTime nextTime;     // time of our next draw
+   static FramePacer   pacer;        // waits for each tick of the game
    static int framesPerSecond;      // used to hold fps 
    static bool wantsFramesPerSecond;  //used to display fps
+   static bool wantsBounce;          // rocks bounce off each other
+   static bool wantsGravity;         // black holes and rocks pull on things
+   static bool wantsBigWorld;        // the world is many screens across
+   static bool wantsSaucers;         // flocks of enemy saucers come in
+   static bool wantsThreats;         // point out the rocks about to hit the ship
    static bool isTenthLevel;         // used to control input when displaying password
 
    static bool isPracticeMode;       // was practice mode selected in menu
    static bool isLevelsMode;         //  "  Levels          "
+   static bool isStressMode;         // the stress test is running
+   static bool pipelined;            // the game runs on its own thread
+   static bool idle;                 // the game does not need every frame drawn
+   static const char * captureName;  // where the frames are recorded, or NULL
+   static int captureScale;          // how many times smaller they are recorded
    static bool isStartNew;           // used when new game is choosen
    static bool isPausePress;         // used when pause is pushed
 
    static int  isStrafeLPress;       // is the Q button pressed while playing
    static int  isStrafeRPress;       //    "   E           "
+   static bool isBeamPress;          //    "   V           "
 
    static int  isDownPress;          // is the down arrow currently pressed?
    static int  isUpPress;            //    "   up         "
    static int  isLeftPress;          //    "   left       "
    static int  isRightPress;         //    "   right      "
    static bool isSpacePress;         //    "   space      "
+   static bool isMissilePress;       //    "   R          "
 
    static bool isMenuPress;          // Was option to return to menu choosen
    static bool isQuitPress;          //  "            quit         "
@@ -193,6 +256,13 @@ void keyUpCallback(int key, int x, int y);
  ***************************************************************/
 void keyboardCallback(unsigned char key, int x, int y);
 
+/************************************************************************
+ * ENTRY CALLBACK / VISIBILITY CALLBACK
+ * The mouse went in or out of the window, or it was hidden or shown
+ *************************************************************************/
+void entryCallback(int state);
+void visibilityCallback(int state);
+
 /************************************************************************
  * RUN
  * Set the game in action.  We will get control back in our drawCallback
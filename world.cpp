@@ -0,0 +1,159 @@
+/*********************************************************************
+ * File: world.cpp
+ * Description: Contains the implementaiton of the world class
+ *  methods.
+ *********************************************************************/
+#include "world.h"
+
+#include <algorithm>
+#include <cmath>
+
+World::World(float chunkSize, int chunksAcross)
+	: chunkSize(chunkSize), chunksAcross(chunksAcross), sleepingRocks(0), sleepingStars(0),
+	  chunks(chunksAcross * chunksAcross)
+{
+}
+
+World::~World()
+{
+	clear();
+}
+
+Point World::getTopLeft() const
+{
+	float half = chunkSize * chunksAcross / 2.0f;
+	return Point(-half, half);
+}
+
+Point World::getBottomRight() const
+{
+	float half = chunkSize * chunksAcross / 2.0f;
+	return Point(half, -half);
+}
+
+void World::stream(std::vector<Rocks *> & rocks, std::vector<Stars *> & stars, const Point & focus)
+{
+	wokenRocks.clear();
+	sleptRocks.clear();
+	int focusChunk = chunkOf(focus);
+
+	// wake the chunks that have come near
+	std::vector<int> near;
+	int focusCol = focusChunk % chunksAcross;
+	int focusRow = focusChunk / chunksAcross;
+	for (int dRow = -WORLD_AWAKE_REACH; dRow <= WORLD_AWAKE_REACH; dRow++)
+		for (int dCol = -WORLD_AWAKE_REACH; dCol <= WORLD_AWAKE_REACH; dCol++)
+		{
+			int col = (focusCol + dCol + chunksAcross) % chunksAcross;
+			int row = (focusRow + dRow + chunksAcross) % chunksAcross;
+			int chunk = row * chunksAcross + col;
+			if (std::find(near.begin(), near.end(), chunk) != near.end())
+				continue;
+			near.push_back(chunk);
+			if (std::find(nearChunks.begin(), nearChunks.end(), chunk) == nearChunks.end())
+				wake(chunk, rocks, stars);
+		}
+	nearChunks = near;
+
+	// put whatever has drifted away to sleep
+	sleepingRocks += sleepFar(rocks, focusChunk, true);
+	sleepingStars += sleepFar(stars, focusChunk, false);
+}
+
+void World::wakeAll(std::vector<Rocks *> & rocks, std::vector<Stars *> & stars)
+{
+	wokenRocks.clear();
+	sleptRocks.clear();
+	for (int chunk = 0; chunk < (int)chunks.size(); chunk++)
+		wake(chunk, rocks, stars);
+	nearChunks.clear();
+}
+
+void World::clear()
+{
+	for (int chunk = 0; chunk < (int)chunks.size(); chunk++)
+	{
+		for (int i = 0; i < (int)chunks[chunk].size(); i++)
+			delete chunks[chunk][i].object;
+		chunks[chunk].clear();
+	}
+	sleepingRocks = 0;
+	sleepingStars = 0;
+	nearChunks.clear();
+	wokenRocks.clear();
+	sleptRocks.clear();
+}
+
+Point World::getCamera(const Point & focus, float halfWidth, float halfHeight) const
+{
+	Point topLeft = getTopLeft();
+	Point bottomRight = getBottomRight();
+	float x = std::max(topLeft.getX() + halfWidth, std::min(bottomRight.getX() - halfWidth, focus.getX()));
+	float y = std::max(bottomRight.getY() + halfHeight, std::min(topLeft.getY() - halfHeight, focus.getY()));
+	return Point(x, y);
+}
+
+Point World::fold(const Point & point, const Point & topLeft, const Point & bottomRight)
+{
+	float width = bottomRight.getX() - topLeft.getX();
+	float height = topLeft.getY() - bottomRight.getY();
+	float x = std::fmod(point.getX() - topLeft.getX(), width);
+	float y = std::fmod(point.getY() - bottomRight.getY(), height);
+	if (x < 0)
+		x += width;
+	if (y < 0)
+		y += height;
+	return Point(topLeft.getX() + x, bottomRight.getY() + y);
+}
+
+int World::chunkOf(const Point & point) const
+{
+	float half = chunkSize * chunksAcross / 2.0f;
+	int col = (int)std::floor((point.getX() + half) / chunkSize);
+	int row = (int)std::floor((point.getY() + half) / chunkSize);
+	col = std::max(0, std::min(chunksAcross - 1, col));
+	row = std::max(0, std::min(chunksAcross - 1, row));
+	return row * chunksAcross + col;
+}
+
+bool World::isNear(int chunk, int focusChunk) const
+{
+	// the world wraps, so the far edge is next to the near one
+	int colGap = std::abs(chunk % chunksAcross - focusChunk % chunksAcross);
+	int rowGap = std::abs(chunk / chunksAcross - focusChunk / chunksAcross);
+	colGap = std::min(colGap, chunksAcross - colGap);
+	rowGap = std::min(rowGap, chunksAcross - rowGap);
+	return colGap <= WORLD_AWAKE_REACH && rowGap <= WORLD_AWAKE_REACH;
+}
+
+/******************************************
+ * WAKE
+ * Catch everything asleep in the chunk up on the ticks it missed in one
+ * step and hand it back to the game.
+ ******************************************/
+void World::wake(int chunk, std::vector<Rocks *> & rocks, std::vector<Stars *> & stars)
+{
+	float half = chunkSize * chunksAcross / 2.0f;
+	float left = -half + (chunk % chunksAcross) * chunkSize;
+	float bottom = -half + (chunk / chunksAcross) * chunkSize;
+	Point topLeft(left, bottom + chunkSize);
+	Point bottomRight(left + chunkSize, bottom);
+
+	for (int i = 0; i < (int)chunks[chunk].size(); i++)
+	{
+		const Sleeper & sleeper = chunks[chunk][i];
+		sleeper.object->setPoint(fold(sleeper.object->getCurrentPoint(), topLeft, bottomRight));
+		if (sleeper.isRock)
+		{
+			rocks.push_back((Rocks *)sleeper.object);
+			wokenRocks.push_back((Rocks *)sleeper.object);
+			sleepingRocks--;
+		}
+		else
+		{
+			stars.push_back((Stars *)sleeper.object);
+			sleepingStars--;
+		}
+	}
+	chunks[chunk].clear();
+}
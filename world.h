@@ -0,0 +1,116 @@
+/***********************************************************************
+ * Header File:
+ *    World : a play area many screens across, cut into chunks
+ * Summary:
+ *    Each chunk is one screen. Only the rocks and stars in the chunks
+ *    around the ship are handed to the game to move, hit and draw. Ones
+ *    anywhere else are put to sleep in the chunk they are in, which costs
+ *    nothing per frame. When the ship comes near again the chunk wakes up
+ *    and everything in it is moved along for all the time it slept, in
+ *    one step. Sleepers stay inside their own chunk (they wrap at the
+ *    chunk's edges) so each chunk keeps what it was left with.
+ ************************************************************************/
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "point.h"
+#include "rocks.h"
+#include "stars.h"
+
+#include <vector>
+
+//How many chunks across and down the world is
+constexpr int WORLD_CHUNKS = 8;
+
+//How many chunks out from the ship's chunk are awake
+constexpr int WORLD_AWAKE_REACH = 1;
+
+class World
+{
+public:
+	World(float chunkSize, int chunksAcross = WORLD_CHUNKS);
+	~World();
+
+	//The corners of the whole world, it is centered on (0, 0)
+	Point getTopLeft() const;
+	Point getBottomRight() const;
+
+	/******************************************
+	 * STREAM
+	 * Wake the chunks around focus (putting what was in them back into
+	 * rocks and stars) and put anything in rocks and stars that is no
+	 * longer near focus to sleep. Call once a tick.
+	 ******************************************/
+	void stream(std::vector<Rocks *> & rocks, std::vector<Stars *> & stars, const Point & focus);
+
+	//Wake every chunk (used when going back to a one screen world)
+	void wakeAll(std::vector<Rocks *> & rocks, std::vector<Stars *> & stars);
+
+	//Delete everything that is asleep
+	void clear();
+
+	int getSleepingRocks() const { return sleepingRocks; }
+
+	//The rocks the last stream() woke up and put to sleep
+	const std::vector<Rocks *> & getWokenRocks() const { return wokenRocks; }
+	const std::vector<Rocks *> & getSleptRocks() const { return sleptRocks; }
+	int getSleepingStars() const { return sleepingStars; }
+
+	//Where the view should be centered to follow focus without showing past the edge
+	Point getCamera(const Point & focus, float halfWidth, float halfHeight) const;
+
+	//Wrap a point back inside the box, as if the box's edges were joined
+	static Point fold(const Point & point, const Point & topLeft, const Point & bottomRight);
+
+private:
+	//Something that is asleep. It is left behind while it sleeps, so it
+	//knows itself how many ticks it missed.
+	struct Sleeper
+	{
+		FlyingObject * object;
+		bool isRock;        // otherwise a star
+	};
+
+	int chunkOf(const Point & point) const;
+	bool isNear(int chunk, int focusChunk) const;
+	void wake(int chunk, std::vector<Rocks *> & rocks, std::vector<Stars *> & stars);
+
+	/******************************************
+	 * SLEEP FAR
+	 * Move everything in awake that is not near focusChunk into its chunk
+	 ******************************************/
+	template <class T>
+	int sleepFar(std::vector<T *> & awake, int focusChunk, bool isRock)
+	{
+		int kept = 0;
+		int slept = 0;
+		for (int i = 0; i < (int)awake.size(); i++)
+		{
+			int chunk = chunkOf(awake[i]->getCurrentPoint());
+			if (isNear(chunk, focusChunk))
+				awake[kept++] = awake[i];
+			else
+			{
+				Sleeper sleeper = { awake[i], isRock };
+				chunks[chunk].push_back(sleeper);
+				if (isRock)
+					sleptRocks.push_back((Rocks *)awake[i]);
+				slept++;
+			}
+		}
+		awake.resize(kept);
+		return slept;
+	}
+
+	float chunkSize;
+	int chunksAcross;
+	int sleepingRocks;
+	int sleepingStars;
+
+	std::vector<std::vector<Sleeper> > chunks;  // what is asleep in each chunk
+	std::vector<int> nearChunks;                 // the chunks that were awake last tick
+	std::vector<Rocks *> wokenRocks;             // what the last stream() woke up
+	std::vector<Rocks *> sleptRocks;             //  "                     put to sleep
+};
+
+#endif // WORLD_H